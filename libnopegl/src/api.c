@@ -38,6 +38,8 @@
 #endif
 
 #include "distmap.h"
+#include "dynres.h"
+#include "geometry.h"
 #include "internal.h"
 #include "log.h"
 #include "math_utils.h"
@@ -45,6 +47,8 @@
 #include "ngpu/graphics_state.h"
 #include "nopegl.h"
 #include "rnode.h"
+#include "rtt_pool.h"
+#include "trace.h"
 #include "utils/darray.h"
 #include "utils/hmap.h"
 #include "utils/memory.h"
@@ -339,6 +343,10 @@ void ngli_ctx_reset(struct ngl_ctx *s, int action)
 #if HAVE_TEXT_LIBRARIES
     FT_Done_FreeType(s->ft_library);
 #endif
+    ngli_rtt_pool_freep(&s->rtt_pool);
+    ngli_geometry_cache_freep(&s->geometry_cache);
+    ngli_trace_freep(&s->trace);
+    ngli_dynres_freep(&s->dynres);
     ngpu_ctx_freep(&s->gpu_ctx);
     ngli_config_reset(&s->config);
     backend_reset(&s->backend);
@@ -382,6 +390,42 @@ int ngli_ctx_configure(struct ngl_ctx *s, const struct ngl_config *config)
     }
     ngli_hmap_set_free_func(s->text_builtin_atlasses, ngli_free_text_builtin_atlas, NULL);
 
+    s->rtt_pool = ngli_rtt_pool_create(s);
+    if (!s->rtt_pool) {
+        ret = NGL_ERROR_MEMORY;
+        goto fail;
+    }
+
+    s->geometry_cache = ngli_geometry_cache_create(s->gpu_ctx);
+    if (!s->geometry_cache) {
+        ret = NGL_ERROR_MEMORY;
+        goto fail;
+    }
+
+    if (s->config.trace_filename) {
+        s->trace = ngli_trace_create(s);
+        if (!s->trace) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
+
+        ret = ngli_trace_init(s->trace, s->config.trace_filename);
+        if (ret < 0)
+            goto fail;
+    }
+
+    if (s->config.dynamic_resolution_budget != 0.f) {
+        s->dynres = ngli_dynres_create(s);
+        if (!s->dynres) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
+
+        ret = ngli_dynres_init(s->dynres);
+        if (ret < 0)
+            goto fail;
+    }
+
 #if HAVE_TEXT_LIBRARIES
     FT_Error ft_error = FT_Init_FreeType(&s->ft_library);
     if (ft_error) {
@@ -515,7 +559,11 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
     if (ret < 0)
         return ret;
 
-    const int64_t cpu_start_time = s->hud ? ngli_gettime_relative() : 0;
+    if (s->trace)
+        ngli_trace_begin_draw(s->trace);
+
+    const int measure_time = s->hud || s->dynres;
+    const int64_t cpu_start_time = measure_time ? ngli_gettime_relative() : 0;
 
     struct ngpu_rendertarget *rt = ngpu_ctx_get_default_rendertarget(s->gpu_ctx, NGPU_LOAD_OP_CLEAR);
     struct ngpu_rendertarget *rt_resume = ngpu_ctx_get_default_rendertarget(s->gpu_ctx, NGPU_LOAD_OP_LOAD);
@@ -523,32 +571,51 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
     s->available_rendertargets[1] = rt_resume;
     s->current_rendertarget = rt;
 
+    if (s->dynres)
+        ngli_dynres_begin(s->dynres);
+
     struct ngl_scene *scene = s->scene;
     if (scene) {
         LOG(DEBUG, "draw scene %s @ t=%f", scene->params.root->label, t);
         ngli_node_draw(scene->params.root);
     }
 
+    if (s->dynres)
+        ngli_dynres_end(s->dynres);
+
     if (!ngpu_ctx_is_render_pass_active(s->gpu_ctx)) {
         ngpu_ctx_begin_render_pass(s->gpu_ctx, s->current_rendertarget);
     }
 
-    if (s->hud) {
+    if (measure_time)
         s->cpu_draw_time = ngli_gettime_relative() - cpu_start_time;
 
-        if (ngpu_ctx_is_render_pass_active(s->gpu_ctx)) {
-            ngpu_ctx_end_render_pass(s->gpu_ctx);
-            s->current_rendertarget = s->available_rendertargets[1];
-        }
+    if ((measure_time || s->trace) && ngpu_ctx_is_render_pass_active(s->gpu_ctx)) {
+        ngpu_ctx_end_render_pass(s->gpu_ctx);
+        s->current_rendertarget = s->available_rendertargets[1];
+    }
+
+    if (s->trace) {
+        ret = ngli_trace_end_draw(s->trace);
+        if (ret < 0)
+            return ret;
+    }
+
+    if (measure_time)
         ngpu_ctx_query_draw_time(s->gpu_ctx, &s->gpu_draw_time);
 
+    if (s->hud)
         ngli_hud_draw(s->hud);
-    }
+
+    if (s->dynres)
+        ngli_dynres_update(s->dynres);
 
     if (ngpu_ctx_is_render_pass_active(s->gpu_ctx)) {
         ngpu_ctx_end_render_pass(s->gpu_ctx);
     }
 
+    ngli_rtt_pool_collect(s->rtt_pool);
+
     return ngpu_ctx_end_draw(s->gpu_ctx, t);
 }
 
@@ -567,6 +634,33 @@ int ngli_ctx_dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg)
     return ret;
 }
 
+int ngli_ctx_queue_draw(struct ngl_ctx *s, double t)
+{
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_queued_draws == NGLI_MAX_QUEUED_DRAWS)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    const size_t index = (s->queued_draws_pos + s->nb_queued_draws) % NGLI_MAX_QUEUED_DRAWS;
+    s->queued_draws[index] = t;
+    s->nb_queued_draws++;
+    pthread_cond_signal(&s->cond_wkr);
+    pthread_mutex_unlock(&s->lock);
+
+    return 0;
+}
+
+/*
+ * Wait for all the draws queued with ngl_draw_async() to be executed. Any
+ * other operation on the context must be preceded by this call since the
+ * worker thread may still be accessing the scene and the graphics context.
+ */
+static void wait_queued_draws(struct ngl_ctx *s)
+{
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_queued_draws)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+}
+
 static void *worker_thread(void *arg)
 {
     struct ngl_ctx *s = arg;
@@ -575,8 +669,26 @@ static void *worker_thread(void *arg)
 
     pthread_mutex_lock(&s->lock);
     for (;;) {
-        while (!s->cmd_func)
+        while (!s->cmd_func && !s->nb_queued_draws)
             pthread_cond_wait(&s->cond_wkr, &s->lock);
+
+        if (s->nb_queued_draws) {
+            /*
+             * The lock is released while drawing so the controller can queue
+             * the next draw in the meantime.
+             */
+            const double t = s->queued_draws[s->queued_draws_pos];
+            pthread_mutex_unlock(&s->lock);
+            const int ret = ngli_ctx_draw(s, t);
+            pthread_mutex_lock(&s->lock);
+            if (ret < 0 && !s->queued_draws_ret)
+                s->queued_draws_ret = ret;
+            s->queued_draws_pos = (s->queued_draws_pos + 1) % NGLI_MAX_QUEUED_DRAWS;
+            s->nb_queued_draws--;
+            pthread_cond_signal(&s->cond_ctl);
+            continue;
+        }
+
         s->cmd_ret = s->cmd_func(s, s->cmd_arg);
         int need_stop = s->cmd_func == cmd_stop;
         s->cmd_func = s->cmd_arg = NULL;
@@ -722,6 +834,8 @@ fail:
 
 int ngl_configure(struct ngl_ctx *s, const struct ngl_config *user_config)
 {
+    wait_queued_draws(s);
+
     if (s->configured) {
         s->api_impl->reset(s, NGLI_ACTION_KEEP_SCENE);
         s->configured = 0;
@@ -790,6 +904,8 @@ void ngl_reset_backend(struct ngl_backend *backend)
 
 int ngl_resize(struct ngl_ctx *s, uint32_t width, uint32_t height)
 {
+    wait_queued_draws(s);
+
     if (!s->configured) {
         LOG(ERROR, "context must be configured before resizing rendering buffers");
         return NGL_ERROR_INVALID_USAGE;
@@ -800,6 +916,8 @@ int ngl_resize(struct ngl_ctx *s, uint32_t width, uint32_t height)
 
 int ngl_get_viewport(struct ngl_ctx *s, int32_t *viewport)
 {
+    wait_queued_draws(s);
+
     if (!s->configured) {
         LOG(ERROR, "context must be configured to get the viewport");
         return NGL_ERROR_INVALID_USAGE;
@@ -810,6 +928,8 @@ int ngl_get_viewport(struct ngl_ctx *s, int32_t *viewport)
 
 int ngl_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
 {
+    wait_queued_draws(s);
+
     if (!s->configured) {
         LOG(ERROR, "context must be configured before setting a capture buffer");
         return NGL_ERROR_INVALID_USAGE;
@@ -825,6 +945,8 @@ int ngl_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
 
 int ngl_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
 {
+    wait_queued_draws(s);
+
     if (!s->configured) {
         LOG(ERROR, "context must be configured before setting a scene");
         return NGL_ERROR_INVALID_USAGE;
@@ -835,6 +957,8 @@ int ngl_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
 
 int ngli_prepare_draw(struct ngl_ctx *s, double t)
 {
+    wait_queued_draws(s);
+
     if (!s->configured) {
         LOG(ERROR, "context must be configured before updating");
         return NGL_ERROR_INVALID_USAGE;
@@ -845,6 +969,8 @@ int ngli_prepare_draw(struct ngl_ctx *s, double t)
 
 int ngl_draw(struct ngl_ctx *s, double t)
 {
+    wait_queued_draws(s);
+
     if (!s->configured) {
         LOG(ERROR, "context must be configured before drawing");
         return NGL_ERROR_INVALID_USAGE;
@@ -853,8 +979,37 @@ int ngl_draw(struct ngl_ctx *s, double t)
     return s->api_impl->draw(s, t);
 }
 
+int ngl_draw_async(struct ngl_ctx *s, double t)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (!s->api_impl->draw_async) {
+        LOG(ERROR, "asynchronous drawing is not supported by context");
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    return s->api_impl->draw_async(s, t);
+}
+
+int ngl_draw_wait(struct ngl_ctx *s)
+{
+    wait_queued_draws(s);
+
+    pthread_mutex_lock(&s->lock);
+    const int ret = s->queued_draws_ret;
+    s->queued_draws_ret = 0;
+    pthread_mutex_unlock(&s->lock);
+
+    return ret;
+}
+
 int ngl_gl_wrap_framebuffer(struct ngl_ctx *s, uint32_t framebuffer)
 {
+    wait_queued_draws(s);
+
     if (!s->configured) {
         LOG(ERROR, "context must be configured before wrapping a new external OpenGL framebuffer");
         return NGL_ERROR_INVALID_USAGE;
@@ -880,6 +1035,8 @@ void ngl_freep(struct ngl_ctx **ss)
     if (!s)
         return;
 
+    wait_queued_draws(s);
+
     if (s->configured) {
         s->api_impl->reset(s, NGLI_ACTION_UNREF_SCENE);
         s->configured = 0;
@@ -29,5 +29,6 @@ const struct api_impl api_vk = {
     .set_scene          = ngli_ctx_set_scene,
     .prepare_draw       = ngli_ctx_prepare_draw,
     .draw               = ngli_ctx_draw,
+    .draw_async         = ngli_ctx_queue_draw,
     .reset              = ngli_ctx_reset,
 };
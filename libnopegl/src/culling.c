@@ -0,0 +1,127 @@
+/*
+ * Copyright 2026 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <float.h>
+#include <math.h>
+
+#include "culling.h"
+#include "internal.h"
+#include "math_utils.h"
+#include "ngpu/ctx.h"
+#include "utils/darray.h"
+#include "utils/utils.h"
+
+int ngli_culling_clip_box(const struct ngl_ctx *ctx, const float *bmin, const float *bmax,
+                          struct ngpu_scissor *dst)
+{
+    const struct ngpu_viewport *viewport = &ctx->viewport;
+    const struct ngpu_scissor *scissor = &ctx->scissor;
+    *dst = *scissor;
+    if (viewport->width <= 0.f || viewport->height <= 0.f)
+        return 0;
+
+    /*
+     * Visible area in normalized device coordinates: the scissor is
+     * expressed in the same space as the viewport, so we only need to
+     * re-normalize it relatively to the latter.
+     */
+    const float x0 = NGLI_CLAMP(((float)scissor->x - viewport->x) / viewport->width * 2.f - 1.f, -1.f, 1.f);
+    const float y0 = NGLI_CLAMP(((float)scissor->y - viewport->y) / viewport->height * 2.f - 1.f, -1.f, 1.f);
+    const float x1 = NGLI_CLAMP(((float)(scissor->x + scissor->width) - viewport->x) / viewport->width * 2.f - 1.f, -1.f, 1.f);
+    const float y1 = NGLI_CLAMP(((float)(scissor->y + scissor->height) - viewport->y) / viewport->height * 2.f - 1.f, -1.f, 1.f);
+    if (x0 >= x1 || y0 >= y1)
+        return 1;
+
+    const float *modelview_matrix  = ngli_darray_tail(&ctx->modelview_matrix_stack);
+    const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
+
+    NGLI_ALIGNED_MAT(mvp);
+    ngli_mat4_mul(mvp, projection_matrix, modelview_matrix);
+
+    /*
+     * The projection matrix may include a backend specific transform
+     * flipping the Y axis (Vulkan), while the viewport and scissor are
+     * always expressed with a bottom-up origin.
+     */
+    NGLI_ALIGNED_MAT(backend_matrix) = NGLI_MAT4_IDENTITY;
+    ngpu_ctx_transform_projection_matrix(ctx->gpu_ctx, backend_matrix);
+    const float y_sign = backend_matrix[5] < 0.f ? -1.f : 1.f;
+
+    float NGLI_ATTR_ALIGNED corners[8][4];
+    for (size_t i = 0; i < 8; i++) {
+        corners[i][0] = i & 1 ? bmax[0] : bmin[0];
+        corners[i][1] = i & 2 ? bmax[1] : bmin[1];
+        corners[i][2] = i & 4 ? bmax[2] : bmin[2];
+        corners[i][3] = 1.f;
+    }
+    ngli_mat4_mul_vec4_array(&corners[0][0], mvp, &corners[0][0], 8);
+
+    uint32_t outside = 0x1f;
+    int in_front = 1;
+    float min_x = FLT_MAX, max_x = -FLT_MAX;
+    float min_y = FLT_MAX, max_y = -FLT_MAX;
+    for (size_t i = 0; i < 8; i++) {
+        const float x = corners[i][0];
+        const float y = corners[i][1] * y_sign;
+        const float w = corners[i][3];
+        uint32_t flags = 0;
+        if (x < x0 * w) flags |= 1 << 0;
+        if (x > x1 * w) flags |= 1 << 1;
+        if (y < y0 * w) flags |= 1 << 2;
+        if (y > y1 * w) flags |= 1 << 3;
+        if (w <= 0.f)   flags |= 1 << 4;
+        outside &= flags;
+
+        if (w <= 0.f) {
+            in_front = 0;
+            continue;
+        }
+        min_x = NGLI_MIN(min_x, x / w);
+        max_x = NGLI_MAX(max_x, x / w);
+        min_y = NGLI_MIN(min_y, y / w);
+        max_y = NGLI_MAX(max_y, y / w);
+    }
+
+    if (outside)
+        return 1;
+
+    if (!in_front)
+        return 0;
+
+    /*
+     * Screen-space bounds of the box in pixels, rounded outward so that every
+     * pixel touched by the rasterization is kept
+     */
+    min_x = floorf(viewport->x + (NGLI_MAX(min_x, x0) + 1.f) * .5f * viewport->width);
+    max_x = ceilf(viewport->x + (NGLI_MIN(max_x, x1) + 1.f) * .5f * viewport->width);
+    min_y = floorf(viewport->y + (NGLI_MAX(min_y, y0) + 1.f) * .5f * viewport->height);
+    max_y = ceilf(viewport->y + (NGLI_MIN(max_y, y1) + 1.f) * .5f * viewport->height);
+
+    const uint32_t sx0 = (uint32_t)NGLI_CLAMP(min_x, (float)scissor->x, (float)(scissor->x + scissor->width));
+    const uint32_t sx1 = (uint32_t)NGLI_CLAMP(max_x, (float)scissor->x, (float)(scissor->x + scissor->width));
+    const uint32_t sy0 = (uint32_t)NGLI_CLAMP(min_y, (float)scissor->y, (float)(scissor->y + scissor->height));
+    const uint32_t sy1 = (uint32_t)NGLI_CLAMP(max_y, (float)scissor->y, (float)(scissor->y + scissor->height));
+    if (sx0 >= sx1 || sy0 >= sy1)
+        return 1;
+
+    *dst = (struct ngpu_scissor){sx0, sy0, sx1 - sx0, sy1 - sy0};
+    return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2026 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CULLING_H
+#define CULLING_H
+
+struct ngl_ctx;
+struct ngpu_scissor;
+
+/*
+ * Check whether an axis-aligned box, expressed in model space, is entirely
+ * outside of the area covered by the current viewport and scissor, using
+ * the modelview and projection matrices currently on top of the context
+ * stacks.
+ *
+ * The test is conservative: it only returns 1 if all the box corners lie on
+ * the outer side of the same clipping plane, and never considers the depth
+ * range.
+ *
+ * If the box is visible, the scissor is set to the current one restricted to
+ * the screen-space bounds of the box (when they can be derived, which is not
+ * the case if the box crosses the eye plane).
+ */
+int ngli_culling_clip_box(const struct ngl_ctx *ctx, const float *bmin, const float *bmax,
+                          struct ngpu_scissor *scissor);
+
+#endif /* CULLING_H */
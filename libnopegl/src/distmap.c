@@ -344,6 +344,7 @@ static int map_and_load_buffers_data(struct distmap *s)
         goto end;
 
     load_buffers_data(s, vert_data, frag_data);
+    s->ctx->gpu_ctx->nb_uploaded_bytes += s->vert_buffer->size + s->frag_buffer->size;
 
 end:
     if (vert_data)
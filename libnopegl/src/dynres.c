@@ -0,0 +1,388 @@
+/*
+ * Copyright 2026 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+#include "dynres.h"
+#include "image.h"
+#include "internal.h"
+#include "log.h"
+#include "math_utils.h"
+#include "ngpu/ctx.h"
+#include "ngpu/format.h"
+#include "ngpu/graphics_state.h"
+#include "ngpu/pgcraft.h"
+#include "ngpu/rendertarget.h"
+#include "ngpu/texture.h"
+#include "nopegl.h"
+#include "pipeline_compat.h"
+#include "rtt.h"
+#include "utils/memory.h"
+#include "utils/utils.h"
+
+/* GLSL shaders */
+#include "blur_common_vert.h"
+#include "dynres_upscale_frag.h"
+
+#define DEFAULT_MIN_SCALE 0.5f
+
+/* Granularity of the scale, to avoid reallocating the target for tiny changes */
+#define SCALE_STEP (1.f / 32.f)
+
+/* The scale is only raised if the frame time is below this fraction of the budget */
+#define HEADROOM 0.8f
+
+/* Maximum scale increase per adjustment, raising the scale is a guess */
+#define MAX_SCALE_UP 1.1f
+
+/* Weight of the last frame in the smoothed frame time */
+#define SMOOTHING 0.2f
+
+/*
+ * Number of frames ignored after a scale change: the first ones account for
+ * the reallocation of the target and the time measures lag behind
+ */
+#define SETTLE_FRAMES 8
+
+#define RENDER_TEXTURE_FEATURES (NGPU_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |               \
+                                 NGPU_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT | \
+                                 NGPU_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT)
+
+struct dynres {
+    struct ngl_ctx *ctx;
+
+    float budget;
+    float min_scale;
+    float scale;
+    float frame_time;
+    int has_frame_time;
+    int settle_frames;
+
+    uint32_t width;
+    uint32_t height;
+    struct ngpu_texture *texture;
+    struct image image;
+    struct rtt_ctx *rtt_ctx;
+    int started;
+
+    struct ngpu_pgcraft *crafter;
+    struct pipeline_compat *pipeline_compat;
+};
+
+struct dynres *ngli_dynres_create(struct ngl_ctx *ctx)
+{
+    struct dynres *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->ctx = ctx;
+    return s;
+}
+
+static int setup_pipeline(struct dynres *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+
+    const struct ngpu_pgcraft_iovar vert_out_vars[] = {
+        {.name = "tex_coord", .type = NGPU_TYPE_VEC2},
+    };
+
+    const struct ngpu_pgcraft_texture textures[] = {
+        {
+            .name      = "tex",
+            .type      = NGPU_PGCRAFT_TEXTURE_TYPE_2D,
+            .precision = NGPU_PRECISION_HIGH,
+            .stage     = NGPU_PROGRAM_STAGE_FRAG,
+        },
+    };
+
+    const struct ngpu_pgcraft_params crafter_params = {
+        .program_label    = "nopegl/dynamic-resolution-upscale",
+        .vert_base        = blur_common_vert,
+        .frag_base        = dynres_upscale_frag,
+        .textures         = textures,
+        .nb_textures      = NGLI_ARRAY_NB(textures),
+        .vert_out_vars    = vert_out_vars,
+        .nb_vert_out_vars = NGLI_ARRAY_NB(vert_out_vars),
+    };
+
+    s->crafter = ngpu_pgcraft_create(gpu_ctx);
+    if (!s->crafter)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngpu_pgcraft_craft(s->crafter, &crafter_params);
+    if (ret < 0)
+        return ret;
+
+    s->pipeline_compat = ngli_pipeline_compat_create(gpu_ctx);
+    if (!s->pipeline_compat)
+        return NGL_ERROR_MEMORY;
+
+    const struct pipeline_compat_params params = {
+        .type         = NGPU_PIPELINE_TYPE_GRAPHICS,
+        .graphics     = {
+            .topology     = NGPU_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+            .state        = NGPU_GRAPHICS_STATE_DEFAULTS,
+            .rt_layout    = *ngpu_ctx_get_default_rendertarget_layout(gpu_ctx),
+            .vertex_state = ngpu_pgcraft_get_vertex_state(s->crafter),
+        },
+        .program          = ngpu_pgcraft_get_program(s->crafter),
+        .layout_desc      = ngpu_pgcraft_get_bindgroup_layout_desc(s->crafter),
+        .resources        = ngpu_pgcraft_get_bindgroup_resources(s->crafter),
+        .vertex_resources = ngpu_pgcraft_get_vertex_resources(s->crafter),
+        .compat_info      = ngpu_pgcraft_get_compat_info(s->crafter),
+    };
+
+    return ngli_pipeline_compat_init(s->pipeline_compat, &params);
+}
+
+int ngli_dynres_init(struct dynres *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    const struct ngl_config *config = &ctx->config;
+
+    if (config->dynamic_resolution_budget < 0.f) {
+        LOG(ERROR, "dynamic resolution budget must be positive");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    const float min_scale = config->dynamic_resolution_min_scale;
+    if (min_scale < 0.f || min_scale > 1.f) {
+        LOG(ERROR, "dynamic resolution minimum scale must be in the (0,1] range");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    s->budget = config->dynamic_resolution_budget;
+    s->min_scale = min_scale > 0.f ? min_scale : DEFAULT_MIN_SCALE;
+    s->scale = 1.f;
+
+    /* Ignore the first frames which include the initialization of the scene */
+    s->settle_frames = SETTLE_FRAMES;
+
+    /*
+     * The scene pipelines are built for the default render target layout, so
+     * the internal target must share it
+     */
+    const struct ngpu_rendertarget_layout *layout = ngpu_ctx_get_default_rendertarget_layout(gpu_ctx);
+    const uint32_t features = ngpu_ctx_get_format_features(gpu_ctx, layout->colors[0].format);
+    if (!NGLI_HAS_ALL_FLAGS(features, RENDER_TEXTURE_FEATURES)) {
+        LOG(ERROR, "the default render target format does not support dynamic resolution");
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    return setup_pipeline(s);
+}
+
+static void release_target(struct dynres *s)
+{
+    ngli_rtt_freep(&s->rtt_ctx);
+    ngpu_texture_freep(&s->texture);
+    ngli_image_reset(&s->image);
+    s->width = s->height = 0;
+}
+
+static int resize_target(struct dynres *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    const struct ngl_config *config = &ctx->config;
+
+    uint32_t rt_width, rt_height;
+    ngpu_ctx_get_default_rendertarget_size(gpu_ctx, &rt_width, &rt_height);
+    const uint32_t width  = NGLI_MAX((uint32_t)lrintf((float)rt_width  * s->scale), 1);
+    const uint32_t height = NGLI_MAX((uint32_t)lrintf((float)rt_height * s->scale), 1);
+    if (s->rtt_ctx && s->width == width && s->height == height)
+        return 0;
+
+    release_target(s);
+
+    const struct ngpu_rendertarget_layout *layout = ngpu_ctx_get_default_rendertarget_layout(gpu_ctx);
+
+    s->texture = ngpu_texture_create(gpu_ctx);
+    if (!s->texture)
+        return NGL_ERROR_MEMORY;
+
+    const struct ngpu_texture_params texture_params = {
+        .type       = NGPU_TEXTURE_TYPE_2D,
+        .format     = layout->colors[0].format,
+        .width      = width,
+        .height     = height,
+        .min_filter = NGPU_FILTER_LINEAR,
+        .mag_filter = NGPU_FILTER_LINEAR,
+        .usage      = NGPU_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT |
+                      NGPU_TEXTURE_USAGE_SAMPLED_BIT,
+    };
+
+    int ret = ngpu_texture_init(s->texture, &texture_params);
+    if (ret < 0)
+        return ret;
+
+    struct rtt_params params = {
+        .width                = width,
+        .height               = height,
+        .samples              = layout->samples,
+        /*
+         * The scene may interrupt the render pass any number of times, and
+         * this number may change from one frame to another
+         */
+        .nb_interruptions     = INT_MAX,
+        .nb_colors            = 1,
+        .colors[0]            = {
+            .attachment       = s->texture,
+            .load_op          = NGPU_LOAD_OP_CLEAR,
+            .store_op         = NGPU_STORE_OP_STORE,
+        },
+        .depth_stencil_format = layout->depth_stencil.format,
+    };
+    memcpy(params.colors[0].clear_value, config->clear_color, sizeof(config->clear_color));
+
+    s->rtt_ctx = ngli_rtt_create(ctx);
+    if (!s->rtt_ctx)
+        return NGL_ERROR_MEMORY;
+
+    ret = ngli_rtt_init(s->rtt_ctx, &params);
+    if (ret < 0)
+        return ret;
+
+    const struct image_params image_params = {
+        .width      = width,
+        .height     = height,
+        .layout     = NGLI_IMAGE_LAYOUT_DEFAULT,
+        .color_info = NGLI_COLOR_INFO_DEFAULTS,
+    };
+    ngli_image_init(&s->image, &image_params, &s->texture);
+
+    s->width = width;
+    s->height = height;
+
+    return 0;
+}
+
+void ngli_dynres_begin(struct dynres *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    if (s->scale >= 1.f) {
+        release_target(s);
+        return;
+    }
+
+    int ret = resize_target(s);
+    if (ret < 0) {
+        LOG(ERROR, "could not allocate the dynamic resolution target: %s", NGLI_RET_STR(ret));
+        release_target(s);
+        s->scale = 1.f;
+        return;
+    }
+
+    uint32_t rt_width, rt_height;
+    ngpu_ctx_get_default_rendertarget_size(ctx->gpu_ctx, &rt_width, &rt_height);
+    const float scale_x = (float)s->width / (float)rt_width;
+    const float scale_y = (float)s->height / (float)rt_height;
+
+    /* The internal target covers the whole default render target */
+    const struct ngpu_viewport viewport = ctx->viewport;
+    ngli_rtt_begin(s->rtt_ctx);
+    ctx->viewport = (struct ngpu_viewport){
+        .x      = viewport.x * scale_x,
+        .y      = viewport.y * scale_y,
+        .width  = viewport.width * scale_x,
+        .height = viewport.height * scale_y,
+    };
+    s->started = 1;
+}
+
+void ngli_dynres_end(struct dynres *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+
+    if (!s->started)
+        return;
+    s->started = 0;
+
+    ngli_rtt_end(s->rtt_ctx);
+
+    ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
+
+    uint32_t rt_width, rt_height;
+    ngpu_ctx_get_default_rendertarget_size(gpu_ctx, &rt_width, &rt_height);
+    const struct ngpu_viewport viewport = {0.f, 0.f, (float)rt_width, (float)rt_height};
+    ngpu_ctx_set_viewport(gpu_ctx, &viewport);
+    ngpu_ctx_set_scissor(gpu_ctx, &ctx->scissor);
+
+    ngli_pipeline_compat_update_image(s->pipeline_compat, 0, &s->image);
+    ngli_pipeline_compat_draw(s->pipeline_compat, 3, 1, 0);
+}
+
+void ngli_dynres_update(struct dynres *s)
+{
+    const struct ngl_ctx *ctx = s->ctx;
+
+    if (s->settle_frames > 0) {
+        s->settle_frames--;
+        return;
+    }
+
+    /* The CPU and GPU work in parallel: the slowest one sets the frame time */
+    const float cpu_time = (float)ctx->cpu_draw_time / 1000.f;
+    const float gpu_time = (float)ctx->gpu_draw_time / 1000000.f;
+    const float frame_time = NGLI_MAX(cpu_time, gpu_time);
+    s->frame_time = s->has_frame_time ? NGLI_MIX_F32(s->frame_time, frame_time, SMOOTHING) : frame_time;
+    s->has_frame_time = 1;
+
+    /* The draw cost is assumed to be proportional to the number of pixels */
+    float scale = s->scale;
+    if (s->frame_time > s->budget) {
+        scale *= sqrtf(s->budget / s->frame_time);
+    } else if (s->frame_time < s->budget * HEADROOM && scale < 1.f) {
+        scale *= NGLI_MIN(sqrtf(s->budget * HEADROOM / s->frame_time), MAX_SCALE_UP);
+    } else {
+        return;
+    }
+    scale = floorf(scale / SCALE_STEP) * SCALE_STEP;
+    scale = NGLI_CLAMP(scale, s->min_scale, 1.f);
+    if (scale == s->scale)
+        return;
+
+    LOG(DEBUG, "frame time %.2fms (budget %.2fms): change resolution scale from %g to %g",
+        s->frame_time, s->budget, s->scale, scale);
+
+    s->scale = scale;
+    s->has_frame_time = 0;
+    s->settle_frames = SETTLE_FRAMES;
+}
+
+void ngli_dynres_freep(struct dynres **sp)
+{
+    struct dynres *s = *sp;
+    if (!s)
+        return;
+
+    release_target(s);
+    ngli_pipeline_compat_freep(&s->pipeline_compat);
+    ngpu_pgcraft_freep(&s->crafter);
+
+    ngli_freep(sp);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2026 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef DYNRES_H
+#define DYNRES_H
+
+struct ngl_ctx;
+struct dynres;
+
+/*
+ * Dynamic resolution controller.
+ *
+ * When the resolution scale is lower than 1, the scene is rendered into an
+ * internal target of the scaled size which is then upscaled to the default
+ * render target. The scale is adjusted after every frame according to the
+ * CPU and GPU draw times, so that they stay under the configured budget.
+ */
+struct dynres *ngli_dynres_create(struct ngl_ctx *ctx);
+int ngli_dynres_init(struct dynres *s);
+void ngli_dynres_begin(struct dynres *s);
+void ngli_dynres_end(struct dynres *s);
+void ngli_dynres_update(struct dynres *s);
+void ngli_dynres_freep(struct dynres **sp);
+
+#endif
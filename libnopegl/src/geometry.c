@@ -19,12 +19,16 @@
  * under the License.
  */
 
+#include <string.h>
+
 #include "geometry.h"
 #include "log.h"
 #include "ngpu/buffer.h"
 #include "ngpu/format.h"
 #include "ngpu/type.h"
 #include "nopegl.h"
+#include "utils/crc32.h"
+#include "utils/hmap.h"
 #include "utils/memory.h"
 #include "utils/utils.h"
 
@@ -33,95 +37,217 @@
 #define OWN_NORMALS  (1 << 2)
 #define OWN_INDICES  (1 << 3)
 
-struct geometry *ngli_geometry_create(struct ngpu_ctx *gpu_ctx)
+#define CACHED_ATTRIBUTES (1 << 0)
+#define CACHED_INDICES    (1 << 1)
+
+struct cache_entry {
+    void *data;
+    size_t size;
+    uint32_t usage;
+    struct ngpu_buffer *buffer;
+    size_t nb_users;
+};
+
+struct geometry_cache {
+    struct ngpu_ctx *gpu_ctx;
+    struct hmap *entries; // struct cache_entry
+};
+
+static void free_cache_entry(void *user_arg, void *data)
+{
+    struct cache_entry *entry = data;
+    ngpu_buffer_freep(&entry->buffer);
+    ngli_freep(&entry->data);
+    ngli_freep(&entry);
+}
+
+struct geometry_cache *ngli_geometry_cache_create(struct ngpu_ctx *gpu_ctx)
+{
+    struct geometry_cache *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gpu_ctx = gpu_ctx;
+    s->entries = ngli_hmap_create(NGLI_HMAP_TYPE_U64);
+    if (!s->entries) {
+        ngli_freep(&s);
+        return NULL;
+    }
+    ngli_hmap_set_free_func(s->entries, free_cache_entry, NULL);
+    return s;
+}
+
+void ngli_geometry_cache_freep(struct geometry_cache **sp)
+{
+    struct geometry_cache *s = *sp;
+    if (!s)
+        return;
+    ngli_assert(!ngli_hmap_count(s->entries));
+    ngli_hmap_freep(&s->entries);
+    ngli_freep(sp);
+}
+
+static uint64_t get_cache_key(const void *data, size_t size)
+{
+    return (uint64_t)ngli_crc32_mem(data, size) << 32 | (uint32_t)size;
+}
+
+struct geometry *ngli_geometry_create(struct ngpu_ctx *gpu_ctx, struct geometry_cache *cache)
 {
     struct geometry *s = ngli_calloc(1, sizeof(*s));
     if (!s)
         return NULL;
     s->gpu_ctx = gpu_ctx;
+    s->cache = cache;
     return s;
 }
 
-static int gen_buffer(struct geometry *s,
-                      struct ngpu_buffer **bufferp, const struct buffer_layout *layout,
-                      const void *data, uint32_t usage)
+static int gen_buffer(struct geometry *s, struct ngpu_buffer **bufferp,
+                      const void *data, size_t size, uint32_t usage)
 {
     struct ngpu_buffer *buffer = ngpu_buffer_create(s->gpu_ctx);
     if (!buffer)
         return NGL_ERROR_MEMORY;
 
-    const size_t size = layout->count * layout->stride;
-
     int ret = ngpu_buffer_init(buffer, size, NGPU_BUFFER_USAGE_TRANSFER_DST_BIT | usage);
     if (ret < 0)
-        return ret;
+        goto fail;
 
-    ret = ngpu_buffer_upload(buffer, data, layout->offset, size);
+    ret = ngpu_buffer_upload(buffer, data, 0, size);
     if (ret < 0)
-        return ret;
+        goto fail;
 
     *bufferp = buffer;
     return 0;
+
+fail:
+    ngpu_buffer_freep(&buffer);
+    return ret;
+}
+
+/*
+ * Get a GPU buffer filled with the specified data, shared with any other
+ * geometry of the context having the exact same content. Entries whose key
+ * collides with a different content are not shared.
+ */
+static int get_buffer(struct geometry *s, struct ngpu_buffer **bufferp, uint64_t *keyp, uint32_t cached_flag,
+                      const void *data, size_t size, uint32_t usage)
+{
+    struct geometry_cache *cache = s->cache;
+    if (!cache)
+        return gen_buffer(s, bufferp, data, size, usage);
+
+    const uint64_t key = get_cache_key(data, size);
+    struct cache_entry *entry = ngli_hmap_get_u64(cache->entries, key);
+    if (entry) {
+        if (entry->size != size || entry->usage != usage || memcmp(entry->data, data, size))
+            return gen_buffer(s, bufferp, data, size, usage);
+        entry->nb_users++;
+        *bufferp = NGLI_RC_REF(entry->buffer);
+        *keyp = key;
+        s->cached_buffers |= cached_flag;
+        return 0;
+    }
+
+    entry = ngli_calloc(1, sizeof(*entry));
+    if (!entry)
+        return NGL_ERROR_MEMORY;
+
+    entry->data = ngli_memdup(data, size);
+    if (!entry->data) {
+        ngli_freep(&entry);
+        return NGL_ERROR_MEMORY;
+    }
+    entry->size = size;
+    entry->usage = usage;
+
+    int ret = gen_buffer(s, &entry->buffer, data, size, usage);
+    if (ret < 0) {
+        free_cache_entry(NULL, entry);
+        return ret;
+    }
+
+    ret = ngli_hmap_set_u64(cache->entries, key, entry);
+    if (ret < 0) {
+        free_cache_entry(NULL, entry);
+        return ret;
+    }
+
+    entry->nb_users = 1;
+    *bufferp = NGLI_RC_REF(entry->buffer);
+    *keyp = key;
+    s->cached_buffers |= cached_flag;
+    return 0;
+}
+
+static void release_buffer(struct geometry *s, struct ngpu_buffer **bufferp, uint64_t key, uint32_t cached_flag)
+{
+    if (s->cached_buffers & cached_flag) {
+        struct cache_entry *entry = ngli_hmap_get_u64(s->cache->entries, key);
+        ngli_assert(entry && entry->nb_users);
+        if (!--entry->nb_users)
+            ngli_hmap_set_u64(s->cache->entries, key, NULL);
+        s->cached_buffers &= ~cached_flag;
+    }
+    ngpu_buffer_freep(bufferp);
 }
 
-static int gen_vec3(struct geometry *s,
-                    struct ngpu_buffer **bufferp, struct buffer_layout *layout,
-                    size_t count, const float *data)
+static int stage_attribute(struct geometry *s, float **datap, struct buffer_layout *layout,
+                           enum ngpu_type type, enum ngpu_format format, size_t count, const float *data)
 {
-    const enum ngpu_format format = NGPU_FORMAT_R32G32B32_SFLOAT;
+    const size_t stride = ngpu_format_get_bytes_per_pixel(format);
+    *datap = ngli_memdup(data, count * stride);
+    if (!*datap)
+        return NGL_ERROR_MEMORY;
     *layout = (struct buffer_layout){
-        .type   = NGPU_TYPE_VEC3,
+        .type   = type,
         .format = format,
-        .stride = ngpu_format_get_bytes_per_pixel(format),
+        .stride = stride,
         .comp   = ngpu_format_get_nb_comp(format),
         .count  = count,
         .offset = 0,
     };
-    return gen_buffer(s, bufferp, layout, data, NGPU_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    return 0;
 }
 
 int ngli_geometry_set_vertices(struct geometry *s, size_t n, const float *vertices)
 {
     ngli_assert(!(s->buffer_ownership & OWN_VERTICES));
     s->buffer_ownership |= OWN_VERTICES;
-    return gen_vec3(s, &s->vertices_buffer, &s->vertices_layout, n, vertices);
+
+    if (n) {
+        s->has_bounds = 1;
+        memcpy(s->bounds_min, vertices, sizeof(s->bounds_min));
+        memcpy(s->bounds_max, vertices, sizeof(s->bounds_max));
+        for (size_t i = 1; i < n; i++) {
+            for (size_t c = 0; c < 3; c++) {
+                s->bounds_min[c] = NGLI_MIN(s->bounds_min[c], vertices[i * 3 + c]);
+                s->bounds_max[c] = NGLI_MAX(s->bounds_max[c], vertices[i * 3 + c]);
+            }
+        }
+    }
+
+    return stage_attribute(s, &s->vertices_data, &s->vertices_layout,
+                           NGPU_TYPE_VEC3, NGPU_FORMAT_R32G32B32_SFLOAT, n, vertices);
 }
 
 int ngli_geometry_set_normals(struct geometry *s, size_t n, const float *normals)
 {
     ngli_assert(!(s->buffer_ownership & OWN_NORMALS));
     s->buffer_ownership |= OWN_NORMALS;
-    return gen_vec3(s, &s->normals_buffer, &s->normals_layout, n, normals);
-}
-
-static int gen_vec2(struct geometry *s,
-                    struct ngpu_buffer **bufferp, struct buffer_layout *layout,
-                    size_t count, const float *data)
-{
-    const enum ngpu_format format = NGPU_FORMAT_R32G32_SFLOAT;
-    *layout = (struct buffer_layout){
-        .type   = NGPU_TYPE_VEC2,
-        .format = format,
-        .stride = ngpu_format_get_bytes_per_pixel(format),
-        .comp   = ngpu_format_get_nb_comp(format),
-        .count  = count,
-        .offset = 0,
-    };
-    return gen_buffer(s, bufferp, layout, data, NGPU_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    return stage_attribute(s, &s->normals_data, &s->normals_layout,
+                           NGPU_TYPE_VEC3, NGPU_FORMAT_R32G32B32_SFLOAT, n, normals);
 }
 
 int ngli_geometry_set_uvcoords(struct geometry *s, size_t n, const float *uvcoords)
 {
     ngli_assert(!(s->buffer_ownership & OWN_UVCOORDS));
     s->buffer_ownership |= OWN_UVCOORDS;
-    return gen_vec2(s, &s->uvcoords_buffer, &s->uvcoords_layout, n, uvcoords);
+    return stage_attribute(s, &s->uvcoords_data, &s->uvcoords_layout,
+                           NGPU_TYPE_VEC2, NGPU_FORMAT_R32G32_SFLOAT, n, uvcoords);
 }
 
-int ngli_geometry_set_indices(struct geometry *s, size_t count, const uint16_t *indices)
+static void set_indices_layout(struct geometry *s, enum ngpu_format format, size_t count)
 {
-    ngli_assert(!(s->buffer_ownership & OWN_INDICES));
-    s->buffer_ownership |= OWN_INDICES;
-    const enum ngpu_format format = NGPU_FORMAT_R16_UNORM;
     s->indices_layout = (struct buffer_layout){
         .type   = NGPU_TYPE_NONE,
         .format = format,
@@ -130,9 +256,46 @@ int ngli_geometry_set_indices(struct geometry *s, size_t count, const uint16_t *
         .count  = count,
         .offset = 0,
     };
+}
+
+int ngli_geometry_set_indices(struct geometry *s, size_t count, const uint16_t *indices)
+{
+    ngli_assert(!(s->buffer_ownership & OWN_INDICES));
+    s->buffer_ownership |= OWN_INDICES;
+    s->indices_data = ngli_memdup(indices, count * sizeof(*indices));
+    if (!s->indices_data)
+        return NGL_ERROR_MEMORY;
+    set_indices_layout(s, NGPU_FORMAT_R16_UNORM, count);
     for (size_t i = 0; i < count; i++)
         s->max_indices = NGLI_MAX(s->max_indices, indices[i]);
-    return gen_buffer(s, &s->indices_buffer, &s->indices_layout, indices, NGPU_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    return 0;
+}
+
+int ngli_geometry_set_indices_u32(struct geometry *s, size_t count, const uint32_t *indices)
+{
+    int64_t max_indices = 0;
+    for (size_t i = 0; i < count; i++)
+        max_indices = NGLI_MAX(max_indices, indices[i]);
+
+    if (max_indices > UINT16_MAX) {
+        ngli_assert(!(s->buffer_ownership & OWN_INDICES));
+        s->buffer_ownership |= OWN_INDICES;
+        s->indices_data = ngli_memdup(indices, count * sizeof(*indices));
+        if (!s->indices_data)
+            return NGL_ERROR_MEMORY;
+        set_indices_layout(s, NGPU_FORMAT_R32_UINT, count);
+        s->max_indices = max_indices;
+        return 0;
+    }
+
+    uint16_t *indices_u16 = ngli_calloc(count, sizeof(*indices_u16));
+    if (!indices_u16)
+        return NGL_ERROR_MEMORY;
+    for (size_t i = 0; i < count; i++)
+        indices_u16[i] = (uint16_t)indices[i];
+    int ret = ngli_geometry_set_indices(s, count, indices_u16);
+    ngli_freep(&indices_u16);
+    return ret;
 }
 
 void ngli_geometry_set_vertices_buffer(struct geometry *s, struct ngpu_buffer *buffer, struct buffer_layout layout)
@@ -165,6 +328,83 @@ void ngli_geometry_set_indices_buffer(struct geometry *s, struct ngpu_buffer *bu
     s->max_indices = max_indices;
 }
 
+static int init_attributes_buffer(struct geometry *s)
+{
+    struct {
+        float *data;
+        struct buffer_layout *layout;
+        struct ngpu_buffer **bufferp;
+    } attributes[] = {
+        {s->vertices_data, &s->vertices_layout, &s->vertices_buffer},
+        {s->uvcoords_data, &s->uvcoords_layout, &s->uvcoords_buffer},
+        {s->normals_data,  &s->normals_layout,  &s->normals_buffer},
+    };
+
+    size_t count = 0;
+    size_t stride = 0;
+    for (size_t i = 0; i < NGLI_ARRAY_NB(attributes); i++) {
+        if (!attributes[i].data)
+            continue;
+        count = attributes[i].layout->count;
+        stride += attributes[i].layout->stride;
+    }
+    if (!stride)
+        return 0;
+
+    uint8_t *data = ngli_calloc(count, stride);
+    if (!data)
+        return NGL_ERROR_MEMORY;
+
+    size_t offset = 0;
+    for (size_t i = 0; i < NGLI_ARRAY_NB(attributes); i++) {
+        if (!attributes[i].data)
+            continue;
+        struct buffer_layout *layout = attributes[i].layout;
+        const uint8_t *src = (const uint8_t *)attributes[i].data;
+        uint8_t *dst = data + offset;
+        for (size_t j = 0; j < count; j++) {
+            memcpy(dst, src, layout->stride);
+            src += layout->stride;
+            dst += stride;
+        }
+        layout->offset = offset;
+        offset += layout->stride;
+        layout->stride = stride;
+    }
+
+    int ret = get_buffer(s, &s->attributes_buffer, &s->attributes_key, CACHED_ATTRIBUTES,
+                         data, count * stride, NGPU_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    ngli_freep(&data);
+    if (ret < 0)
+        return ret;
+
+    for (size_t i = 0; i < NGLI_ARRAY_NB(attributes); i++) {
+        if (attributes[i].data)
+            *attributes[i].bufferp = s->attributes_buffer;
+    }
+
+    ngli_freep(&s->vertices_data);
+    ngli_freep(&s->uvcoords_data);
+    ngli_freep(&s->normals_data);
+    return 0;
+}
+
+static int init_indices_buffer(struct geometry *s)
+{
+    if (!s->indices_data)
+        return 0;
+
+    const struct buffer_layout *layout = &s->indices_layout;
+    int ret = get_buffer(s, &s->indices_buffer, &s->indices_key, CACHED_INDICES,
+                         s->indices_data, layout->count * layout->stride,
+                         NGPU_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    if (ret < 0)
+        return ret;
+
+    ngli_freep(&s->indices_data);
+    return 0;
+}
+
 int ngli_geometry_init(struct geometry *s, enum ngpu_primitive_topology topology)
 {
     s->topology = topology;
@@ -179,6 +419,11 @@ int ngli_geometry_init(struct geometry *s, enum ngpu_primitive_topology topology
         return NGL_ERROR_INVALID_ARG;
     }
 
+    int ret;
+    if ((ret = init_attributes_buffer(s)) < 0 ||
+        (ret = init_indices_buffer(s)) < 0)
+        return ret;
+
     return 0;
 }
 
@@ -187,13 +432,12 @@ void ngli_geometry_freep(struct geometry **sp)
     struct geometry *s = *sp;
     if (!s)
         return;
-    if (s->buffer_ownership & OWN_VERTICES)
-        ngpu_buffer_freep(&s->vertices_buffer);
-    if (s->buffer_ownership & OWN_UVCOORDS)
-        ngpu_buffer_freep(&s->uvcoords_buffer);
-    if (s->buffer_ownership & OWN_NORMALS)
-        ngpu_buffer_freep(&s->normals_buffer);
+    release_buffer(s, &s->attributes_buffer, s->attributes_key, CACHED_ATTRIBUTES);
     if (s->buffer_ownership & OWN_INDICES)
-        ngpu_buffer_freep(&s->indices_buffer);
-    ngli_freep(&s);
+        release_buffer(s, &s->indices_buffer, s->indices_key, CACHED_INDICES);
+    ngli_freep(&s->vertices_data);
+    ngli_freep(&s->uvcoords_data);
+    ngli_freep(&s->normals_data);
+    ngli_freep(&s->indices_data);
+    ngli_freep(sp);
 }
@@ -28,9 +28,11 @@
 #include "ngpu/pipeline.h"
 
 struct ngpu_ctx;
+struct geometry_cache;
 
 struct geometry {
     struct ngpu_ctx *gpu_ctx;
+    struct geometry_cache *cache;
 
     struct ngpu_buffer *vertices_buffer;
     struct ngpu_buffer *uvcoords_buffer;
@@ -39,6 +41,21 @@ struct geometry {
 
     uint32_t buffer_ownership;
 
+    /*
+     * Attributes set from CPU buffers are staged until ngli_geometry_init(),
+     * where they are interleaved into a single vertex buffer: the vertices,
+     * uvcoords and normals buffers then all point to attributes_buffer, and
+     * their layouts only differ by their offset.
+     */
+    float *vertices_data;
+    float *uvcoords_data;
+    float *normals_data;
+    void *indices_data;
+    struct ngpu_buffer *attributes_buffer;
+    uint32_t cached_buffers;
+    uint64_t attributes_key;
+    uint64_t indices_key;
+
     struct buffer_layout vertices_layout;
     struct buffer_layout uvcoords_layout;
     struct buffer_layout normals_layout;
@@ -47,15 +64,31 @@ struct geometry {
     enum ngpu_primitive_topology topology;
 
     int64_t max_indices;
+
+    /* Bounding box of the vertices, only known for CPU staged vertices */
+    int has_bounds;
+    float bounds_min[3];
+    float bounds_max[3];
 };
 
-struct geometry *ngli_geometry_create(struct ngpu_ctx *gpu_ctx);
+/*
+ * Context-level cache of the GPU buffers built from CPU data: geometries
+ * with identical content (typically the default shapes instantiated many
+ * times in a scene) share the same vertex and index buffers.
+ */
+struct geometry_cache *ngli_geometry_cache_create(struct ngpu_ctx *gpu_ctx);
+void ngli_geometry_cache_freep(struct geometry_cache **sp);
+
+/* The cache is optional and can be NULL */
+struct geometry *ngli_geometry_create(struct ngpu_ctx *gpu_ctx, struct geometry_cache *cache);
 
 /* Set vertices/uvs/normals/indices from CPU buffers */
 int ngli_geometry_set_vertices(struct geometry *s, size_t n, const float *vertices);
 int ngli_geometry_set_uvcoords(struct geometry *s, size_t n, const float *uvcoords);
 int ngli_geometry_set_normals(struct geometry *s, size_t n, const float *indices);
 int ngli_geometry_set_indices(struct geometry *s, size_t n, const uint16_t *indices);
+/* 32-bit indices are narrowed to 16-bit if they all fit */
+int ngli_geometry_set_indices_u32(struct geometry *s, size_t n, const uint32_t *indices);
 
 /* With the following functions, the user own the buffers already */
 void ngli_geometry_set_vertices_buffer(struct geometry *s, struct ngpu_buffer *buffer, struct buffer_layout layout);
@@ -25,14 +25,14 @@
 
 /*
  * dist: distance to the shape (negative outside, positive inside)
+ * aa: pixel width estimate in the distance unit
  * color: RGB color, opacity stored in the alpha channel (not premultiplied)
  * outline: RGB color for the outline, width stored in the alpha channel
  * glow: RGB color for the glow, intensity stored in the alpha channel
  * blur: blur amount
  */
-vec4 get_path_color(float dist, vec4 color, vec4 outline, vec4 glow, float blur, float outline_pos)
+vec4 get_path_color_aa(float dist, float aa, vec4 color, vec4 outline, vec4 glow, float blur, float outline_pos)
 {
-    float aa = fwidth(dist); // pixel width estimates
     float w = max(aa, blur) * 0.5; // half diffuse width
     vec2 d = dist + mix(vec2(-1,0), vec2(0,1), ngli_sat(outline_pos)) * outline.a; // inner and outer boundaries
     float inner_mask = smoothstep(-w, w, d.x); // cut off between the outline and the outside (whole shape w/ outline)
@@ -47,3 +47,9 @@ vec4 get_path_color(float dist, vec4 color, vec4 outline, vec4 glow, float blur,
 
     return vec4(ngli_linear2srgb(out_color.rgb), out_color.a) * color.a;
 }
+
+vec4 get_path_color(float dist, vec4 color, vec4 outline, vec4 glow, float blur, float outline_pos)
+{
+    float aa = fwidth(dist); // pixel width estimates
+    return get_path_color_aa(dist, aa, color, outline, glow, blur, outline_pos);
+}
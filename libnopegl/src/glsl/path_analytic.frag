@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include path.glsl
+
+/*
+ * Signed distance to the flattened path (positive inside), using only the
+ * lines binned in the horizontal band of the current point. The lines of a
+ * band are the ones overlapping it once extended by the margin, so the
+ * distance is exact up to the margin and clamped beyond. Only the first
+ * band.y lines (coming from closed sub-paths) contribute to the non-zero
+ * winding number.
+ */
+float get_path_dist(vec2 p)
+{
+    float band_h = (coords.w - coords.y) / float(segments.nb_bands);
+    int band_id = clamp(int(floor((p.y - coords.y) / band_h)), 0, segments.nb_bands - 1);
+    ivec4 band = segments.bands[band_id];
+
+    float band_y0 = coords.y + float(band_id) * band_h;
+    float edge_dist = max(min(p.y - band_y0, band_y0 + band_h - p.y), 0.0);
+    float dist = edge_dist + segments.margin;
+
+    int winding_number = 0;
+    for (int i = 0; i < band.z; i++) {
+        vec4 line = segments.lines[band.x + i];
+        vec2 a = line.xy;
+        vec2 b = line.zw;
+        vec2 pa = p - a;
+        vec2 ba = b - a;
+        float h = ngli_sat(dot(pa, ba) / max(dot(ba, ba), 1e-12));
+        dist = min(dist, length(pa - ba * h));
+
+        /* Crossings of a ray casted from p towards +x */
+        if (i < band.y) {
+            bool up   = a.y <= p.y && b.y > p.y;
+            bool down = b.y <= p.y && a.y > p.y;
+            if ((up || down) && a.x + (p.y - a.y) * ba.x / ba.y > p.x)
+                winding_number += up ? 1 : -1;
+        }
+    }
+
+    return winding_number != 0 ? dist : -dist;
+}
+
+void main()
+{
+    vec2 pos = mix(coords.xy, coords.zw, uv);
+    float dist = get_path_dist(pos);
+
+    /*
+     * The distance is exact (unit gradient) so the pixel width is derived
+     * from the position rather than the distance: the derivatives are then
+     * independent of the storage buffer reads and the loop above
+     */
+    vec2 pos_fw = fwidth(pos);
+    float aa = max(pos_fw.x, pos_fw.y);
+    ngl_out_color = get_path_color_aa(dist, aa, vec4(color, opacity), vec4(outline_color, outline), vec4(glow_color, glow), blur, outline_pos);
+}
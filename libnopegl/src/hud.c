@@ -55,6 +55,8 @@
 #include "nopegl.h"
 #include "pipeline_compat.h"
 #include "utils/memory.h"
+#include "utils/pthread_compat.h"
+#include "utils/thread.h"
 #include "utils/time.h"
 
 struct transforms_block {
@@ -75,8 +77,32 @@ struct hud {
 #endif
     struct darray widgets;
     uint32_t bg_color_u32;
+
+    /*
+     * Stats export: the render thread pushes fixed-size binary samples into a
+     * ring buffer which is drained by a writer thread in charge of the
+     * formatting and the I/O. The lock only protects the read/write indexes.
+     * When the ring buffer is full, the render thread waits for the writer
+     * thread to release a slot so that no sample is lost.
+     */
     FILE *fp_export;
     struct bstr *csv_line;
+    size_t nb_export_values;
+    double *export_times;
+    int64_t *export_values;
+    size_t export_read;
+    size_t export_write;
+    int export_stop;
+    int export_thread_started;
+    uint64_t nb_export_stalls;
+    uint64_t last_uploaded_bytes;
+    uint64_t last_pipeline_binds;
+    uint64_t last_buffer_waits;
+    pthread_t export_tid;
+    pthread_mutex_t export_lock;
+    pthread_cond_t export_cond;
+    pthread_cond_t export_space_cond;
+
     struct canvas canvas;
     double refresh_rate_interval;
     double last_refresh_time;
@@ -92,6 +118,8 @@ struct hud {
 #define WIDGET_PADDING 4
 #define WIDGET_MARGIN  2
 
+#define EXPORT_QUEUE_SIZE 512
+
 #define LATENCY_WIDGET_TEXT_LEN     20
 #define MEMORY_WIDGET_TEXT_LEN      25
 #define ACTIVITY_WIDGET_TEXT_LEN    12
@@ -126,10 +154,25 @@ enum {
     DRAWCALL_COMPUTES,
     DRAWCALL_GRAPHICCONFIGS,
     DRAWCALL_DRAWS,
+    DRAWCALL_CULLED,
     DRAWCALL_RTTS,
     NB_DRAWCALL
 };
 
+/* Series only available in the stats export */
+enum {
+    EXPORT_UPLOADED_BYTES,
+    EXPORT_PIPELINE_BINDS,
+    EXPORT_BUFFER_WAITS,
+    NB_EXPORT
+};
+
+static const char * const export_labels[NB_EXPORT] = {
+    [EXPORT_UPLOADED_BYTES] = "upload bytes",
+    [EXPORT_PIPELINE_BINDS] = "pipeline binds",
+    [EXPORT_BUFFER_WAITS]   = "buffer waits",
+};
+
 #define BUFFER_NODES                \
     NGL_NODE_ANIMATEDBUFFERFLOAT,   \
     NGL_NODE_ANIMATEDBUFFERVEC2,    \
@@ -230,9 +273,20 @@ static const struct activity_spec {
     },
 };
 
+#define DRAW_NODES                  \
+    NGL_NODE_DRAW,                  \
+    NGL_NODE_DRAWCOLOR,             \
+    NGL_NODE_DRAWGRADIENT,          \
+    NGL_NODE_DRAWGRADIENT4,         \
+    NGL_NODE_DRAWHISTOGRAM,         \
+    NGL_NODE_DRAWPATH,              \
+    NGL_NODE_DRAWTEXTURE,           \
+    NGL_NODE_DRAWWAVEFORM
+
 static const struct drawcall_spec {
     const char *label;
     const uint32_t *node_types;
+    int culled; // count the culled draws instead of the submitted ones
 } drawcall_specs[] = {
     [DRAWCALL_COMPUTES] = {
         .label="Computes",
@@ -244,17 +298,12 @@ static const struct drawcall_spec {
     },
     [DRAWCALL_DRAWS] = {
         .label="Draws",
-        .node_types=(const uint32_t[]){
-            NGL_NODE_DRAW,
-            NGL_NODE_DRAWCOLOR,
-            NGL_NODE_DRAWGRADIENT,
-            NGL_NODE_DRAWGRADIENT4,
-            NGL_NODE_DRAWHISTOGRAM,
-            NGL_NODE_DRAWPATH,
-            NGL_NODE_DRAWTEXTURE,
-            NGL_NODE_DRAWWAVEFORM,
-            NGLI_NODE_NONE
-        },
+        .node_types=(const uint32_t[]){DRAW_NODES, NGLI_NODE_NONE},
+    },
+    [DRAWCALL_CULLED] = {
+        .label="Culled",
+        .node_types=(const uint32_t[]){DRAW_NODES, NGLI_NODE_NONE},
+        .culled=1,
     },
     [DRAWCALL_RTTS] = {
         .label="RTTs",
@@ -330,7 +379,8 @@ struct widget_spec {
     void (*make_stats)(struct hud *s, struct widget *widget);
     void (*draw)(struct hud *s, struct widget *widget);
     void (*csv_header)(struct hud *s, struct widget *widget, struct bstr *dst);
-    void (*csv_report)(struct hud *s, struct widget *widget, struct bstr *dst);
+    size_t nb_csv_values;
+    void (*csv_sample)(struct hud *s, struct widget *widget, int64_t *dst);
     void (*uninit)(struct hud *s, struct widget *widget);
 };
 
@@ -484,11 +534,14 @@ static void widget_activity_make_stats(struct hud *s, struct widget *widget)
 static void widget_drawcall_make_stats(struct hud *s, struct widget *widget)
 {
     struct widget_drawcall *priv = widget->priv_data;
+    const struct drawcall_spec *spec = widget->user_data;
     struct darray *nodes_array = &priv->nodes;
     struct ngl_node **nodes = ngli_darray_data(nodes_array);
     priv->nb_draws = 0;
-    for (size_t i = 0; i < ngli_darray_count(nodes_array); i++)
-        priv->nb_draws += nodes[i]->draw_count;
+    for (size_t i = 0; i < ngli_darray_count(nodes_array); i++) {
+        const struct ngl_node *node = nodes[i];
+        priv->nb_draws += spec->culled ? node->cull_count : node->draw_count - node->cull_count;
+    }
 }
 
 /* Draw utils */
@@ -739,36 +792,33 @@ static void widget_drawcall_csv_header(struct hud *s, struct widget *widget, str
     ngli_bstr_print(dst, spec->label);
 }
 
-/* Widget CSV report */
+/* Widget CSV sample */
 
-static void widget_latency_csv_report(struct hud *s, struct widget *widget, struct bstr *dst)
+static void widget_latency_csv_sample(struct hud *s, struct widget *widget, int64_t *dst)
 {
     const struct widget_latency *priv = widget->priv_data;
-    for (size_t i = 0; i < NB_LATENCY; i++) {
-        const int64_t t = get_latency_avg(priv, i);
-        ngli_bstr_printf(dst, "%s%"PRId64, i ? "," : "", t);
-    }
+    for (size_t i = 0; i < NB_LATENCY; i++)
+        dst[i] = get_latency_avg(priv, i);
 }
 
-static void widget_memory_csv_report(struct hud *s, struct widget *widget, struct bstr *dst)
+static void widget_memory_csv_sample(struct hud *s, struct widget *widget, int64_t *dst)
 {
     const struct widget_memory *priv = widget->priv_data;
-    for (size_t i = 0; i < NB_MEMORY; i++) {
-        const size_t size = priv->sizes[i];
-        ngli_bstr_printf(dst, "%s%zu", i ? "," : "", size);
-    }
+    for (size_t i = 0; i < NB_MEMORY; i++)
+        dst[i] = (int64_t)priv->sizes[i];
 }
 
-static void widget_activity_csv_report(struct hud *s, struct widget *widget, struct bstr *dst)
+static void widget_activity_csv_sample(struct hud *s, struct widget *widget, int64_t *dst)
 {
     const struct widget_activity *priv = widget->priv_data;
-    ngli_bstr_printf(dst, "%d,%zu", priv->nb_actives, priv->nodes.count);
+    dst[0] = priv->nb_actives;
+    dst[1] = (int64_t)priv->nodes.count;
 }
 
-static void widget_drawcall_csv_report(struct hud *s, struct widget *widget, struct bstr *dst)
+static void widget_drawcall_csv_sample(struct hud *s, struct widget *widget, int64_t *dst)
 {
     const struct widget_drawcall *priv = widget->priv_data;
-    ngli_bstr_printf(dst, "%d", priv->nb_draws);
+    dst[0] = priv->nb_draws;
 }
 
 /* Widget uninit */
@@ -810,7 +860,8 @@ static const struct widget_spec widget_specs[] = {
         .make_stats    = widget_latency_make_stats,
         .draw          = widget_latency_draw,
         .csv_header    = widget_latency_csv_header,
-        .csv_report    = widget_latency_csv_report,
+        .nb_csv_values = NB_LATENCY,
+        .csv_sample    = widget_latency_csv_sample,
         .uninit        = widget_latency_uninit,
     },
     [WIDGET_MEMORY] = {
@@ -823,7 +874,8 @@ static const struct widget_spec widget_specs[] = {
         .make_stats    = widget_memory_make_stats,
         .draw          = widget_memory_draw,
         .csv_header    = widget_memory_csv_header,
-        .csv_report    = widget_memory_csv_report,
+        .nb_csv_values = NB_MEMORY,
+        .csv_sample    = widget_memory_csv_sample,
         .uninit        = widget_memory_uninit,
     },
     [WIDGET_ACTIVITY] = {
@@ -836,7 +888,8 @@ static const struct widget_spec widget_specs[] = {
         .make_stats    = widget_activity_make_stats,
         .draw          = widget_activity_draw,
         .csv_header    = widget_activity_csv_header,
-        .csv_report    = widget_activity_csv_report,
+        .nb_csv_values = 2,
+        .csv_sample    = widget_activity_csv_sample,
         .uninit        = widget_activity_uninit,
     },
     [WIDGET_DRAWCALL]  = {
@@ -849,7 +902,8 @@ static const struct widget_spec widget_specs[] = {
         .make_stats    = widget_drawcall_make_stats,
         .draw          = widget_drawcall_draw,
         .csv_header    = widget_drawcall_csv_header,
-        .csv_report    = widget_drawcall_csv_report,
+        .nb_csv_values = 1,
+        .csv_sample    = widget_drawcall_csv_sample,
         .uninit        = widget_drawcall_uninit,
     },
 };
@@ -1017,8 +1071,10 @@ static void widget_drawcall_reset_draws(struct widget *widget)
     for (size_t i = 0; i < NB_DRAWCALL; i++) {
         struct darray *nodes_array = &priv->nodes;
         struct ngl_node **nodes = ngli_darray_data(nodes_array);
-        for (size_t j = 0; j < ngli_darray_count(nodes_array); j++)
+        for (size_t j = 0; j < ngli_darray_count(nodes_array); j++) {
             nodes[j]->draw_count = 0;
+            nodes[j]->cull_count = 0;
+        }
     }
 }
 
@@ -1070,8 +1126,13 @@ static int widgets_csv_header(struct hud *s)
         struct widget *widget = &widgets[i];
         ngli_bstr_print(s->csv_line, i ? "," : "");
         widget_specs[widget->type].csv_header(s, widget, s->csv_line);
+        s->nb_export_values += widget_specs[widget->type].nb_csv_values;
     }
 
+    for (size_t i = 0; i < NB_EXPORT; i++)
+        ngli_bstr_printf(s->csv_line, ",%s", export_labels[i]);
+    s->nb_export_values += NB_EXPORT;
+
     ngli_bstr_print(s->csv_line, "\n");
 
     const size_t len = ngli_bstr_len(s->csv_line);
@@ -1084,44 +1145,179 @@ static int widgets_csv_header(struct hud *s)
     return 0;
 }
 
-static void widgets_csv_report(struct hud *s)
+static void write_csv_sample(struct hud *s, size_t index)
 {
-    const struct ngl_ctx *ctx = s->ctx;
-    const struct ngl_node *scene = ctx->scene->params.root;
+    const double t = s->export_times[index];
+    const int64_t *values = s->export_values + index * s->nb_export_values;
+
+    ngli_bstr_clear(s->csv_line);
+    ngli_bstr_printf(s->csv_line, "%f", t);
+    for (size_t i = 0; i < s->nb_export_values; i++)
+        ngli_bstr_printf(s->csv_line, ",%"PRId64, values[i]);
+    ngli_bstr_print(s->csv_line, "\n");
+
+    const size_t len = ngli_bstr_len(s->csv_line);
+    fwrite(ngli_bstr_strptr(s->csv_line), 1, len, s->fp_export);
+}
+
+static void *export_thread(void *arg)
+{
+    struct hud *s = arg;
+
+    ngli_thread_set_name("ngl-hud-export");
 
     /*
-     * Set C locale temporarily so floats are printed deterministically. We
-     * don't know how the API user is handling the locale, so we do it at the
-     * beginning of the inner draw function and restore it at its end.
+     * The C locale is set on the writer thread only so floats are printed
+     * deterministically without altering the locale of the API user.
      */
 #if HAVE_USELOCALE
-    const locale_t prev_locale = uselocale(s->c_locale);
+    uselocale(s->c_locale);
 #elif defined(_WIN32)
-    const char *prev_locale = setlocale(LC_ALL, NULL);
+    _configthreadlocale(_ENABLE_PER_THREAD_LOCALE);
     if (!setlocale(LC_ALL, "C"))
         LOG(ERROR, "unable to set C locale");
 #endif
 
-    ngli_bstr_clear(s->csv_line);
-    ngli_bstr_printf(s->csv_line, "%f", scene ? scene->last_update_time : 0);
+    pthread_mutex_lock(&s->export_lock);
+    for (;;) {
+        while (s->export_read == s->export_write && !s->export_stop)
+            pthread_cond_wait(&s->export_cond, &s->export_lock);
+        if (s->export_read == s->export_write)
+            break;
+
+        /* The slot can not be overwritten until the read index is advanced */
+        const size_t index = s->export_read % EXPORT_QUEUE_SIZE;
+        pthread_mutex_unlock(&s->export_lock);
+        write_csv_sample(s, index);
+        pthread_mutex_lock(&s->export_lock);
+        s->export_read++;
+        pthread_cond_signal(&s->export_space_cond);
+    }
+    pthread_mutex_unlock(&s->export_lock);
+
+    fflush(s->fp_export);
+
+#if HAVE_USELOCALE
+    uselocale(LC_GLOBAL_LOCALE);
+#endif
+
+    return NULL;
+}
+
+static int export_init(struct hud *s)
+{
+    int ret = widgets_csv_header(s);
+    if (ret < 0)
+        return ret;
+
+    const struct ngpu_ctx *gpu_ctx = s->ctx->gpu_ctx;
+    s->last_uploaded_bytes = gpu_ctx->nb_uploaded_bytes;
+    s->last_pipeline_binds = gpu_ctx->nb_pipeline_binds;
+    s->last_buffer_waits = gpu_ctx->nb_buffer_waits;
+
+    s->export_times = ngli_calloc(EXPORT_QUEUE_SIZE, sizeof(*s->export_times));
+    s->export_values = ngli_calloc(EXPORT_QUEUE_SIZE * s->nb_export_values, sizeof(*s->export_values));
+    if (!s->export_times || !s->export_values)
+        return NGL_ERROR_MEMORY;
+
+    if (pthread_mutex_init(&s->export_lock, NULL))
+        return NGL_ERROR_EXTERNAL;
+
+    if (pthread_cond_init(&s->export_cond, NULL)) {
+        pthread_mutex_destroy(&s->export_lock);
+        return NGL_ERROR_EXTERNAL;
+    }
+
+    if (pthread_cond_init(&s->export_space_cond, NULL)) {
+        pthread_cond_destroy(&s->export_cond);
+        pthread_mutex_destroy(&s->export_lock);
+        return NGL_ERROR_EXTERNAL;
+    }
+
+    if (pthread_create(&s->export_tid, NULL, export_thread, s)) {
+        pthread_cond_destroy(&s->export_space_cond);
+        pthread_cond_destroy(&s->export_cond);
+        pthread_mutex_destroy(&s->export_lock);
+        return NGL_ERROR_EXTERNAL;
+    }
+    s->export_thread_started = 1;
+
+    return 0;
+}
+
+static void export_reset(struct hud *s)
+{
+    if (s->export_thread_started) {
+        pthread_mutex_lock(&s->export_lock);
+        s->export_stop = 1;
+        pthread_cond_signal(&s->export_cond);
+        pthread_mutex_unlock(&s->export_lock);
+        pthread_join(s->export_tid, NULL);
+        pthread_cond_destroy(&s->export_space_cond);
+        pthread_cond_destroy(&s->export_cond);
+        pthread_mutex_destroy(&s->export_lock);
+        s->export_thread_started = 0;
+    }
+
+    if (s->nb_export_stalls)
+        LOG(WARNING, "the rendering waited %" PRIu64 " times for the stats export to keep up, "
+            "the measures of these frames include the wait", s->nb_export_stalls);
+
+    if (s->fp_export) {
+        fclose(s->fp_export);
+        s->fp_export = NULL;
+    }
+    ngli_bstr_freep(&s->csv_line);
+    ngli_freep(&s->export_times);
+    ngli_freep(&s->export_values);
+
+#if HAVE_USELOCALE
+    if (s->c_locale) {
+        freelocale(s->c_locale);
+        s->c_locale = (locale_t)0;
+    }
+#endif
+}
+
+static void widgets_csv_report(struct hud *s)
+{
+    const struct ngl_ctx *ctx = s->ctx;
+    const struct ngl_node *scene = ctx->scene->params.root;
+    const struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+
+    pthread_mutex_lock(&s->export_lock);
+    if (s->export_write - s->export_read == EXPORT_QUEUE_SIZE) {
+        s->nb_export_stalls++;
+        while (s->export_write - s->export_read == EXPORT_QUEUE_SIZE)
+            pthread_cond_wait(&s->export_space_cond, &s->export_lock);
+    }
+    pthread_mutex_unlock(&s->export_lock);
+
+    /* The slot at the write index is not read until the write index is advanced */
+    const size_t index = s->export_write % EXPORT_QUEUE_SIZE;
+    int64_t *values = s->export_values + index * s->nb_export_values;
+    s->export_times[index] = scene ? scene->last_update_time : 0;
 
     struct darray *widgets_array = &s->widgets;
     struct widget *widgets = ngli_darray_data(widgets_array);
     for (size_t i = 0; i < ngli_darray_count(widgets_array); i++) {
-        ngli_bstr_print(s->csv_line, ",");
         struct widget *widget = &widgets[i];
-        widget_specs[widget->type].csv_report(s, widget, s->csv_line);
+        const struct widget_spec *spec = &widget_specs[widget->type];
+        spec->csv_sample(s, widget, values);
+        values += spec->nb_csv_values;
     }
-    ngli_bstr_print(s->csv_line, "\n");
-
-    const size_t len = ngli_bstr_len(s->csv_line);
-    fwrite(ngli_bstr_strptr(s->csv_line), 1, len, s->fp_export);
 
-#if HAVE_USELOCALE
-    uselocale(prev_locale);
-#elif defined(_WIN32)
-    setlocale(LC_ALL, prev_locale);
-#endif
+    values[EXPORT_UPLOADED_BYTES] = (int64_t)(gpu_ctx->nb_uploaded_bytes - s->last_uploaded_bytes);
+    values[EXPORT_PIPELINE_BINDS] = (int64_t)(gpu_ctx->nb_pipeline_binds - s->last_pipeline_binds);
+    values[EXPORT_BUFFER_WAITS] = (int64_t)(gpu_ctx->nb_buffer_waits - s->last_buffer_waits);
+    s->last_uploaded_bytes = gpu_ctx->nb_uploaded_bytes;
+    s->last_pipeline_binds = gpu_ctx->nb_pipeline_binds;
+    s->last_buffer_waits = gpu_ctx->nb_buffer_waits;
+
+    pthread_mutex_lock(&s->export_lock);
+    s->export_write++;
+    pthread_cond_signal(&s->export_cond);
+    pthread_mutex_unlock(&s->export_lock);
 }
 
 static void widgets_uninit(struct hud *s)
@@ -1194,7 +1390,7 @@ int ngli_hud_init(struct hud *s)
         LOG(WARNING, "no locale support found, assuming C is currently in use");
 #endif
 
-        return widgets_csv_header(s);
+        return export_init(s);
     }
 
     s->canvas.buf = ngli_calloc((size_t)s->canvas.w * (size_t)s->canvas.h, 4);
@@ -1419,10 +1615,7 @@ void ngli_hud_freep(struct hud **sp)
 
     widgets_uninit(s);
     ngli_free(s->canvas.buf);
-    if (s->fp_export) {
-        fclose(s->fp_export);
-        ngli_bstr_freep(&s->csv_line);
-    }
+    export_reset(s);
 
     ngli_freep(sp);
 }
@@ -29,14 +29,31 @@
 #include "internal.h"
 #include "log.h"
 #include "math_utils.h"
+#include "ngpu/ctx.h"
 #include "ngpu/format.h"
 #include "nopegl.h"
+#include "utils/memory.h"
+
+/*
+ * Persistently mapped buffer a plane is written to before being transferred
+ * to its texture. There is one such buffer per plane and per in-flight
+ * frame, so that writing the current frame never races with the GPU still
+ * reading the previous ones.
+ */
+struct upload_buffer {
+    struct ngpu_buffer *buffer;
+    uint8_t *data;
+    size_t linesize;
+    size_t height;
+};
 
 struct hwmap_common {
     int32_t width;
     int32_t height;
     size_t nb_planes;
     struct ngpu_texture *planes[4];
+    struct upload_buffer *upload_buffers;
+    size_t nb_upload_buffers;
 };
 
 static const struct format_desc {
@@ -183,6 +200,87 @@ static bool support_direct_rendering(struct hwmap *hwmap, const struct format_de
     return direct_rendering;
 }
 
+static bool support_upload_buffers(struct hwmap *hwmap)
+{
+    struct ngl_ctx *ctx = hwmap->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    const struct hwmap_params *params = &hwmap->params;
+
+    return (gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT) &&
+           (params->texture_usage & NGPU_TEXTURE_USAGE_TRANSFER_DST_BIT);
+}
+
+static int init_upload_buffers(struct hwmap *hwmap)
+{
+    struct ngl_ctx *ctx = hwmap->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    struct hwmap_common *common = hwmap->hwmap_priv_data;
+
+    const size_t nb_frames = ngpu_ctx_get_nb_in_flight_frames(gpu_ctx);
+    common->upload_buffers = ngli_calloc(nb_frames * common->nb_planes, sizeof(*common->upload_buffers));
+    if (!common->upload_buffers)
+        return NGL_ERROR_MEMORY;
+    common->nb_upload_buffers = nb_frames * common->nb_planes;
+
+    for (size_t i = 0; i < common->nb_upload_buffers; i++) {
+        struct upload_buffer *upload_buffer = &common->upload_buffers[i];
+        const struct ngpu_texture_params *params = &common->planes[i % common->nb_planes]->params;
+
+        upload_buffer->linesize = params->width * ngpu_format_get_bytes_per_pixel(params->format);
+        upload_buffer->height = params->height;
+
+        upload_buffer->buffer = ngpu_buffer_create(gpu_ctx);
+        if (!upload_buffer->buffer)
+            return NGL_ERROR_MEMORY;
+
+        const size_t size = upload_buffer->linesize * upload_buffer->height;
+        const uint32_t usage = NGPU_BUFFER_USAGE_DYNAMIC_BIT |
+                               NGPU_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                               NGPU_BUFFER_USAGE_MAP_WRITE |
+                               NGPU_BUFFER_USAGE_MAP_PERSISTENT;
+        int ret = ngpu_buffer_init(upload_buffer->buffer, size, usage);
+        if (ret < 0)
+            return ret;
+
+        void *data;
+        ret = ngpu_buffer_map(upload_buffer->buffer, 0, size, &data);
+        if (ret < 0)
+            return ret;
+        upload_buffer->data = data;
+    }
+
+    return 0;
+}
+
+static void reset_upload_buffers(struct hwmap_common *common)
+{
+    for (size_t i = 0; i < common->nb_upload_buffers; i++) {
+        struct upload_buffer *upload_buffer = &common->upload_buffers[i];
+        if (upload_buffer->data)
+            ngpu_buffer_unmap(upload_buffer->buffer);
+        ngpu_buffer_freep(&upload_buffer->buffer);
+    }
+    ngli_freep(&common->upload_buffers);
+    common->nb_upload_buffers = 0;
+}
+
+/*
+ * Return the mapped buffer the given plane of the next frame must be written
+ * to. This is the memory a decoder able to write into externally allocated
+ * frames would target directly.
+ */
+static struct upload_buffer *get_upload_buffer(struct hwmap *hwmap, size_t plane)
+{
+    struct ngl_ctx *ctx = hwmap->ctx;
+    struct hwmap_common *common = hwmap->hwmap_priv_data;
+
+    if (!common->upload_buffers)
+        return NULL;
+
+    const size_t frame_index = ngpu_ctx_get_current_frame_index(ctx->gpu_ctx);
+    return &common->upload_buffers[frame_index * common->nb_planes + plane];
+}
+
 static int common_init(struct hwmap *hwmap, struct nmd_frame *frame)
 {
     struct ngl_ctx *ctx = hwmap->ctx;
@@ -241,6 +339,14 @@ static int common_init(struct hwmap *hwmap, struct nmd_frame *frame)
 
     hwmap->require_hwconv = !support_direct_rendering(hwmap, desc);
 
+    if (support_upload_buffers(hwmap)) {
+        int ret = init_upload_buffers(hwmap);
+        if (ret < 0) {
+            LOG(WARNING, "unable to create persistent upload buffers, falling back on regular uploads");
+            reset_upload_buffers(common);
+        }
+    }
+
     return 0;
 }
 
@@ -248,10 +354,40 @@ static void common_uninit(struct hwmap *hwmap)
 {
     struct hwmap_common *common = hwmap->hwmap_priv_data;
 
+    reset_upload_buffers(common);
+
     for (size_t i = 0; i < NGLI_ARRAY_NB(common->planes); i++)
         ngpu_texture_freep(&common->planes[i]);
 }
 
+static int upload_plane(struct upload_buffer *upload_buffer, struct ngpu_texture *plane,
+                        const uint8_t *data, size_t linesize)
+{
+    /*
+     * The buffer slot was last used nb_in_flight_frames ago and
+     * ngpu_ctx_begin_update() already waited for the command buffers of that
+     * frame, on both backends. The fences of those command buffers are
+     * signaled at this point, so this wait only releases the references
+     * and does not block.
+     */
+    int ret = ngpu_buffer_wait(upload_buffer->buffer);
+    if (ret < 0)
+        return ret;
+
+    if (linesize == upload_buffer->linesize) {
+        memcpy(upload_buffer->data, data, upload_buffer->linesize * upload_buffer->height);
+    } else {
+        uint8_t *dst = upload_buffer->data;
+        for (size_t y = 0; y < upload_buffer->height; y++) {
+            memcpy(dst, data, upload_buffer->linesize);
+            dst += upload_buffer->linesize;
+            data += linesize;
+        }
+    }
+
+    return ngpu_texture_upload_from_buffer(plane, upload_buffer->buffer, 0, 0);
+}
+
 static int common_map_frame(struct hwmap *hwmap, struct nmd_frame *frame)
 {
     struct hwmap_common *common = hwmap->hwmap_priv_data;
@@ -263,6 +399,13 @@ static int common_map_frame(struct hwmap *hwmap, struct nmd_frame *frame)
             LOG(ERROR, "invalid linesize (%d) for plane %zu", frame->linesizep[i], i);
             return NGL_ERROR_UNSUPPORTED;
         }
+        struct upload_buffer *upload_buffer = get_upload_buffer(hwmap, i);
+        if (upload_buffer) {
+            int ret = upload_plane(upload_buffer, plane, frame->datap[i], (size_t)frame->linesizep[i]);
+            if (ret < 0)
+                return ret;
+            continue;
+        }
         const uint32_t linesize = (uint32_t)frame->linesizep[i] / (uint32_t)ngpu_format_get_bytes_per_pixel(params->format);
         int ret = ngpu_texture_upload(plane, frame->datap[i], linesize);
         if (ret < 0)
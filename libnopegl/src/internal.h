@@ -51,9 +51,15 @@
 #include "utils/pthread_compat.h"
 
 struct node_class;
+struct dynres;
+struct geometry_cache;
+struct rtt_pool;
+struct trace;
 
 typedef int (*cmd_func_type)(struct ngl_ctx *s, void *arg);
 
+#define NGLI_MAX_QUEUED_DRAWS 2
+
 struct api_impl {
     int (*configure)(struct ngl_ctx *s, const struct ngl_config *config);
     int (*resize)(struct ngl_ctx *s, uint32_t width, uint32_t height);
@@ -62,6 +68,7 @@ struct api_impl {
     int (*set_scene)(struct ngl_ctx *s, struct ngl_scene *scene);
     int (*prepare_draw)(struct ngl_ctx *s, double t);
     int (*draw)(struct ngl_ctx *s, double t);
+    int (*draw_async)(struct ngl_ctx *s, double t);
     void (*reset)(struct ngl_ctx *s, int action);
 
     /* OpenGL */
@@ -90,12 +97,15 @@ struct ngl_ctx {
     struct ngl_backend backend;
     struct ngpu_viewport viewport;
     struct ngpu_scissor scissor;
+    struct ngpu_scissor content_area; // area touched by the draws in the current render target
     struct ngpu_rendertarget *available_rendertargets[2];
     struct ngpu_rendertarget *current_rendertarget;
     float default_modelview_matrix[16];
     float default_projection_matrix[16];
     struct darray modelview_matrix_stack;
     struct darray projection_matrix_stack;
+    struct rtt_pool *rtt_pool;
+    struct geometry_cache *geometry_cache;
 
     /*
      * Array of nodes that are candidate to either prefetch (active) or release
@@ -104,6 +114,13 @@ struct ngl_ctx {
      */
     struct darray activitycheck_nodes;
 
+    /*
+     * Scene time at which the branch currently being visited is expected to
+     * become visible. It is set by the time filtering nodes while visiting a
+     * child activated ahead of time (prefetch), and is negative otherwise.
+     */
+    double visit_activation_time;
+
     struct hmap *text_builtin_atlasses; // struct text_builtin_atlas
 #if HAVE_TEXT_LIBRARIES
     FT_Library ft_library;
@@ -119,6 +136,8 @@ struct ngl_ctx {
     int64_t cpu_update_time;
     int64_t cpu_draw_time;
     int64_t gpu_draw_time;
+    struct trace *trace;
+    struct dynres *dynres;
 
     /* Shared fields */
     pthread_mutex_t lock;
@@ -127,12 +146,23 @@ struct ngl_ctx {
     cmd_func_type cmd_func;
     void *cmd_arg;
     int cmd_ret;
+
+    /*
+     * Ring buffer of the draws queued with ngl_draw_async(), executed by the
+     * worker thread in submission order. queued_draws_ret holds the first
+     * error returned by one of these draws since the last ngl_draw_wait().
+     */
+    double queued_draws[NGLI_MAX_QUEUED_DRAWS];
+    size_t queued_draws_pos;
+    size_t nb_queued_draws;
+    int queued_draws_ret;
 };
 
 #define NGLI_ACTION_KEEP_SCENE  0
 #define NGLI_ACTION_UNREF_SCENE 1
 
 int ngli_ctx_dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg);
+int ngli_ctx_queue_draw(struct ngl_ctx *s, double t);
 int ngli_ctx_configure(struct ngl_ctx *s, const struct ngl_config *config);
 int ngli_ctx_resize(struct ngl_ctx *s, uint32_t width, uint32_t height);
 int ngli_ctx_get_viewport(struct ngl_ctx *s, int32_t *viewport);
@@ -172,6 +202,7 @@ struct ngl_node {
     double last_update_time;
 
     int draw_count;
+    int cull_count; // draws skipped because out of the visible area
 
     int refcount;
     int ctx_refcount;
@@ -322,6 +322,24 @@ void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v)
     memcpy(dst, tmp, sizeof(tmp));
 }
 
+void ngli_mat4_mul_array_c(float *dst, const float *m1, const float *m2, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        ngli_mat4_mul_c(dst + i * 16, m1 + i * 16, m2 + i * 16);
+}
+
+void ngli_mat4_mul_vec4_array_c(float *dst, const float *m, const float *v, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        ngli_mat4_mul_vec4_c(dst + i * 4, m, v + i * 4);
+}
+
+void ngli_mat4_inverse_array_c(float *dst, const float *m, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        ngli_mat4_inverse(dst + i * 16, m + i * 16);
+}
+
 void ngli_mat4_look_at(float * restrict dst, float *eye, float *center, float *up)
 {
     float f[3] = NGLI_VEC3_SUB(center, eye);
@@ -22,6 +22,8 @@
 #ifndef MATH_UTILS_H
 #define MATH_UTILS_H
 
+#include <stddef.h>
+
 #include "config.h"
 
 #define PI_F32 3.14159265358979323846f
@@ -138,6 +140,17 @@ float ngli_mat4_determinant(const float *m);
 void ngli_mat4_inverse(float *dst, const float *m);
 void ngli_mat4_mul_c(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v);
+
+/*
+ * Batch versions on contiguous aligned data, where dst may alias any of the
+ * sources:
+ * - multiply `count` pairs of matrices (dst[i] = m1[i] * m2[i])
+ * - transform `count` vectors by the same matrix (dst[i] = m * v[i])
+ * - invert `count` matrices, with the same rules as ngli_mat4_inverse()
+ */
+void ngli_mat4_mul_array_c(float *dst, const float *m1, const float *m2, size_t count);
+void ngli_mat4_mul_vec4_array_c(float *dst, const float *m, const float *v, size_t count);
+void ngli_mat4_inverse_array_c(float *dst, const float *m, size_t count);
 void ngli_mat4_look_at(float * restrict dst, float *eye, float *center, float *up);
 void ngli_mat4_orthographic(float * restrict dst, float left, float right, float bottom, float top, float near, float far);
 void ngli_mat4_perspective(float * restrict dst, float fov, float aspect, float near, float far);
@@ -149,21 +162,46 @@ void ngli_mat4_skew(float * restrict dst, float x, float y, float z, const float
 
 /* Arch specific versions */
 
+/*
+ * On x86, the matrix batches are dispatched at runtime between the SSE and
+ * the AVX2 versions (see ngli_cpu_has_avx2()); the single operations are too
+ * short to amortize the check and always use SSE.
+ */
 #ifdef ARCH_AARCH64
-# define ngli_mat4_mul          ngli_mat4_mul_aarch64
-# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_aarch64
+# define ngli_mat4_mul             ngli_mat4_mul_aarch64
+# define ngli_mat4_mul_vec4        ngli_mat4_mul_vec4_aarch64
+# define ngli_mat4_mul_array       ngli_mat4_mul_array_aarch64
+# define ngli_mat4_mul_vec4_array  ngli_mat4_mul_vec4_array_aarch64
+# define ngli_mat4_inverse_array   ngli_mat4_inverse_array_c
 #elif defined(HAVE_X86_INTR)
-# define ngli_mat4_mul          ngli_mat4_mul_sse
-# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_sse
+# define ngli_mat4_mul             ngli_mat4_mul_sse
+# define ngli_mat4_mul_vec4        ngli_mat4_mul_vec4_sse
+# define ngli_mat4_mul_array       ngli_mat4_mul_array_x86
+# define ngli_mat4_mul_vec4_array  ngli_mat4_mul_vec4_array_sse
+# define ngli_mat4_inverse_array   ngli_mat4_inverse_array_x86
 #else
-# define ngli_mat4_mul          ngli_mat4_mul_c
-# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_c
+# define ngli_mat4_mul             ngli_mat4_mul_c
+# define ngli_mat4_mul_vec4        ngli_mat4_mul_vec4_c
+# define ngli_mat4_mul_array       ngli_mat4_mul_array_c
+# define ngli_mat4_mul_vec4_array  ngli_mat4_mul_vec4_array_c
+# define ngli_mat4_inverse_array   ngli_mat4_inverse_array_c
 #endif
 
 void ngli_mat4_mul_aarch64(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_aarch64(float *dst, const float *m, const float *v);
+void ngli_mat4_mul_array_aarch64(float *dst, const float *m1, const float *m2, size_t count);
+void ngli_mat4_mul_vec4_array_aarch64(float *dst, const float *m, const float *v, size_t count);
+
+int ngli_cpu_has_avx2(void);
 void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v);
+void ngli_mat4_mul_array_sse(float *dst, const float *m1, const float *m2, size_t count);
+void ngli_mat4_mul_array_avx2(float *dst, const float *m1, const float *m2, size_t count);
+void ngli_mat4_mul_array_x86(float *dst, const float *m1, const float *m2, size_t count);
+void ngli_mat4_mul_vec4_array_sse(float *dst, const float *m, const float *v, size_t count);
+void ngli_mat4_inverse_array_sse(float *dst, const float *m, size_t count);
+void ngli_mat4_inverse_array_avx2(float *dst, const float *m, size_t count);
+void ngli_mat4_inverse_array_x86(float *dst, const float *m, size_t count);
 
 #define NGLI_QUAT_IDENTITY {0.0f, 0.0f, 0.0f, 1.0f}
 
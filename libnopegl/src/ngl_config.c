@@ -48,10 +48,20 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
 {
     struct ngl_config tmp = *src;
 
+    tmp.hud_export_filename = NULL;
+    tmp.trace_filename = NULL;
+    tmp.backend_config = NULL;
+
     if (src->hud_export_filename) {
         tmp.hud_export_filename = ngli_strdup(src->hud_export_filename);
         if (!tmp.hud_export_filename)
-            return NGL_ERROR_MEMORY;
+            goto fail_memory;
+    }
+
+    if (src->trace_filename) {
+        tmp.trace_filename = ngli_strdup(src->trace_filename);
+        if (!tmp.trace_filename)
+            goto fail_memory;
     }
 
     if (src->backend_config) {
@@ -59,14 +69,12 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
             src->backend == NGL_BACKEND_OPENGLES) {
             const size_t size = sizeof(struct ngl_config_gl);
             tmp.backend_config = ngli_memdup(src->backend_config, size);
-            if (!tmp.backend_config) {
-                ngli_freep(&tmp.hud_export_filename);
-                return NGL_ERROR_MEMORY;
-            }
+            if (!tmp.backend_config)
+                goto fail_memory;
         } else {
-            ngli_freep(&tmp.hud_export_filename);
             LOG(ERROR, "backend_config %p is not supported by backend %u",
                 src->backend_config, src->backend);
+            ngli_config_reset(&tmp);
             return NGL_ERROR_UNSUPPORTED;
         }
     }
@@ -74,11 +82,16 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
     *dst = tmp;
 
     return 0;
+
+fail_memory:
+    ngli_config_reset(&tmp);
+    return NGL_ERROR_MEMORY;
 }
 
 void ngli_config_reset(struct ngl_config *config)
 {
     ngli_freep(&config->backend_config);
     ngli_freep(&config->hud_export_filename);
+    ngli_freep(&config->trace_filename);
     memset(config, 0, sizeof(*config));
 }
@@ -76,6 +76,7 @@ int ngpu_block_update(struct ngpu_block *s, size_t index, const void *data)
         ngpu_block_field_copy_count(field, dst + field->offset, src + offsets[i], field->count);
     }
     ngpu_buffer_unmap(s->buffer);
+    s->buffer->gpu_ctx->nb_uploaded_bytes += s->block_size;
 
     return 0;
 }
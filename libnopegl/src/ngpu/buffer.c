@@ -62,9 +62,28 @@ int ngpu_buffer_upload(struct ngpu_buffer *s, const void *data, size_t offset, s
     int ret = ngpu_buffer_wait(s);
     if (ret < 0)
         return ret;
+    s->gpu_ctx->nb_uploaded_bytes += size;
     return s->gpu_ctx->cls->buffer_upload(s, data, offset, size);
 }
 
+int ngpu_buffer_upload_unsynchronized(struct ngpu_buffer *s, const void *data, size_t offset, size_t size)
+{
+    const struct ngpu_ctx_class *cls = s->gpu_ctx->cls;
+    if (!cls->buffer_upload_unsynchronized)
+        return ngpu_buffer_upload(s, data, offset, size);
+    s->gpu_ctx->nb_uploaded_bytes += size;
+    return cls->buffer_upload_unsynchronized(s, data, offset, size);
+}
+
+int ngpu_buffer_replace(struct ngpu_buffer *s, const void *data)
+{
+    const struct ngpu_ctx_class *cls = s->gpu_ctx->cls;
+    if (!cls->buffer_replace)
+        return ngpu_buffer_upload(s, data, 0, s->size);
+    s->gpu_ctx->nb_uploaded_bytes += s->size;
+    return cls->buffer_replace(s, data);
+}
+
 int ngpu_buffer_map(struct ngpu_buffer *s, size_t offset, size_t size, void **datap)
 {
     int ret = ngpu_buffer_wait(s);
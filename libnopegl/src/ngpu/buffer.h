@@ -56,6 +56,19 @@ struct ngpu_buffer *ngpu_buffer_create(struct ngpu_ctx *gpu_ctx);
 int ngpu_buffer_init(struct ngpu_buffer *s, size_t size, uint32_t usage);
 int ngpu_buffer_wait(struct ngpu_buffer *s);
 int ngpu_buffer_upload(struct ngpu_buffer *s, const void *data, size_t offset, size_t size);
+
+/*
+ * Upload without waiting for the GPU: the caller guarantees the destination
+ * range is not accessed by any pending command (typically because it was last
+ * used nb_in_flight_frames ago)
+ */
+int ngpu_buffer_upload_unsynchronized(struct ngpu_buffer *s, const void *data, size_t offset, size_t size);
+
+/*
+ * Replace the whole content of the buffer; if the GPU is still using it, the
+ * backend may allocate a new storage (orphaning) instead of waiting
+ */
+int ngpu_buffer_replace(struct ngpu_buffer *s, const void *data);
 int ngpu_buffer_map(struct ngpu_buffer *s, size_t offset, size_t size, void **datap);
 void ngpu_buffer_unmap(struct ngpu_buffer *s);
 void ngpu_buffer_freep(struct ngpu_buffer **sp);
@@ -162,6 +162,18 @@ int ngpu_ctx_query_draw_time(struct ngpu_ctx *s, int64_t *time)
     return s->cls->query_draw_time(s, time);
 }
 
+void ngpu_ctx_write_timestamp(struct ngpu_ctx *s, uint32_t index)
+{
+    ngli_assert(index < NGPU_MAX_TIMESTAMP_QUERIES);
+    s->cls->write_timestamp(s, index);
+}
+
+int ngpu_ctx_query_timestamps(struct ngpu_ctx *s, uint32_t nb_timestamps, uint64_t *timestamps)
+{
+    ngli_assert(nb_timestamps <= NGPU_MAX_TIMESTAMP_QUERIES);
+    return s->cls->query_timestamps(s, nb_timestamps, timestamps);
+}
+
 void ngpu_ctx_wait_idle(struct ngpu_ctx *s)
 {
     s->cls->wait_idle(s);
@@ -267,6 +279,7 @@ void ngpu_ctx_generate_texture_mipmap(struct ngpu_ctx *s, struct ngpu_texture *t
 void ngpu_ctx_set_pipeline(struct ngpu_ctx *s, struct ngpu_pipeline *pipeline)
 {
     s->pipeline = pipeline;
+    s->nb_pipeline_binds++;
     s->cls->set_pipeline(s, pipeline);
 }
 
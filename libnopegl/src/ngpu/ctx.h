@@ -68,6 +68,8 @@ struct ngpu_ctx_class {
     int (*begin_draw)(struct ngpu_ctx *s);
     int (*end_draw)(struct ngpu_ctx *s, double t);
     int (*query_draw_time)(struct ngpu_ctx *s, int64_t *time);
+    void (*write_timestamp)(struct ngpu_ctx *s, uint32_t index);
+    int (*query_timestamps)(struct ngpu_ctx *s, uint32_t nb_timestamps, uint64_t *timestamps);
     void (*wait_idle)(struct ngpu_ctx *s);
     void (*destroy)(struct ngpu_ctx *s);
 
@@ -104,6 +106,8 @@ struct ngpu_ctx_class {
     int (*buffer_init)(struct ngpu_buffer *s);
     int (*buffer_wait)(struct ngpu_buffer *s);
     int (*buffer_upload)(struct ngpu_buffer *s, const void *data, size_t offset, size_t size);
+    int (*buffer_upload_unsynchronized)(struct ngpu_buffer *s, const void *data, size_t offset, size_t size);
+    int (*buffer_replace)(struct ngpu_buffer *s, const void *data);
     int (*buffer_map)(struct ngpu_buffer *s, size_t offset, size_t size, void **datap);
     void (*buffer_unmap)(struct ngpu_buffer *s);
     void (*buffer_freep)(struct ngpu_buffer **sp);
@@ -134,6 +138,7 @@ struct ngpu_ctx_class {
     int (*texture_init)(struct ngpu_texture *s, const struct ngpu_texture_params *params);
     int (*texture_upload)(struct ngpu_texture *s, const uint8_t *data, uint32_t linesize);
     int (*texture_upload_with_params)(struct ngpu_texture *s, const uint8_t *data, const struct ngpu_texture_transfer_params *transfer_params);
+    int (*texture_upload_from_buffer)(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, uint32_t linesize);
     int (*texture_generate_mipmap)(struct ngpu_texture *s);
     void (*texture_freep)(struct ngpu_texture **sp);
 };
@@ -166,6 +171,11 @@ struct ngpu_ctx {
     const struct ngpu_buffer *vertex_buffers[NGPU_MAX_VERTEX_BUFFERS];
     const struct ngpu_buffer *index_buffer;
     enum ngpu_format index_format;
+
+    /* Cumulative statistics */
+    uint64_t nb_uploaded_bytes;
+    uint64_t nb_pipeline_binds;
+    uint64_t nb_buffer_waits; /* CPU waits on a buffer still in use by the GPU */
 };
 
 struct ngpu_ctx *ngpu_ctx_create(const struct ngl_config *config);
@@ -180,6 +190,18 @@ int ngpu_ctx_end_update(struct ngpu_ctx *s);
 int ngpu_ctx_begin_draw(struct ngpu_ctx *s);
 int ngpu_ctx_end_draw(struct ngpu_ctx *s, double t);
 int ngpu_ctx_query_draw_time(struct ngpu_ctx *s, int64_t *time);
+
+/*
+ * Timestamp queries, only available when the context is configured with a
+ * trace file. ngpu_ctx_write_timestamp() records in the current command
+ * buffer the GPU time at which all the previously recorded commands have
+ * completed. ngpu_ctx_query_timestamps() submits the current command buffer,
+ * waits for its completion and reads back (in nanoseconds) the first
+ * nb_timestamps timestamps written since the beginning of the frame. Each
+ * index must be written at most once per frame.
+ */
+void ngpu_ctx_write_timestamp(struct ngpu_ctx *s, uint32_t index);
+int ngpu_ctx_query_timestamps(struct ngpu_ctx *s, uint32_t nb_timestamps, uint64_t *timestamps);
 void ngpu_ctx_wait_idle(struct ngpu_ctx *s);
 void ngpu_ctx_freep(struct ngpu_ctx **sp);
 
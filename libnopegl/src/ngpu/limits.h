@@ -34,6 +34,8 @@
 
 #define NGPU_MAX_COLOR_ATTACHMENTS 8
 
+#define NGPU_MAX_TIMESTAMP_QUERIES 1024
+
 struct ngpu_limits {
     uint32_t max_vertex_attributes;
     uint32_t max_texture_image_units;
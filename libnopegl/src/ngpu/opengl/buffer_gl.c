@@ -106,9 +106,11 @@ int ngpu_buffer_gl_init(struct ngpu_buffer *s)
     if (gl->features & NGLI_FEATURE_GL_BUFFER_STORAGE) {
         const GLbitfield storage_flags = GL_DYNAMIC_STORAGE_BIT;
         gl->funcs.BufferStorage(GL_ARRAY_BUFFER, size, NULL, storage_flags | s_priv->map_flags);
+        s_priv->immutable = 1;
     } else if (gl->features & NGLI_FEATURE_GL_EXT_BUFFER_STORAGE) {
         const GLbitfield storage_flags = GL_DYNAMIC_STORAGE_BIT;
         gl->funcs.BufferStorageEXT(GL_ARRAY_BUFFER, size, NULL, storage_flags | s_priv->map_flags);
+        s_priv->immutable = 1;
     } else {
         ngli_assert(!NGLI_HAS_ALL_FLAGS(s->usage, NGPU_BUFFER_USAGE_MAP_PERSISTENT));
         gl->funcs.BufferData(GL_ARRAY_BUFFER, size, NULL, get_gl_usage(s->usage));
@@ -117,10 +119,26 @@ int ngpu_buffer_gl_init(struct ngpu_buffer *s)
     return 0;
 }
 
+static int buffer_gl_is_in_use(struct ngpu_buffer *s)
+{
+    struct ngpu_buffer_gl *s_priv = (struct ngpu_buffer_gl *)s;
+
+    struct ngpu_cmd_buffer_gl **cmd_buffers = ngli_darray_data(&s_priv->cmd_buffers);
+    for (size_t i = 0; i < ngli_darray_count(&s_priv->cmd_buffers); i++) {
+        if (ngpu_cmd_buffer_gl_is_pending(cmd_buffers[i]))
+            return 1;
+    }
+
+    return 0;
+}
+
 int ngpu_buffer_gl_wait(struct ngpu_buffer *s)
 {
     struct ngpu_buffer_gl *s_priv = (struct ngpu_buffer_gl *)s;
 
+    if (buffer_gl_is_in_use(s))
+        s->gpu_ctx->nb_buffer_waits++;
+
     struct ngpu_cmd_buffer_gl **cmd_buffers = ngli_darray_data(&s_priv->cmd_buffers);
     for (size_t i = 0; i < ngli_darray_count(&s_priv->cmd_buffers); i++) {
         struct ngpu_cmd_buffer_gl *cmd_buffer = cmd_buffers[i];
@@ -141,6 +159,59 @@ int ngpu_buffer_gl_upload(struct ngpu_buffer *s, const void *data, size_t offset
     return 0;
 }
 
+int ngpu_buffer_gl_upload_unsynchronized(struct ngpu_buffer *s, const void *data, size_t offset, size_t size)
+{
+    struct ngpu_ctx_gl *gpu_ctx_gl = (struct ngpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    const struct ngpu_buffer_gl *s_priv = (struct ngpu_buffer_gl *)s;
+
+    /*
+     * glBufferSubData() may block until the GPU is done with the buffer, so
+     * an unsynchronized mapping is preferred when the buffer can be mapped
+     * (a persistent buffer is already mapped by its user)
+     */
+    if (!(s_priv->map_flags & GL_MAP_WRITE_BIT) || (s->usage & NGPU_BUFFER_USAGE_MAP_PERSISTENT))
+        return ngpu_buffer_gl_upload(s, data, offset, size);
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+    gl->funcs.BindBuffer(GL_ARRAY_BUFFER, s_priv->id);
+    void *dst = gl->funcs.MapBufferRange(GL_ARRAY_BUFFER, (GLintptr)offset, (GLsizeiptr)size, flags);
+    if (!dst)
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    memcpy(dst, data, size);
+    gl->funcs.UnmapBuffer(GL_ARRAY_BUFFER);
+    return 0;
+}
+
+int ngpu_buffer_gl_replace(struct ngpu_buffer *s, const void *data)
+{
+    struct ngpu_ctx_gl *gpu_ctx_gl = (struct ngpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    struct ngpu_buffer_gl *s_priv = (struct ngpu_buffer_gl *)s;
+
+    if (!buffer_gl_is_in_use(s))
+        return ngpu_buffer_gl_upload(s, data, 0, s->size);
+
+    /* Immutable storage cannot be orphaned, we have to wait for the GPU */
+    if (s_priv->immutable) {
+        int ret = ngpu_buffer_gl_wait(s);
+        if (ret < 0)
+            return ret;
+        return ngpu_buffer_gl_upload(s, data, 0, s->size);
+    }
+
+    /*
+     * Orphan the current storage: the driver keeps it alive for the pending
+     * commands and allocates a new one, so there is nothing to wait for
+     * anymore
+     */
+    gl->funcs.BindBuffer(GL_ARRAY_BUFFER, s_priv->id);
+    gl->funcs.BufferData(GL_ARRAY_BUFFER, (GLsizeiptr)s->size, data, get_gl_usage(s->usage));
+    ngli_darray_clear(&s_priv->cmd_buffers);
+
+    return 0;
+}
+
 int ngpu_buffer_gl_map(struct ngpu_buffer *s, size_t offset, size_t size, void **datap)
 {
     struct ngpu_ctx_gl *gpu_ctx_gl = (struct ngpu_ctx_gl *)s->gpu_ctx;
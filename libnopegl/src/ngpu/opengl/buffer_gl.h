@@ -33,6 +33,7 @@ struct ngpu_buffer_gl {
     GLuint id;
     GLbitfield map_flags;
     GLbitfield barriers;
+    int immutable;
     struct darray cmd_buffers;
 };
 
@@ -43,6 +44,8 @@ int ngpu_buffer_gl_init(struct ngpu_buffer *s);
 int ngpu_buffer_gl_wait(struct ngpu_buffer *s);
 int ngpu_buffer_gl_add_wait_fence(struct ngpu_buffer *s, GLsync fence);
 int ngpu_buffer_gl_upload(struct ngpu_buffer *s, const void *data, size_t offset, size_t size);
+int ngpu_buffer_gl_upload_unsynchronized(struct ngpu_buffer *s, const void *data, size_t offset, size_t size);
+int ngpu_buffer_gl_replace(struct ngpu_buffer *s, const void *data);
 int ngpu_buffer_gl_map(struct ngpu_buffer *s, size_t offset, size_t size, void **datap);
 void ngpu_buffer_gl_unmap(struct ngpu_buffer *s);
 int ngpu_buffer_gl_ref_cmd_buffer(struct ngpu_buffer *s, struct ngpu_cmd_buffer_gl *cmd_buffer);
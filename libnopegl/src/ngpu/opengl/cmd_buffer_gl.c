@@ -187,6 +187,11 @@ int ngpu_cmd_buffer_gl_submit(struct ngpu_cmd_buffer_gl *s)
             ngpu_texture_generate_mipmap(cmd->generate_texture_mipmap.texture);
             break;
         }
+        case NGPU_CMD_TYPE_GL_WRITE_TIMESTAMP: {
+            const GLuint query = gpu_ctx_gl->timestamp_queries[cmd->write_timestamp.index];
+            gpu_ctx_gl->glQueryCounter(query, GL_TIMESTAMP);
+            break;
+        }
         case NGPU_CMD_TYPE_GL_SET_PIPELINE: {
             cur_pipeline = cmd->set_pipeline.pipeline;
             break;
@@ -235,6 +240,12 @@ int ngpu_cmd_buffer_gl_submit(struct ngpu_cmd_buffer_gl *s)
     return 0;
 }
 
+int ngpu_cmd_buffer_gl_is_pending(struct ngpu_cmd_buffer_gl *s)
+{
+    /* Only submitted command buffers hold a fence */
+    return s->fence && !ngpu_fence_gl_is_signaled(s->fence);
+}
+
 int ngpu_cmd_buffer_gl_wait(struct ngpu_cmd_buffer_gl *s)
 {
     if (s->fence == NULL) {
@@ -43,6 +43,7 @@ enum ngpu_cmd_type_gl {
     NGPU_CMD_TYPE_GL_SET_VERTEX_BUFFER,
     NGPU_CMD_TYPE_GL_SET_INDEX_BUFFER,
     NGPU_CMD_TYPE_GL_GENERATE_TEXTURE_MIPMAP,
+    NGPU_CMD_TYPE_GL_WRITE_TIMESTAMP,
     NGPU_CMD_TYPE_GL_MAX_ENUM = 0x7FFFFFFF
 };
 
@@ -101,6 +102,10 @@ struct ngpu_cmd_gl {
         struct {
             struct ngpu_texture *texture;
         } generate_texture_mipmap;
+
+        struct {
+            uint32_t index;
+        } write_timestamp;
     };
 };
 
@@ -118,5 +123,6 @@ int ngpu_cmd_buffer_gl_begin(struct ngpu_cmd_buffer_gl *s);
 int ngpu_cmd_buffer_gl_push(struct ngpu_cmd_buffer_gl *s, const struct ngpu_cmd_gl *cmd);
 int ngpu_cmd_buffer_gl_submit(struct ngpu_cmd_buffer_gl *s);
 int ngpu_cmd_buffer_gl_wait(struct ngpu_cmd_buffer_gl *s);
+int ngpu_cmd_buffer_gl_is_pending(struct ngpu_cmd_buffer_gl *s);
 
 #endif
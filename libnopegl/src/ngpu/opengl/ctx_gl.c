@@ -370,6 +370,15 @@ static int timer_init(struct ngpu_ctx *s)
     }
     s_priv->glGenQueries(2, s_priv->queries);
 
+#if !defined(TARGET_DARWIN)
+    const struct ngl_config *config = &s->config;
+    if (config->trace_filename &&
+        (gl->features & (NGLI_FEATURE_GL_TIMER_QUERY | NGLI_FEATURE_GL_EXT_DISJOINT_TIMER_QUERY))) {
+        s_priv->glGenQueries(NGPU_MAX_TIMESTAMP_QUERIES, s_priv->timestamp_queries);
+        s_priv->has_timestamp_queries = 1;
+    }
+#endif
+
     return 0;
 }
 
@@ -379,6 +388,11 @@ static void timer_reset(struct ngpu_ctx *s)
 
     if (s_priv->glDeleteQueries)
         s_priv->glDeleteQueries(2, s_priv->queries);
+
+    if (s_priv->has_timestamp_queries) {
+        s_priv->glDeleteQueries(NGPU_MAX_TIMESTAMP_QUERIES, s_priv->timestamp_queries);
+        s_priv->has_timestamp_queries = 0;
+    }
 }
 
 static struct ngpu_ctx *gl_create(const struct ngl_config *config)
@@ -868,12 +882,24 @@ static int gl_begin_update(struct ngpu_ctx *s)
 {
     struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
 
-    s_priv->cur_cmd_buffer = s_priv->update_cmd_buffers[s->current_frame_index];
-    int ret = ngpu_cmd_buffer_gl_wait(s_priv->cur_cmd_buffer);
-    if (ret < 0)
-        return ret;
+    /*
+     * Wait for both command buffers of the frame previously associated with
+     * this frame index: the resources indexed by the frame index (such as the
+     * multi-buffered blocks and the media upload buffers) can then be written
+     * during the update and draw without synchronization
+     */
+    struct ngpu_cmd_buffer_gl *cmd_buffers[] = {
+        s_priv->update_cmd_buffers[s->current_frame_index],
+        s_priv->draw_cmd_buffers[s->current_frame_index],
+    };
+    for (size_t i = 0; i < NGLI_ARRAY_NB(cmd_buffers); i++) {
+        int ret = ngpu_cmd_buffer_gl_wait(cmd_buffers[i]);
+        if (ret < 0)
+            return ret;
+    }
 
-    ret = ngpu_cmd_buffer_gl_begin(s_priv->cur_cmd_buffer);
+    s_priv->cur_cmd_buffer = s_priv->update_cmd_buffers[s->current_frame_index];
+    int ret = ngpu_cmd_buffer_gl_begin(s_priv->cur_cmd_buffer);
     if (ret < 0)
         return ret;
 
@@ -896,7 +922,7 @@ static int gl_begin_draw(struct ngpu_ctx *s)
     struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
     const struct ngl_config *config = &s->config;
 
-    if (config->hud)
+    if (config->hud || config->dynamic_resolution_budget > 0.f)
 #if defined(TARGET_DARWIN)
         s_priv->glBeginQuery(GL_TIME_ELAPSED, s_priv->queries[0]);
 #else
@@ -975,7 +1001,7 @@ static int gl_query_draw_time(struct ngpu_ctx *s, int64_t *time)
     struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
 
     const struct ngl_config *config = &s->config;
-    if (!config->hud)
+    if (!config->hud && config->dynamic_resolution_budget <= 0.f)
         return NGL_ERROR_INVALID_USAGE;
 
     struct ngpu_cmd_buffer_gl *cmd_buffer = s_priv->cur_cmd_buffer;
@@ -1007,6 +1033,47 @@ static int gl_query_draw_time(struct ngpu_ctx *s, int64_t *time)
     return 0;
 }
 
+static void gl_write_timestamp(struct ngpu_ctx *s, uint32_t index)
+{
+    struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
+
+    struct ngpu_cmd_buffer_gl *cmd_buffer = s_priv->cur_cmd_buffer;
+
+    if (!s_priv->has_timestamp_queries)
+        return;
+
+    ngpu_cmd_buffer_gl_push(cmd_buffer, &(struct ngpu_cmd_gl){
+                                            .type = NGPU_CMD_TYPE_GL_WRITE_TIMESTAMP,
+                                            .write_timestamp.index = index,
+                                        });
+}
+
+static int gl_query_timestamps(struct ngpu_ctx *s, uint32_t nb_timestamps, uint64_t *timestamps)
+{
+    struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
+
+    if (!s_priv->has_timestamp_queries)
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+
+    struct ngpu_cmd_buffer_gl *cmd_buffer = s_priv->cur_cmd_buffer;
+
+    int ret = ngpu_cmd_buffer_gl_submit(cmd_buffer);
+    if (ret < 0)
+        return ret;
+
+    for (uint32_t i = 0; i < nb_timestamps; i++) {
+        GLuint64 timestamp = 0;
+        s_priv->glGetQueryObjectui64v(s_priv->timestamp_queries[i], GL_QUERY_RESULT, &timestamp);
+        timestamps[i] = (uint64_t)timestamp;
+    }
+
+    ret = ngpu_cmd_buffer_gl_begin(cmd_buffer);
+    if (ret < 0)
+        return ret;
+
+    return 0;
+}
+
 static void gl_wait_idle(struct ngpu_ctx *s)
 {
     struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
@@ -1270,6 +1337,8 @@ const struct ngpu_ctx_class ngpu_ctx_##cls_suffix = {
     .begin_draw                         = gl_begin_draw,                         \
     .end_draw                           = gl_end_draw,                           \
     .query_draw_time                    = gl_query_draw_time,                    \
+    .write_timestamp                    = gl_write_timestamp,                    \
+    .query_timestamps                   = gl_query_timestamps,                   \
     .wait_idle                          = gl_wait_idle,                          \
     .destroy                            = gl_destroy,                            \
                                                                                  \
@@ -1307,6 +1376,8 @@ const struct ngpu_ctx_class ngpu_ctx_##cls_suffix = {
     .buffer_init                        = ngpu_buffer_gl_init,                   \
     .buffer_wait                        = ngpu_buffer_gl_wait,                   \
     .buffer_upload                      = ngpu_buffer_gl_upload,                 \
+    .buffer_upload_unsynchronized       = ngpu_buffer_gl_upload_unsynchronized,  \
+    .buffer_replace                     = ngpu_buffer_gl_replace,                \
     .buffer_map                         = ngpu_buffer_gl_map,                    \
     .buffer_unmap                       = ngpu_buffer_gl_unmap,                  \
     .buffer_freep                       = ngpu_buffer_gl_freep,                  \
@@ -1337,6 +1408,7 @@ const struct ngpu_ctx_class ngpu_ctx_##cls_suffix = {
     .texture_init                       = ngpu_texture_gl_init,                  \
     .texture_upload                     = ngpu_texture_gl_upload,                \
     .texture_upload_with_params         = ngpu_texture_gl_upload_with_params,    \
+    .texture_upload_from_buffer         = ngpu_texture_gl_upload_from_buffer,    \
     .texture_generate_mipmap            = ngpu_texture_gl_generate_mipmap,       \
     .texture_freep                      = ngpu_texture_gl_freep,                 \
 }                                                                                \
@@ -67,6 +67,9 @@ struct ngpu_ctx_gl {
 #endif
     /* Timer */
     GLuint queries[2];
+    /* Timestamp queries used by the trace, only allocated if supported */
+    GLuint timestamp_queries[NGPU_MAX_TIMESTAMP_QUERIES];
+    int has_timestamp_queries;
     void (NGLI_GL_APIENTRY *glGenQueries)(GLsizei n, GLuint * ids);
     void (NGLI_GL_APIENTRY *glDeleteQueries)(GLsizei n, const GLuint *ids);
     void (NGLI_GL_APIENTRY *glBeginQuery)(GLenum target, GLuint id);
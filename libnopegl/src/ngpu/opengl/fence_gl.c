@@ -82,6 +82,18 @@ int ngpu_fence_gl_wait(struct ngpu_fence_gl *s)
     return 0;
 }
 
+int ngpu_fence_gl_is_signaled(struct ngpu_fence_gl *s)
+{
+    struct ngpu_ctx_gl *gpu_ctx_gl = (struct ngpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    if (s->fence == 0)
+        return 1;
+
+    const GLenum ret = gl->funcs.ClientWaitSync(s->fence, 0, 0);
+    return ret == GL_ALREADY_SIGNALED || ret == GL_CONDITION_SATISFIED;
+}
+
 void ngpu_fence_gl_freep(struct ngpu_fence_gl **sp)
 {
     NGLI_RC_UNREFP(sp);
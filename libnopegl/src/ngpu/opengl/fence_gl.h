@@ -37,6 +37,7 @@ NGLI_RC_CHECK_STRUCT(ngpu_fence_gl);
 
 struct ngpu_fence_gl *ngpu_fence_gl_create(struct ngpu_ctx *ctx);
 int ngpu_fence_gl_wait(struct ngpu_fence_gl *s);
+int ngpu_fence_gl_is_signaled(struct ngpu_fence_gl *s);
 void ngpu_fence_gl_freep(struct ngpu_fence_gl **sp);
 
 #endif
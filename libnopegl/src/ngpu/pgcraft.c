@@ -579,7 +579,8 @@ static int inject_block(struct ngpu_pgcraft *s, struct bstr *b,
         ngli_bstr_printf(b, "layout(%s)", layout);
     }
 
-    if (named_block->type == NGPU_TYPE_STORAGE_BUFFER && !named_block->writable)
+    if ((named_block->type == NGPU_TYPE_STORAGE_BUFFER ||
+         named_block->type == NGPU_TYPE_STORAGE_BUFFER_DYNAMIC) && !named_block->writable)
         ngli_bstr_print(b, " readonly");
 
     const char *keyword = get_glsl_type(named_block->type);
@@ -717,7 +718,9 @@ static int params_have_ssbos(struct ngpu_pgcraft *s, const struct ngpu_pgcraft_p
 {
     for (size_t i = 0; i < params->nb_blocks; i++) {
         const struct ngpu_pgcraft_block *pgcraft_block = &params->blocks[i];
-        if (pgcraft_block->stage == stage && pgcraft_block->type == NGPU_TYPE_STORAGE_BUFFER)
+        if (pgcraft_block->stage == stage &&
+            (pgcraft_block->type == NGPU_TYPE_STORAGE_BUFFER ||
+             pgcraft_block->type == NGPU_TYPE_STORAGE_BUFFER_DYNAMIC))
             return 1;
     }
     return 0;
@@ -21,6 +21,8 @@
 
 #include "texture.h"
 #include "ctx.h"
+#include "format.h"
+#include "utils/utils.h"
 
 static void texture_freep(void **texturep)
 {
@@ -45,16 +47,41 @@ int ngpu_texture_init(struct ngpu_texture *s, const struct ngpu_texture_params *
     return s->gpu_ctx->cls->texture_init(s, params);
 }
 
+static void count_uploaded_bytes(struct ngpu_texture *s, uint32_t width, uint32_t height, uint32_t nb_slices)
+{
+    const size_t bytes_per_pixel = ngpu_format_get_bytes_per_pixel(s->params.format);
+    s->gpu_ctx->nb_uploaded_bytes += (uint64_t)width * height * NGLI_MAX(nb_slices, 1) * bytes_per_pixel;
+}
+
 int ngpu_texture_upload(struct ngpu_texture *s, const uint8_t *data, uint32_t linesize)
 {
+    if (data) {
+        const struct ngpu_texture_params *params = &s->params;
+        const uint32_t nb_slices = params->type == NGPU_TEXTURE_TYPE_CUBE ? 6 : params->depth;
+        count_uploaded_bytes(s, params->width, params->height, nb_slices);
+    }
     return s->gpu_ctx->cls->texture_upload(s, data, linesize);
 }
 
 int ngpu_texture_upload_with_params(struct ngpu_texture *s, const uint8_t *data, const struct ngpu_texture_transfer_params *transfer_params)
 {
+    if (data) {
+        const uint32_t nb_slices = s->params.type == NGPU_TEXTURE_TYPE_3D ? transfer_params->depth
+                                                                           : transfer_params->layer_count;
+        count_uploaded_bytes(s, transfer_params->width, transfer_params->height, nb_slices);
+    }
     return s->gpu_ctx->cls->texture_upload_with_params(s, data, transfer_params);
 }
 
+int ngpu_texture_upload_from_buffer(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, uint32_t linesize)
+{
+    /* The buffer content is written by the CPU before it is copied to the texture */
+    const struct ngpu_texture_params *params = &s->params;
+    const uint32_t nb_slices = params->type == NGPU_TEXTURE_TYPE_CUBE ? 6 : params->depth;
+    count_uploaded_bytes(s, params->width, params->height, nb_slices);
+    return s->gpu_ctx->cls->texture_upload_from_buffer(s, buffer, offset, linesize);
+}
+
 int ngpu_texture_generate_mipmap(struct ngpu_texture *s)
 {
     return s->gpu_ctx->cls->texture_generate_mipmap(s);
@@ -27,6 +27,7 @@
 #include "utils/utils.h"
 #include "utils/refcount.h"
 
+struct ngpu_buffer;
 struct ngpu_ctx;
 
 enum ngpu_mipmap_filter {
@@ -107,6 +108,7 @@ struct ngpu_texture *ngpu_texture_create(struct ngpu_ctx *gpu_ctx);
 int ngpu_texture_init(struct ngpu_texture *s, const struct ngpu_texture_params *params);
 int ngpu_texture_upload(struct ngpu_texture *s, const uint8_t *data, uint32_t linesize);
 int ngpu_texture_upload_with_params(struct ngpu_texture *s, const uint8_t *data, const struct ngpu_texture_transfer_params *transfer_params);
+int ngpu_texture_upload_from_buffer(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, uint32_t linesize);
 int ngpu_texture_generate_mipmap(struct ngpu_texture *s);
 void ngpu_texture_freep(struct ngpu_texture **sp);
 
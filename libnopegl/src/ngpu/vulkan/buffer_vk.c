@@ -151,11 +151,15 @@ int ngpu_buffer_vk_wait(struct ngpu_buffer *s)
 {
     struct ngpu_buffer_vk *s_priv = (struct ngpu_buffer_vk *)s;
 
+    int in_use = 0;
     struct ngpu_cmd_buffer_vk **cmd_buffers = ngli_darray_data(&s_priv->cmd_buffers);
     for (size_t i = 0; i < ngli_darray_count(&s_priv->cmd_buffers); i++) {
         struct ngpu_cmd_buffer_vk *cmd_buffer = cmd_buffers[i];
+        in_use |= cmd_buffer->submitted;
         ngpu_cmd_buffer_vk_wait(cmd_buffer);
     }
+    if (in_use)
+        s->gpu_ctx->nb_buffer_waits++;
     ngli_darray_clear(&s_priv->cmd_buffers);
 
     return 0;
@@ -226,6 +230,25 @@ int ngpu_buffer_vk_upload(struct ngpu_buffer *s, const void *data, size_t offset
     return ngli_vk_res2ret(res);
 }
 
+int ngpu_buffer_vk_upload_unsynchronized(struct ngpu_buffer *s, const void *data, size_t offset, size_t size)
+{
+    /*
+     * Host visible memory is written directly through a mapping, which does
+     * not need to wait for the GPU. Device local memory is written with a
+     * transfer that is submitted before the commands already recorded for the
+     * current frame, so it needs the regular synchronized upload.
+     */
+    if (!(s->usage & NGPU_BUFFER_USAGE_MAP_READ) &&
+        !(s->usage & NGPU_BUFFER_USAGE_MAP_WRITE) &&
+        !(s->usage & NGPU_BUFFER_USAGE_DYNAMIC_BIT)) {
+        int ret = ngpu_buffer_vk_wait(s);
+        if (ret < 0)
+            return ret;
+    }
+
+    return ngpu_buffer_vk_upload(s, data, offset, size);
+}
+
 static VkResult buffer_vk_map(struct ngpu_buffer *s, size_t offset, size_t size, void **data)
 {
     struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)s->gpu_ctx;
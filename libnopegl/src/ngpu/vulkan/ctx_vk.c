@@ -296,15 +296,26 @@ static void destroy_render_resources(struct ngpu_ctx *s)
     ngpu_buffer_freep(&s_priv->capture_buffer);
 }
 
+/*
+ * The first two queries are used to measure the draw time reported by the
+ * HUD, the following ones are the trace timestamps (if enabled)
+ */
+#define TIMESTAMP_QUERIES_OFFSET 2
+
 static VkResult create_query_pool(struct ngpu_ctx *s)
 {
     struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
     struct vkcontext *vk = s_priv->vkcontext;
+    const struct ngl_config *config = &s->config;
+
+    s_priv->nb_queries = TIMESTAMP_QUERIES_OFFSET;
+    if (config->trace_filename)
+        s_priv->nb_queries += NGPU_MAX_TIMESTAMP_QUERIES;
 
     const VkQueryPoolCreateInfo create_info = {
         .sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
         .queryType  = VK_QUERY_TYPE_TIMESTAMP,
-        .queryCount = 2,
+        .queryCount = s_priv->nb_queries,
     };
 
     return vkCreateQueryPool(vk->device, &create_info, NULL, &s_priv->query_pool);
@@ -318,6 +329,26 @@ static void destroy_query_pool(struct ngpu_ctx *s)
     vkDestroyQueryPool(vk->device, s_priv->query_pool, NULL);
 }
 
+static VkResult create_pipeline_cache(struct ngpu_ctx *s)
+{
+    struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+
+    const VkPipelineCacheCreateInfo create_info = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+    };
+
+    return vkCreatePipelineCache(vk->device, &create_info, NULL, &s_priv->pipeline_cache);
+}
+
+static void destroy_pipeline_cache(struct ngpu_ctx *s)
+{
+    struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+
+    vkDestroyPipelineCache(vk->device, s_priv->pipeline_cache, NULL);
+}
+
 static VkResult create_command_pool_and_buffers(struct ngpu_ctx *s)
 {
     struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
@@ -923,6 +954,10 @@ static int vk_init(struct ngpu_ctx *s)
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
 
+    res = create_pipeline_cache(s);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
     res = create_semaphores(s);
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
@@ -1104,10 +1139,11 @@ static int vk_begin_draw(struct ngpu_ctx *s)
         s_priv->default_rt_load->height = s_priv->height;
     }
 
-    if (config->hud) {
-        vkCmdResetQueryPool(s_priv->cur_cmd_buffer->cmd_buf, s_priv->query_pool, 0, 2);
+    if (config->hud || config->dynamic_resolution_budget > 0.f || config->trace_filename)
+        vkCmdResetQueryPool(s_priv->cur_cmd_buffer->cmd_buf, s_priv->query_pool, 0, s_priv->nb_queries);
+
+    if (config->hud || config->dynamic_resolution_budget > 0.f)
         vkCmdWriteTimestamp(s_priv->cur_cmd_buffer->cmd_buf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, s_priv->query_pool, 0);
-    }
 
     return 0;
 }
@@ -1118,7 +1154,7 @@ static int vk_query_draw_time(struct ngpu_ctx *s, int64_t *time)
     struct vkcontext *vk = s_priv->vkcontext;
     const struct ngl_config *config = &s->config;
 
-    if (!config->hud)
+    if (!config->hud && config->dynamic_resolution_budget <= 0.f)
         return NGL_ERROR_INVALID_USAGE;
 
     ngli_assert(s_priv->cur_cmd_buffer->cmd_buf);
@@ -1148,6 +1184,58 @@ static int vk_query_draw_time(struct ngpu_ctx *s, int64_t *time)
     return 0;
 }
 
+static void vk_write_timestamp(struct ngpu_ctx *s, uint32_t index)
+{
+    struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
+    const struct ngl_config *config = &s->config;
+
+    if (!config->trace_filename)
+        return;
+
+    ngli_assert(s_priv->cur_cmd_buffer->cmd_buf);
+    VkCommandBuffer cmd_buf = s_priv->cur_cmd_buffer->cmd_buf;
+    vkCmdWriteTimestamp(cmd_buf, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, s_priv->query_pool,
+                        TIMESTAMP_QUERIES_OFFSET + index);
+}
+
+static int vk_query_timestamps(struct ngpu_ctx *s, uint32_t nb_timestamps, uint64_t *timestamps)
+{
+    struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+    const struct ngl_config *config = &s->config;
+
+    if (!config->trace_filename)
+        return NGL_ERROR_INVALID_USAGE;
+
+    VkResult res = ngpu_cmd_buffer_vk_submit(s_priv->cur_cmd_buffer);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    res = ngpu_cmd_buffer_vk_wait(s_priv->cur_cmd_buffer);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    if (nb_timestamps) {
+        res = vkGetQueryPoolResults(vk->device,
+                                    s_priv->query_pool, TIMESTAMP_QUERIES_OFFSET, nb_timestamps,
+                                    nb_timestamps * sizeof(*timestamps), timestamps, sizeof(*timestamps),
+                                    VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        if (res != VK_SUCCESS)
+            return ngli_vk_res2ret(res);
+
+        /* Convert the timestamps from GPU ticks to nanoseconds */
+        const double period = vk->phy_device_props.limits.timestampPeriod;
+        for (uint32_t i = 0; i < nb_timestamps; i++)
+            timestamps[i] = (uint64_t)((double)timestamps[i] * period);
+    }
+
+    res = ngpu_cmd_buffer_vk_begin(s_priv->cur_cmd_buffer);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    return 0;
+}
+
 static int vk_end_draw(struct ngpu_ctx *s, double t)
 {
     const struct ngl_config *config = &s->config;
@@ -1212,6 +1300,7 @@ static void vk_destroy(struct ngpu_ctx *s)
     destroy_render_resources(s);
     destroy_swapchain(s);
     destroy_query_pool(s);
+    destroy_pipeline_cache(s);
 
     ngli_glslang_uninit();
 
@@ -1519,6 +1608,8 @@ const struct ngpu_ctx_class ngpu_ctx_vk = {
     .end_update                         = vk_end_update,
     .begin_draw                         = vk_begin_draw,
     .query_draw_time                    = vk_query_draw_time,
+    .write_timestamp                    = vk_write_timestamp,
+    .query_timestamps                   = vk_query_timestamps,
     .end_draw                           = vk_end_draw,
     .wait_idle                          = vk_wait_idle,
     .destroy                            = vk_destroy,
@@ -1557,6 +1648,7 @@ const struct ngpu_ctx_class ngpu_ctx_vk = {
     .buffer_init                        = ngpu_buffer_vk_init,
     .buffer_wait                        = ngpu_buffer_vk_wait,
     .buffer_upload                      = ngpu_buffer_vk_upload,
+    .buffer_upload_unsynchronized       = ngpu_buffer_vk_upload_unsynchronized,
     .buffer_map                         = ngpu_buffer_vk_map,
     .buffer_unmap                       = ngpu_buffer_vk_unmap,
     .buffer_freep                       = ngpu_buffer_vk_freep,
@@ -1587,6 +1679,7 @@ const struct ngpu_ctx_class ngpu_ctx_vk = {
     .texture_init                       = ngpu_texture_vk_init,
     .texture_upload                     = ngpu_texture_vk_upload,
     .texture_upload_with_params         = ngpu_texture_vk_upload_with_params,
+    .texture_upload_from_buffer         = ngpu_texture_vk_upload_from_buffer,
     .texture_generate_mipmap            = ngpu_texture_vk_generate_mipmap,
     .texture_freep                      = ngpu_texture_vk_freep,
 };
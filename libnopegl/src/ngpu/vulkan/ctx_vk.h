@@ -44,6 +44,16 @@ struct ngpu_ctx_vk {
     int cur_cmd_buffer_is_transient;
 
     VkQueryPool query_pool;
+    uint32_t nb_queries;
+
+    /*
+     * Pipeline cache shared by every pipeline created with this context.
+     * RenderToTexture and blending produce several pipelines from the same
+     * program that only differ by their graphics state or render target
+     * layout; the cache allows the driver to reuse the compiled shader
+     * stages across all these variants.
+     */
+    VkPipelineCache pipeline_cache;
 
     VkSurfaceCapabilitiesKHR surface_caps;
     VkSurfaceFormatKHR surface_format;
@@ -245,18 +245,12 @@ static VkResult pipeline_graphics_init(struct ngpu_pipeline *s)
             .passOp      = get_vk_stencil_op(state->stencil_front.depth_pass),
             .depthFailOp = get_vk_stencil_op(state->stencil_front.depth_fail),
             .compareOp   = get_vk_compare_op(state->stencil_front.func),
-            .compareMask = state->stencil_front.read_mask,
-            .writeMask   = state->stencil_front.write_mask,
-            .reference   = state->stencil_front.ref,
         },
         .back = {
             .failOp      = get_vk_stencil_op(state->stencil_back.fail),
             .passOp      = get_vk_stencil_op(state->stencil_back.depth_pass),
             .depthFailOp = get_vk_stencil_op(state->stencil_back.depth_fail),
             .compareOp   = get_vk_compare_op(state->stencil_back.func),
-            .compareMask = state->stencil_back.read_mask,
-            .writeMask   = state->stencil_back.write_mask,
-            .reference   = state->stencil_back.ref,
         },
         .minDepthBounds = 0.0f,
         .maxDepthBounds = 0.0f,
@@ -282,10 +276,18 @@ static VkResult pipeline_graphics_init(struct ngpu_pipeline *s)
         .pAttachments    = colorblend_attachment_states,
     };
 
+    /*
+     * The stencil masks and reference are set dynamically (see
+     * set_dynamic_stencil_state()) so pipelines only differing by these values
+     * share the same state from the pipeline cache point of view.
+     */
     const VkDynamicState dynamic_states[] = {
         VK_DYNAMIC_STATE_VIEWPORT,
         VK_DYNAMIC_STATE_SCISSOR,
         VK_DYNAMIC_STATE_LINE_WIDTH,
+        VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK,
+        VK_DYNAMIC_STATE_STENCIL_WRITE_MASK,
+        VK_DYNAMIC_STATE_STENCIL_REFERENCE,
     };
 
     const VkPipelineDynamicStateCreateInfo dynamic_state_create_info = {
@@ -330,7 +332,7 @@ static VkResult pipeline_graphics_init(struct ngpu_pipeline *s)
         .renderPass          = render_pass,
         .subpass             = 0,
     };
-    res = vkCreateGraphicsPipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
+    res = vkCreateGraphicsPipelines(vk->device, gpu_ctx_vk->pipeline_cache, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
 
     vkDestroyRenderPass(vk->device, render_pass, NULL);
 
@@ -359,7 +361,7 @@ static VkResult pipeline_compute_init(struct ngpu_pipeline *s)
         .layout = s_priv->pipeline_layout,
     };
 
-    return vkCreateComputePipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
+    return vkCreateComputePipelines(vk->device, gpu_ctx_vk->pipeline_cache, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
 }
 
 static VkResult create_pipeline_layout(struct ngpu_pipeline *s)
@@ -451,11 +453,26 @@ static int prepare_and_bind_descriptor_set(struct ngpu_pipeline *s, VkCommandBuf
     return 0;
 }
 
+static void set_dynamic_stencil_state(struct ngpu_pipeline *s, VkCommandBuffer cmd_buf)
+{
+    const struct ngpu_graphics_state *state = &s->graphics.state;
+    const struct ngpu_stencil_op_state *front = &state->stencil_front;
+    const struct ngpu_stencil_op_state *back = &state->stencil_back;
+
+    vkCmdSetStencilCompareMask(cmd_buf, VK_STENCIL_FACE_FRONT_BIT, front->read_mask);
+    vkCmdSetStencilCompareMask(cmd_buf, VK_STENCIL_FACE_BACK_BIT, back->read_mask);
+    vkCmdSetStencilWriteMask(cmd_buf, VK_STENCIL_FACE_FRONT_BIT, front->write_mask);
+    vkCmdSetStencilWriteMask(cmd_buf, VK_STENCIL_FACE_BACK_BIT, back->write_mask);
+    vkCmdSetStencilReference(cmd_buf, VK_STENCIL_FACE_FRONT_BIT, front->ref);
+    vkCmdSetStencilReference(cmd_buf, VK_STENCIL_FACE_BACK_BIT, back->ref);
+}
+
 static int prepare_and_bind_graphics_pipeline(struct ngpu_pipeline *s, VkCommandBuffer cmd_buf)
 {
     struct ngpu_pipeline_vk *s_priv = (struct ngpu_pipeline_vk *)s;
 
     vkCmdBindPipeline(cmd_buf, s_priv->pipeline_bind_point, s_priv->pipeline);
+    set_dynamic_stencil_state(s, cmd_buf);
 
     return 0;
 }
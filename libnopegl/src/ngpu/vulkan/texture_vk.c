@@ -602,39 +602,23 @@ static int texture_transfer_params_are_equal(const struct ngpu_texture_transfer_
            a->layer_count    == b->layer_count;
 }
 
-static VkResult texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, const struct ngpu_texture_transfer_params *transfer_params)
+static size_t get_transfer_layer_size(const struct ngpu_texture *s, const struct ngpu_texture_transfer_params *transfer_params)
+{
+    const struct ngpu_texture_vk *s_priv = (const struct ngpu_texture_vk *)s;
+    return (size_t)transfer_params->pixels_per_row
+         * (size_t)transfer_params->height
+         * (size_t)transfer_params->depth
+         * s_priv->bytes_per_pixel;
+}
+
+static VkResult texture_vk_copy_from_buffer(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset,
+                                            const struct ngpu_texture_transfer_params *transfer_params)
 {
     struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)s->gpu_ctx;
     const struct ngpu_texture_params *params = &s->params;
     struct ngpu_texture_vk *s_priv = (struct ngpu_texture_vk *)s;
 
-    /* Wrapped textures cannot update their content with this function */
-    ngli_assert(!s_priv->wrapped_image);
-    ngli_assert(params->usage & NGPU_TEXTURE_USAGE_TRANSFER_DST_BIT);
-
-    if (!data)
-        return VK_SUCCESS;
-
-    const size_t transfer_layer_size = (size_t)transfer_params->pixels_per_row
-                                     * (size_t)transfer_params->height
-                                     * (size_t)transfer_params->depth
-                                     * s_priv->bytes_per_pixel;
-    const size_t transfer_size = transfer_layer_size * transfer_params->layer_count;
-
-    if (s_priv->staging_buffer)
-        ngpu_buffer_wait(s_priv->staging_buffer);
-
-    if (!texture_transfer_params_are_equal(&s_priv->last_transfer_params, transfer_params)) {
-        destroy_staging_buffer(s);
-
-        int ret = create_staging_buffer(s, transfer_size);
-        if (ret < 0)
-            return VK_ERROR_UNKNOWN;
-
-        s_priv->last_transfer_params = *transfer_params;
-    }
-
-    memcpy(s_priv->staging_buffer_ptr, data, s_priv->staging_buffer->size);
+    const size_t transfer_layer_size = get_transfer_layer_size(s, transfer_params);
 
     struct ngpu_cmd_buffer_vk *cmd_buffer_vk = gpu_ctx_vk->cur_cmd_buffer;
     const int cmd_is_transient = cmd_buffer_vk ? 0 : 1;
@@ -645,7 +629,7 @@ static VkResult texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, c
     }
     VkCommandBuffer cmd_buf = cmd_buffer_vk->cmd_buf;
     NGPU_CMD_BUFFER_VK_REF(cmd_buffer_vk, s);
-    ngpu_cmd_buffer_vk_ref_buffer(cmd_buffer_vk, s_priv->staging_buffer);
+    ngpu_cmd_buffer_vk_ref_buffer(cmd_buffer_vk, buffer);
 
     const VkImageSubresourceRange subres_range = {
         .aspectMask     = get_vk_image_aspect_flags(s_priv->format),
@@ -664,9 +648,8 @@ static VkResult texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, c
     ngli_darray_init(&copy_regions, sizeof(VkBufferImageCopy), 0);
 
     for (uint32_t i = transfer_params->base_layer; i < transfer_params->layer_count; i++) {
-        const VkDeviceSize offset = i * transfer_layer_size;
         const VkBufferImageCopy region = {
-            .bufferOffset      = offset,
+            .bufferOffset      = offset + i * transfer_layer_size,
             .bufferRowLength   = transfer_params->pixels_per_row,
             .bufferImageHeight = 0,
             .imageSubresource = {
@@ -696,9 +679,9 @@ static VkResult texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, c
         }
     }
 
-    struct ngpu_buffer_vk *staging_buffer_vk = (struct ngpu_buffer_vk *)s_priv->staging_buffer;
+    struct ngpu_buffer_vk *buffer_vk = (struct ngpu_buffer_vk *)buffer;
     vkCmdCopyBufferToImage(cmd_buf,
-                           staging_buffer_vk->buffer,
+                           buffer_vk->buffer,
                            s_priv->image,
                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                            (uint32_t)ngli_darray_count(&copy_regions),
@@ -724,9 +707,41 @@ static VkResult texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, c
     return VK_SUCCESS;
 }
 
-int ngpu_texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, uint32_t linesize)
+static VkResult texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, const struct ngpu_texture_transfer_params *transfer_params)
 {
+    const struct ngpu_texture_params *params = &s->params;
     struct ngpu_texture_vk *s_priv = (struct ngpu_texture_vk *)s;
+
+    /* Wrapped textures cannot update their content with this function */
+    ngli_assert(!s_priv->wrapped_image);
+    ngli_assert(params->usage & NGPU_TEXTURE_USAGE_TRANSFER_DST_BIT);
+
+    if (!data)
+        return VK_SUCCESS;
+
+    const size_t transfer_size = get_transfer_layer_size(s, transfer_params) * transfer_params->layer_count;
+
+    if (s_priv->staging_buffer)
+        ngpu_buffer_wait(s_priv->staging_buffer);
+
+    if (!texture_transfer_params_are_equal(&s_priv->last_transfer_params, transfer_params)) {
+        destroy_staging_buffer(s);
+
+        int ret = create_staging_buffer(s, transfer_size);
+        if (ret < 0)
+            return VK_ERROR_UNKNOWN;
+
+        s_priv->last_transfer_params = *transfer_params;
+    }
+
+    memcpy(s_priv->staging_buffer_ptr, data, s_priv->staging_buffer->size);
+
+    return texture_vk_copy_from_buffer(s, s_priv->staging_buffer, 0, transfer_params);
+}
+
+static struct ngpu_texture_transfer_params get_default_transfer_params(const struct ngpu_texture *s, uint32_t linesize)
+{
+    const struct ngpu_texture_vk *s_priv = (const struct ngpu_texture_vk *)s;
     const struct ngpu_texture_params *params = &s->params;
     const struct ngpu_texture_transfer_params transfer_params = {
         .width = params->width,
@@ -736,6 +751,12 @@ int ngpu_texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, uint32_t
         .layer_count = s_priv->array_layers,
         .pixels_per_row = linesize ? linesize : params->width,
     };
+    return transfer_params;
+}
+
+int ngpu_texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, uint32_t linesize)
+{
+    const struct ngpu_texture_transfer_params transfer_params = get_default_transfer_params(s, linesize);
     return ngpu_texture_vk_upload_with_params(s, data, &transfer_params);
 }
 
@@ -747,6 +768,22 @@ int ngpu_texture_vk_upload_with_params(struct ngpu_texture *s, const uint8_t *da
     return ngli_vk_res2ret(res);
 }
 
+int ngpu_texture_vk_upload_from_buffer(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, uint32_t linesize)
+{
+    const struct ngpu_texture_params *params = &s->params;
+    const struct ngpu_texture_vk *s_priv = (const struct ngpu_texture_vk *)s;
+
+    ngli_assert(!s_priv->wrapped_image);
+    ngli_assert(params->usage & NGPU_TEXTURE_USAGE_TRANSFER_DST_BIT);
+    ngli_assert(buffer->usage & NGPU_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+    const struct ngpu_texture_transfer_params transfer_params = get_default_transfer_params(s, linesize);
+    VkResult res = texture_vk_copy_from_buffer(s, buffer, offset, &transfer_params);
+    if (res != VK_SUCCESS)
+        LOG(ERROR, "unable to upload texture from buffer: %s", ngli_vk_res2str(res));
+    return ngli_vk_res2ret(res);
+}
+
 static VkResult texture_vk_generate_mipmap(struct ngpu_texture *s)
 {
     struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)s->gpu_ctx;
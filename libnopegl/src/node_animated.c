@@ -29,11 +29,13 @@
 #include "log.h"
 #include "math_utils.h"
 #include "ngpu/type.h"
+#include "node_animated.h"
 #include "node_animkeyframe.h"
 #include "node_uniform.h"
 #include "node_velocity.h"
 #include "nopegl.h"
 #include "path.h"
+#include "utils/utils.h"
 
 #define OFFSET(x) offsetof(struct variable_opts, x)
 static const struct node_param animatedtime_params[] = {
@@ -295,31 +297,17 @@ static ngli_animation_cpy_func_type get_cpy_func(const struct variable_opts *o,
     return NULL;
 }
 
-int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
+/*
+ * Evaluate the animation with a dedicated cursor, leaving the state of the
+ * node (value and cursor used by the updates) untouched
+ */
+static int evaluate(struct ngl_node *node, void *dst, double t)
 {
-    if (node->cls->id == NGL_NODE_VELOCITYFLOAT ||
-        node->cls->id == NGL_NODE_VELOCITYVEC2 ||
-        node->cls->id == NGL_NODE_VELOCITYVEC3 ||
-        node->cls->id == NGL_NODE_VELOCITYVEC4)
-        return ngli_velocity_evaluate(node, dst, t);
-
-    if (node->cls->id != NGL_NODE_ANIMATEDFLOAT &&
-        node->cls->id != NGL_NODE_ANIMATEDVEC2 &&
-        node->cls->id != NGL_NODE_ANIMATEDVEC3 &&
-        node->cls->id != NGL_NODE_ANIMATEDVEC4 &&
-        node->cls->id != NGL_NODE_ANIMATEDQUAT)
-        return NGL_ERROR_INVALID_ARG;
-
     struct animated_priv *s = node->priv_data;
     const struct variable_opts *o = node->opts;
     if (!o->nb_animkf)
         return NGL_ERROR_INVALID_ARG;
 
-    if (node->cls->id == NGL_NODE_ANIMATEDQUAT && o->as_mat4) {
-        LOG(ERROR, "evaluating an AnimatedQuat to a mat4 is not supported");
-        return NGL_ERROR_UNSUPPORTED;
-    }
-
     if (!s->anim_eval.kfs) {
         int ret = ngli_animation_init(&s->anim_eval, s,
                                       o->animkf, o->nb_animkf,
@@ -341,6 +329,36 @@ int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
     return ngli_animation_evaluate(&s->anim_eval, dst, t - o->time_offset);
 }
 
+int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
+{
+    if (node->cls->id == NGL_NODE_VELOCITYFLOAT ||
+        node->cls->id == NGL_NODE_VELOCITYVEC2 ||
+        node->cls->id == NGL_NODE_VELOCITYVEC3 ||
+        node->cls->id == NGL_NODE_VELOCITYVEC4)
+        return ngli_velocity_evaluate(node, dst, t);
+
+    if (node->cls->id != NGL_NODE_ANIMATEDFLOAT &&
+        node->cls->id != NGL_NODE_ANIMATEDVEC2 &&
+        node->cls->id != NGL_NODE_ANIMATEDVEC3 &&
+        node->cls->id != NGL_NODE_ANIMATEDVEC4 &&
+        node->cls->id != NGL_NODE_ANIMATEDQUAT)
+        return NGL_ERROR_INVALID_ARG;
+
+    const struct variable_opts *o = node->opts;
+    if (node->cls->id == NGL_NODE_ANIMATEDQUAT && o->as_mat4) {
+        LOG(ERROR, "evaluating an AnimatedQuat to a mat4 is not supported");
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    return evaluate(node, dst, t);
+}
+
+int ngli_animated_time_evaluate(struct ngl_node *node, double *dst, double t)
+{
+    ngli_assert(node->cls->id == NGL_NODE_ANIMATEDTIME);
+    return evaluate(node, dst, t);
+}
+
 static int animation_init(struct ngl_node *node)
 {
     struct animated_priv *s = node->priv_data;
@@ -433,9 +451,20 @@ static int animation_update(struct ngl_node *node, double t)
 #define animatedvec2_update  animation_update
 #define animatedvec3_update  animation_update
 #define animatedvec4_update  animation_update
-#define animatedpath_update  animation_update
 #define animatedcolor_update animation_update
 
+static int animatedpath_update(struct ngl_node *node, double t)
+{
+    const struct variable_opts *o = node->opts;
+
+    /* The path may be animated as well and must be up-to-date before being evaluated */
+    int ret = ngli_node_update(o->path_node, t);
+    if (ret < 0)
+        return ret;
+
+    return animation_update(node, t);
+}
+
 static int animatedquat_update(struct ngl_node *node, double t)
 {
     struct animated_priv *s = node->priv_data;
@@ -80,6 +80,7 @@ struct animkeyframe_opts {
     double scalar;
     uint8_t *data;
     size_t data_size;
+    void *data_release;
     int easing;
     double *args;
     size_t nb_args;
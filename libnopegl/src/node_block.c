@@ -109,15 +109,41 @@ static const struct param_choices layout_choices = {
                                             NGL_NODE_TIME,                   \
                                             NGLI_NODE_NONE}
 
+/*
+ * Dirty ranges separated by less than this amount of bytes are merged into a
+ * single upload
+ */
+#define UPLOAD_MERGE_GAP 256
+
+struct range {
+    size_t start;
+    size_t end;
+};
+
 struct block_priv {
     struct block_info blk;
     int force_update;
+
+    /* Scratch field data used to detect the changes of the dynamic fields */
+    uint8_t *field_data;
+    size_t field_data_size;
+
+    /* Coalesced ranges of the block data changed during the current update */
+    struct range *dirty_ranges;
+    size_t nb_dirty_ranges;
+
+    /* Multi-buffering */
+    size_t slot_size;
+    uint32_t nb_slots;
+    uint32_t slot;
+    struct range *stale_ranges; /* per slot, data updated since its last upload */
 };
 
 struct block_opts {
     struct ngl_node **fields;
     size_t nb_fields;
     enum ngpu_block_layout layout;
+    int32_t multi_buffering;
 };
 
 #define OFFSET(x) offsetof(struct block_opts, x)
@@ -128,6 +154,9 @@ static const struct node_param block_params[] = {
     {"layout", NGLI_PARAM_TYPE_SELECT, OFFSET(layout), {.i32=NGPU_BLOCK_LAYOUT_STD140},
                .choices=&layout_choices,
                .desc=NGLI_DOCSTRING("memory layout set in the graphic program")},
+    {"multi_buffering", NGLI_PARAM_TYPE_BOOL, OFFSET(multi_buffering),
+                        .desc=NGLI_DOCSTRING("keep one copy of the data per in-flight frame so that updating the "
+                                             "dynamic fields never waits for the GPU to stop reading them")},
     {NULL}
 };
 
@@ -147,8 +176,10 @@ size_t ngli_node_block_get_cpu_size(struct ngl_node *node)
 
 size_t ngli_node_block_get_gpu_size(struct ngl_node *node)
 {
-    struct block_info *s = node->priv_data;
-    return s->data_size;
+    struct block_priv *s = node->priv_data;
+    if (s->blk.multi_buffered)
+        return s->slot_size * s->nb_slots;
+    return s->blk.data_size;
 }
 
 static enum ngpu_type get_node_data_type(const struct ngl_node *node)
@@ -210,23 +241,55 @@ static const uint8_t *get_data_ptr(const struct ngl_node *node, const struct ngp
     return fi->count ? get_buffer_data_ptr(node) : get_variable_data_ptr(node);
 }
 
-static int update_block_data(struct ngl_node *node, int forced)
+static void add_dirty_range(struct block_priv *s, size_t start, size_t end)
+{
+    /* Fields are ordered by offset so only the last range can be extended */
+    if (s->nb_dirty_ranges) {
+        struct range *last = &s->dirty_ranges[s->nb_dirty_ranges - 1];
+        if (start <= last->end + UPLOAD_MERGE_GAP) {
+            last->end = NGLI_MAX(last->end, end);
+            return;
+        }
+    }
+    s->dirty_ranges[s->nb_dirty_ranges++] = (struct range){start, end};
+}
+
+static void update_block_data(struct ngl_node *node, int forced)
 {
-    int has_changed = 0;
     struct block_priv *s = node->priv_data;
     struct block_info *info = &s->blk;
     const struct block_opts *o = node->opts;
     const struct ngpu_block_field *field_info = ngli_darray_data(&info->block.fields);
+
+    s->nb_dirty_ranges = 0;
+
+    if (forced) {
+        for (size_t i = 0; i < o->nb_fields; i++) {
+            const struct ngpu_block_field *fi = &field_info[i];
+            ngpu_block_field_copy(fi, info->data + fi->offset, get_data_ptr(o->fields[i], fi));
+        }
+        add_dirty_range(s, 0, info->data_size);
+        return;
+    }
+
     for (size_t i = 0; i < o->nb_fields; i++) {
         const struct ngl_node *field_node = o->fields[i];
         const struct ngpu_block_field *fi = &field_info[i];
-        if (!forced && !field_is_dynamic(field_node, fi))
+        if (!field_is_dynamic(field_node, fi))
             continue;
-        const uint8_t *src = get_data_ptr(field_node, fi);
-        ngpu_block_field_copy(fi, info->data + fi->offset, src);
-        has_changed = 1; // TODO: only re-upload the changing data segments
+
+        /*
+         * The field is copied in a scratch area first, so that only the
+         * fields actually changing are uploaded. The padding of the scratch
+         * area is never written so it stays zeroed, just like the block data.
+         */
+        uint8_t *dst = info->data + fi->offset;
+        ngpu_block_field_copy(fi, s->field_data, get_data_ptr(field_node, fi));
+        if (!memcmp(s->field_data, dst, fi->size))
+            continue;
+        memcpy(dst, s->field_data, fi->size);
+        add_dirty_range(s, fi->offset, fi->offset + fi->size);
     }
-    return has_changed;
 }
 
 static int cmp_str(const void *a, const void *b)
@@ -322,9 +385,36 @@ static int block_init(struct ngl_node *node)
     if (!info->data)
         return NGL_ERROR_MEMORY;
 
+    const struct ngpu_block_field *fields = ngli_darray_data(&info->block.fields);
+    for (size_t i = 0; i < o->nb_fields; i++)
+        s->field_data_size = NGLI_MAX(s->field_data_size, fields[i].size);
+    s->field_data = ngli_calloc(1, s->field_data_size);
+    s->dirty_ranges = ngli_calloc(o->nb_fields, sizeof(*s->dirty_ranges));
+    if (!s->field_data || !s->dirty_ranges)
+        return NGL_ERROR_MEMORY;
+
     update_block_data(node, 1);
     s->force_update = 1; /* First update will need an upload */
 
+    if (o->multi_buffering) {
+        if (!(info->usage & NGPU_BUFFER_USAGE_DYNAMIC_BIT)) {
+            LOG(DEBUG, "%s has no dynamic field, multi-buffering is not needed", node->label);
+        } else {
+            /* Every copy must be usable as a dynamic offset for both UBO and SSBO */
+            const struct ngpu_limits *limits = &gpu_ctx->limits;
+            const size_t alignment = NGLI_MAX(limits->min_uniform_block_offset_alignment,
+                                              limits->min_storage_block_offset_alignment);
+            s->slot_size = NGLI_ALIGN(info->data_size, alignment);
+            s->nb_slots = ngpu_ctx_get_nb_in_flight_frames(gpu_ctx);
+            s->stale_ranges = ngli_calloc(s->nb_slots, sizeof(*s->stale_ranges));
+            if (!s->stale_ranges)
+                return NGL_ERROR_MEMORY;
+            info->multi_buffered = 1;
+            info->usage |= NGPU_BUFFER_USAGE_MAP_WRITE;
+            LOG(DEBUG, "%s is multi-buffered with %u copies of %zu bytes", node->label, s->nb_slots, s->slot_size);
+        }
+    }
+
     info->buffer = ngpu_buffer_create(gpu_ctx);
     if (!info->buffer)
         return NGL_ERROR_MEMORY;
@@ -342,7 +432,8 @@ static int block_prepare(struct ngl_node *node)
     if (info->buffer->size)
         return 0;
 
-    int ret = ngpu_buffer_init(info->buffer, info->data_size, info->usage);
+    const size_t size = info->multi_buffered ? s->slot_size * s->nb_slots : info->data_size;
+    int ret = ngpu_buffer_init(info->buffer, size, info->usage);
     if (ret < 0)
         return ret;
 
@@ -358,6 +449,94 @@ static int block_invalidate(struct ngl_node *node)
     return 0;
 }
 
+static int upload_ranges(struct block_priv *s)
+{
+    struct block_info *info = &s->blk;
+
+    /* A full update allows the backend to orphan the buffer instead of waiting */
+    if (s->nb_dirty_ranges == 1 && s->dirty_ranges[0].start == 0 && s->dirty_ranges[0].end == info->data_size)
+        return ngpu_buffer_replace(info->buffer, info->data);
+
+    for (size_t i = 0; i < s->nb_dirty_ranges; i++) {
+        const struct range *range = &s->dirty_ranges[i];
+        int ret = ngpu_buffer_upload(info->buffer, info->data + range->start,
+                                     range->start, range->end - range->start);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+static int upload_multi_buffered(struct ngl_node *node)
+{
+    struct block_priv *s = node->priv_data;
+    struct block_info *info = &s->blk;
+
+    /*
+     * The copy associated with the current frame was last used
+     * nb_in_flight_frames ago: the command buffers of that frame have been
+     * waited for by ngpu_ctx_begin_update(), so it can be written without
+     * synchronization. The copy in use must follow the frame index even when
+     * the data did not change: the previous copy may still be read by the
+     * frames in flight when its turn to be written comes again.
+     */
+    struct ngpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
+    s->slot = ngpu_ctx_get_current_frame_index(gpu_ctx) % s->nb_slots;
+
+    const size_t base_offset = s->slot * s->slot_size;
+    info->buffer_offset = (uint32_t)base_offset;
+
+    /* Extent of the changes of the current update, missed by the other copies */
+    const int has_changes = s->nb_dirty_ranges > 0;
+    const size_t start = has_changes ? s->dirty_ranges[0].start : 0;
+    const size_t end = has_changes ? s->dirty_ranges[s->nb_dirty_ranges - 1].end : 0;
+
+    /*
+     * Bring the copy up-to-date with the changes it missed while not in use.
+     * The stale range is a single extent so it is merged with the current
+     * changes into one upload.
+     */
+    struct range *stale = &s->stale_ranges[s->slot];
+    if (stale->end > stale->start) {
+        if (has_changes) {
+            stale->start = NGLI_MIN(stale->start, start);
+            stale->end = NGLI_MAX(stale->end, end);
+        }
+        s->dirty_ranges[0] = *stale;
+        s->nb_dirty_ranges = 1;
+    }
+
+    if (!s->nb_dirty_ranges)
+        return 0;
+
+    for (size_t i = 0; i < s->nb_dirty_ranges; i++) {
+        const struct range *range = &s->dirty_ranges[i];
+        int ret = ngpu_buffer_upload_unsynchronized(info->buffer, info->data + range->start,
+                                                    base_offset + range->start, range->end - range->start);
+        if (ret < 0)
+            return ret;
+    }
+    *stale = (struct range){0};
+
+    if (!has_changes)
+        return 0;
+
+    /* The other copies now miss the changes of the current update */
+    for (uint32_t i = 0; i < s->nb_slots; i++) {
+        struct range *range = &s->stale_ranges[i];
+        if (i == s->slot)
+            continue;
+        if (range->end > range->start) {
+            range->start = NGLI_MIN(range->start, start);
+            range->end = NGLI_MAX(range->end, end);
+        } else {
+            *range = (struct range){start, end};
+        }
+    }
+
+    return 0;
+}
+
 static int block_update(struct ngl_node *node, double t)
 {
     struct block_priv *s = node->priv_data;
@@ -367,16 +546,16 @@ static int block_update(struct ngl_node *node, double t)
     if (ret < 0)
         return ret;
 
-    const int has_changed = update_block_data(node, s->force_update);
+    update_block_data(node, s->force_update);
     s->force_update = 0;
 
-    if (has_changed) {
-        ret = ngpu_buffer_upload(info->buffer, info->data, 0, info->data_size);
-        if (ret < 0)
-            return ret;
-    }
+    if (info->multi_buffered)
+        return upload_multi_buffered(node);
 
-    return 0;
+    if (!s->nb_dirty_ranges)
+        return 0;
+
+    return upload_ranges(s);
 }
 
 static void block_uninit(struct ngl_node *node)
@@ -387,6 +566,9 @@ static void block_uninit(struct ngl_node *node)
     ngpu_buffer_freep(&info->buffer);
     ngpu_block_desc_reset(&info->block);
     ngli_free(info->data);
+    ngli_freep(&s->field_data);
+    ngli_freep(&s->dirty_ranges);
+    ngli_freep(&s->stale_ranges);
 }
 
 const struct node_class ngli_block_class = {
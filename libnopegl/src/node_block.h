@@ -39,6 +39,15 @@ struct block_info {
 
     struct ngpu_buffer *buffer;
     size_t buffer_rev;
+
+    /*
+     * When multi-buffered, the buffer holds one copy of the data per in-flight
+     * frame: the block must be declared with a dynamic buffer type, bound with
+     * a data_size range, and the current copy selected with buffer_offset as
+     * dynamic offset.
+     */
+    int multi_buffered;
+    uint32_t buffer_offset;
 };
 
 void ngli_node_block_extend_usage(struct ngl_node *node, uint32_t usage);
@@ -42,6 +42,7 @@ struct buffer_opts {
     uint32_t count;
     uint8_t *data;
     size_t data_size;
+    void *data_release;
     char *filename;
     struct ngl_node *block;
     char *block_field;
@@ -206,6 +207,11 @@ static int buffer_init_from_block(struct ngl_node *node)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    if (block_info->multi_buffered) {
+        LOG(ERROR, "buffers referencing a multi-buffered block are not supported");
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
     const struct ngpu_block_field *fi = get_block_field(&block->fields, o->block_field);
     if (!fi) {
         LOG(ERROR, "field %s not found in %s", o->block_field, o->block->label);
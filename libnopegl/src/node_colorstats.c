@@ -45,13 +45,22 @@
  */
 #define MAX_BIT_DEPTH 8
 
+/* Every amortization phase has its own parameters, twice (see init_computes()) */
+#define MAX_AMORTIZATION 64
+
 struct stats_params_block {
     int32_t depth;
     int32_t length_minus1;
+    int32_t subsampling;
+    int32_t phase;
+    int32_t nb_phases;
+    int32_t publish;
 };
 
 struct colorstats_opts {
     struct ngl_node *texture_node;
+    uint32_t subsampling;
+    uint32_t amortization;
 };
 
 #define OFFSET(x) offsetof(struct colorstats_opts, x)
@@ -60,6 +69,11 @@ static const struct node_param colorstats_params[] = {
                 .flags=NGLI_PARAM_FLAG_NON_NULL,
                 .node_types=(const uint32_t[]){NGL_NODE_TEXTURE2D, NGLI_NODE_NONE},
                 .desc=NGLI_DOCSTRING("source texture to compute the color stats from")},
+    {"subsampling", NGLI_PARAM_TYPE_U32, OFFSET(subsampling), {.u32=1},
+                    .desc=NGLI_DOCSTRING("only sample 1 pixel every `subsampling` pixels, horizontally and vertically")},
+    {"amortization", NGLI_PARAM_TYPE_U32, OFFSET(amortization), {.u32=1},
+                     .desc=NGLI_DOCSTRING("number of frames (up to 64) over which the sampled rows are spread; "
+                                          "the stats are published once all the rows have been processed")},
     {NULL}
 };
 
@@ -68,6 +82,17 @@ struct colorstats_priv {
     uint32_t depth;
     uint32_t length_minus1;
     uint32_t group_size;
+    uint32_t source_w;
+    uint32_t source_h;
+
+    /* Temporal amortization state */
+    uint32_t phase;
+    int primed;
+    int dispatched;
+
+    /* Partial histograms accumulated across the amortization phases */
+    struct ngpu_block_desc accum_block;
+    struct ngpu_buffer *accum_buffer;
 
     struct ngpu_block stats_params_block;
 
@@ -223,9 +248,18 @@ static int init_computes(struct ngl_node *node)
     const struct ngpu_block_entry block_fields[] = {
         NGPU_BLOCK_FIELD(struct stats_params_block, depth, NGPU_TYPE_I32, 0),
         NGPU_BLOCK_FIELD(struct stats_params_block, length_minus1, NGPU_TYPE_I32, 0),
+        NGPU_BLOCK_FIELD(struct stats_params_block, subsampling, NGPU_TYPE_I32, 0),
+        NGPU_BLOCK_FIELD(struct stats_params_block, phase, NGPU_TYPE_I32, 0),
+        NGPU_BLOCK_FIELD(struct stats_params_block, nb_phases, NGPU_TYPE_I32, 0),
+        NGPU_BLOCK_FIELD(struct stats_params_block, publish, NGPU_TYPE_I32, 0),
     };
+    /*
+     * One entry per amortization phase and publish state, so that the
+     * parameters are only uploaded when the stream size changes and selected
+     * with a dynamic offset at every frame
+     */
     const struct ngpu_block_params block_params = {
-        .count      = 1,
+        .count      = 2 * o->amortization,
         .entries    = block_fields,
         .nb_entries = NGLI_ARRAY_NB(block_fields),
     };
@@ -237,12 +271,12 @@ static int init_computes(struct ngl_node *node)
         {
             .name     = "params",
             .instance_name = "",
-            .type     = NGPU_TYPE_UNIFORM_BUFFER,
+            .type     = NGPU_TYPE_UNIFORM_BUFFER_DYNAMIC,
             .stage    = NGPU_PROGRAM_STAGE_COMP,
             .block    = &s->stats_params_block.block_desc,
             .buffer   = {
                 .buffer = s->stats_params_block.buffer,
-                .size   = s->stats_params_block.buffer->size,
+                .size   = s->stats_params_block.block_size,
             },
         }, {
             .name     = "stats",
@@ -250,13 +284,20 @@ static int init_computes(struct ngl_node *node)
             .stage    = NGPU_PROGRAM_STAGE_COMP,
             .writable = 1,
             .block    = &s->blk.block,
+        }, {
+            .name     = "accum",
+            .type     = NGPU_TYPE_STORAGE_BUFFER,
+            .stage    = NGPU_PROGRAM_STAGE_COMP,
+            .writable = 1,
+            .block    = &s->accum_block,
         },
     };
-    size_t nb_blocks = NGLI_ARRAY_NB(blocks);
+    const size_t nb_blocks = NGLI_ARRAY_NB(blocks);
 
-    if ((ret = setup_init_compute(s, blocks, nb_blocks)) < 0 ||
+    /* Only the waveform compute needs the accumulation histograms (last block) */
+    if ((ret = setup_init_compute(s, blocks, nb_blocks - 1)) < 0 ||
         (ret = setup_waveform_compute(s, blocks, nb_blocks, o->texture_node)) < 0 ||
-        (ret = setup_sumscale_compute(s, blocks, nb_blocks)) < 0)
+        (ret = setup_sumscale_compute(s, blocks, nb_blocks - 1)) < 0)
         return ret;
 
     return 0;
@@ -286,7 +327,15 @@ static int init_block(struct colorstats_priv *s, struct ngpu_ctx *gpu_ctx)
     /* Colorstats needs to write into the block so we bind it as SSBO */
     s->blk.usage = NGPU_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 
-    return 0;
+    /*
+     * Private accumulation histograms, packed the same way as the shared
+     * histograms of the waveform compute (r|g<<16, b|l<<16)
+     */
+    ngpu_block_desc_init(gpu_ctx, &s->accum_block, NGPU_BLOCK_LAYOUT_STD430);
+    static const struct ngpu_block_field accum_fields[] = {
+        {"data", NGPU_TYPE_UVEC2, NGPU_BLOCK_DESC_VARIADIC_COUNT},
+    };
+    return ngpu_block_desc_add_fields(&s->accum_block, accum_fields, NGLI_ARRAY_NB(accum_fields));
 }
 
 static int colorstats_init(struct ngl_node *node)
@@ -294,6 +343,17 @@ static int colorstats_init(struct ngl_node *node)
     struct ngl_ctx *ctx = node->ctx;
     struct colorstats_priv *s = node->priv_data;
     struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    const struct colorstats_opts *o = node->opts;
+
+    if (o->subsampling < 1) {
+        LOG(ERROR, "invalid subsampling (%u < 1)", o->subsampling);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    if (o->amortization < 1 || o->amortization > MAX_AMORTIZATION) {
+        LOG(ERROR, "invalid amortization (%u not in [1,%d])", o->amortization, MAX_AMORTIZATION);
+        return NGL_ERROR_INVALID_ARG;
+    }
 
     if (!(gpu_ctx->features & NGPU_FEATURE_COMPUTE)) {
         LOG(ERROR, "ColorStats is not supported by this context (requires compute shaders and SSBO support)");
@@ -307,9 +367,37 @@ static int colorstats_init(struct ngl_node *node)
     return 0;
 }
 
-static int alloc_block_buffer(struct ngl_node *node, uint32_t length)
+static int update_stats_params(struct ngl_node *node)
 {
     struct colorstats_priv *s = node->priv_data;
+    const struct colorstats_opts *o = node->opts;
+
+    for (uint32_t phase = 0; phase < o->amortization; phase++) {
+        for (uint32_t publish = 0; publish < 2; publish++) {
+            const struct stats_params_block stats_params_block = {
+                .depth         = (int32_t)s->depth,
+                .length_minus1 = (int32_t)s->length_minus1,
+                .subsampling   = (int32_t)o->subsampling,
+                .phase         = (int32_t)phase,
+                .nb_phases     = (int32_t)o->amortization,
+                .publish       = (int32_t)publish,
+            };
+            int ret = ngpu_block_update(&s->stats_params_block, 2 * phase + publish, &stats_params_block);
+            if (ret < 0)
+                return ret;
+        }
+    }
+
+    return 0;
+}
+
+static int alloc_block_buffer(struct ngl_node *node, uint32_t source_w, uint32_t source_h)
+{
+    struct colorstats_priv *s = node->priv_data;
+    const struct colorstats_opts *o = node->opts;
+
+    /* Number of sampled columns */
+    const uint32_t length = (source_w + o->subsampling - 1) / o->subsampling;
 
     /* We assume a 8-bit sampling all the time for now */
     s->depth = 1U << 8;
@@ -321,11 +409,6 @@ static int alloc_block_buffer(struct ngl_node *node, uint32_t length)
     s->length_minus1 = length - 1;
     ngli_assert(s->length_minus1 <= INT32_MAX - 1);
 
-    ngpu_block_update(&s->stats_params_block, 0, &(const struct stats_params_block) {
-        .depth = (int32_t)s->depth,
-        .length_minus1 = (int32_t)s->length_minus1,
-    });
-
     /*
      * Given the following possible configurations:
      * - depth: 1<<8 (256), 1<<9 (512) or 1<<10 (1024)
@@ -341,13 +424,19 @@ static int alloc_block_buffer(struct ngl_node *node, uint32_t length)
     ngli_assert(s->group_size <= s->depth);
     ngli_assert(s->depth % s->group_size == 0);
 
-    /* Each workgroup of the waveform compute works on 1 column of pixels */
+    /* Each workgroup of the waveform compute works on 1 sampled column of pixels */
     s->waveform.wg_count = length;
 
     struct ngl_ctx *ctx = node->ctx;
     struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+
+    /* Release the buffers associated with the previous stream size, if any */
+    ngpu_buffer_freep(&s->blk.buffer);
+    ngpu_buffer_freep(&s->accum_buffer);
+
     s->blk.buffer = ngpu_buffer_create(gpu_ctx);
-    if (!s->blk.buffer)
+    s->accum_buffer = ngpu_buffer_create(gpu_ctx);
+    if (!s->blk.buffer || !s->accum_buffer)
         return NGL_ERROR_MEMORY;
 
     /*
@@ -360,17 +449,65 @@ static int alloc_block_buffer(struct ngl_node *node, uint32_t length)
     if (ret < 0)
         return ret;
 
+    /*
+     * The accumulation histograms are only accessed when the work is spread
+     * over multiple frames, so a single entry is enough otherwise.
+     */
+    const size_t accum_field_count = o->amortization > 1 ? data_field_count : 1;
+    const size_t accum_size = ngpu_block_desc_get_size(&s->accum_block, accum_field_count);
+    ret = ngpu_buffer_init(s->accum_buffer, accum_size, NGPU_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    if (ret < 0)
+        return ret;
+
     if ((ret = ngli_pipeline_compat_update_buffer(s->init.pipeline_compat, 1, s->blk.buffer, 0, 0)) < 0 ||
         (ret = ngli_pipeline_compat_update_buffer(s->sumscale.pipeline_compat, 1, s->blk.buffer, 0, 0)) < 0 ||
-        (ret = ngli_pipeline_compat_update_buffer(s->waveform.pipeline_compat, 1, s->blk.buffer, 0, 0)) < 0)
+        (ret = ngli_pipeline_compat_update_buffer(s->waveform.pipeline_compat, 1, s->blk.buffer, 0, 0)) < 0 ||
+        (ret = ngli_pipeline_compat_update_buffer(s->waveform.pipeline_compat, 2, s->accum_buffer, 0, 0)) < 0)
         return ret;
 
+    ret = update_stats_params(node);
+    if (ret < 0)
+        return ret;
+
+    s->source_w = source_w;
+    s->source_h = source_h;
+
+    /*
+     * The new buffer content is undefined: restart the amortization cycle and
+     * publish the partial stats until it is complete
+     */
+    s->phase = 0;
+    s->primed = 0;
+
     /* Signal buffer change */
     s->blk.buffer_rev++;
 
     return 0;
 }
 
+/* Allocate the buffers on the first call and whenever the source size changes */
+static int check_source_size(struct ngl_node *node)
+{
+    struct colorstats_priv *s = node->priv_data;
+    const struct colorstats_opts *o = node->opts;
+
+    const struct texture_info *texture_info = o->texture_node->priv_data;
+    if (texture_info->image.params.width <= 0) {
+        LOG(ERROR, "invalid texture width: %u", texture_info->image.params.width);
+        return NGL_ERROR_INVALID_DATA;
+    }
+    const uint32_t source_w = (uint32_t)texture_info->image.params.width;
+    const uint32_t source_h = (uint32_t)texture_info->image.params.height;
+
+    if (s->blk.buffer && s->source_w == source_w && s->source_h == source_h)
+        return 0;
+
+    if (s->blk.buffer)
+        LOG(DEBUG, "stream size change (%ux%u -> %ux%u), reallocating buffers",
+            s->source_w, s->source_h, source_w, source_h);
+    return alloc_block_buffer(node, source_w, source_h);
+}
+
 static int colorstats_update(struct ngl_node *node, double t)
 {
     struct colorstats_priv *s = node->priv_data;
@@ -380,27 +517,18 @@ static int colorstats_update(struct ngl_node *node, double t)
     if (ret < 0)
         return ret;
 
+    s->dispatched = 0;
+
     /*
-     * Lazily allocate the data buffer because it depends on the texture
-     * dimensions
+     * A texture rendered to with a size following its render target only
+     * gets its final size when it is drawn, so its buffers are allocated at
+     * draw time
      */
     const struct texture_info *texture_info = o->texture_node->priv_data;
-    if (texture_info->image.params.width <= 0) {
-        LOG(ERROR, "invalid texture width: %u", texture_info->image.params.width);
-        return NGL_ERROR_INVALID_DATA;
-    }
-    const uint32_t source_w = (uint32_t)texture_info->image.params.width;
-    if (!s->blk.buffer)
-        return alloc_block_buffer(node, source_w);
-
-    /* Stream size change event */
-    if (s->length_minus1 != source_w - 1) {
-        // TODO: we need to resize the block data field / reallocate the underlying buffer
-        LOG(ERROR, "stream size change (%u -> %u) is not supported", s->length_minus1 + 1, source_w);
-        return NGL_ERROR_UNSUPPORTED;
-    }
+    if (texture_info->rtt)
+        return 0;
 
-    return 0;
+    return check_source_size(node);
 }
 
 static void colorstats_draw(struct ngl_node *node)
@@ -410,14 +538,38 @@ static void colorstats_draw(struct ngl_node *node)
 
     ngli_node_draw(o->texture_node);
 
+    const struct texture_info *texture_info = o->texture_node->priv_data;
+    if (texture_info->rtt && check_source_size(node) < 0)
+        return;
+
+    /*
+     * The accumulation histograms are updated in place, so the current slice
+     * of rows must only be processed once per frame
+     */
+    if (o->amortization > 1 && s->dispatched)
+        return;
+    s->dispatched = 1;
+
     struct ngl_ctx *ctx = node->ctx;
     if (ngpu_ctx_is_render_pass_active(ctx->gpu_ctx)) {
         ngpu_ctx_end_render_pass(ctx->gpu_ctx);
         ctx->current_rendertarget = ctx->available_rendertargets[1];
     }
 
+    /*
+     * The stats are only published when the last slice of rows is processed,
+     * or at every frame until a first full cycle has been completed
+     */
+    const int publish = s->phase == o->amortization - 1 || !s->primed;
+
+    const uint32_t offset = (uint32_t)((2 * s->phase + (uint32_t)publish) * s->stats_params_block.block_size);
+    ngli_pipeline_compat_update_dynamic_offsets(s->init.pipeline_compat, &offset, 1);
+    ngli_pipeline_compat_update_dynamic_offsets(s->waveform.pipeline_compat, &offset, 1);
+    ngli_pipeline_compat_update_dynamic_offsets(s->sumscale.pipeline_compat, &offset, 1);
+
     /* Init */
-    ngli_pipeline_compat_dispatch(s->init.pipeline_compat, s->init.wg_count, 1, 1);
+    if (publish)
+        ngli_pipeline_compat_dispatch(s->init.pipeline_compat, s->init.wg_count, 1, 1);
 
     /* Waveform */
     if (s->waveform.image_rev != s->waveform.image->rev) {
@@ -427,7 +579,13 @@ static void colorstats_draw(struct ngl_node *node)
     ngli_pipeline_compat_dispatch(s->waveform.pipeline_compat, s->waveform.wg_count, 1, 1);
 
     /* Summary-scale */
-    ngli_pipeline_compat_dispatch(s->sumscale.pipeline_compat, s->sumscale.wg_count, 1, 1);
+    if (publish)
+        ngli_pipeline_compat_dispatch(s->sumscale.pipeline_compat, s->sumscale.wg_count, 1, 1);
+
+    /* Move on to the next slice of rows */
+    if (s->phase == o->amortization - 1)
+        s->primed = 1;
+    s->phase = (s->phase + 1) % o->amortization;
 }
 
 static void colorstats_uninit(struct ngl_node *node)
@@ -441,7 +599,9 @@ static void colorstats_uninit(struct ngl_node *node)
     ngli_pipeline_compat_freep(&s->waveform.pipeline_compat);
     ngli_pipeline_compat_freep(&s->sumscale.pipeline_compat);
     ngpu_buffer_freep(&s->blk.buffer);
+    ngpu_buffer_freep(&s->accum_buffer);
     ngpu_block_desc_reset(&s->blk.block);
+    ngpu_block_desc_reset(&s->accum_block);
     ngpu_block_reset(&s->stats_params_block);
 }
 
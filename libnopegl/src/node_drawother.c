@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "blending.h"
+#include "culling.h"
 #include "filterschain.h"
 #include "geometry.h"
 #include "internal.h"
@@ -37,6 +38,7 @@
 #include "node_uniform.h"
 #include "pipeline_compat.h"
 #include "ngpu/pgcraft.h"
+#include "rtt.h"
 #include "transforms.h"
 #include "utils/darray.h"
 #include "utils/memory.h"
@@ -580,7 +582,7 @@ static int init(struct ngl_node *node,
     if (!o->geometry) {
         s->own_geometry = 1;
 
-        s->geometry = ngli_geometry_create(gpu_ctx);
+        s->geometry = ngli_geometry_create(gpu_ctx, ctx->geometry_cache);
         if (!s->geometry)
             return NGL_ERROR_MEMORY;
 
@@ -1448,6 +1450,24 @@ static void drawother_draw(struct ngl_node *node, struct draw_common *s, const s
     ngli_node_draw_children(node);
 
     struct ngl_ctx *ctx = node->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+
+    /*
+     * The scissor is restricted to the screen-space bounds of the geometry,
+     * which are also used to track the area of the render target holding
+     * content
+     */
+    struct ngpu_scissor scissor = ctx->scissor;
+    const struct geometry *geometry = s->geometry;
+    if (geometry->has_bounds &&
+        ngli_culling_clip_box(ctx, geometry->bounds_min, geometry->bounds_max, &scissor)) {
+        /* The render pass still needs to start for its clear to happen */
+        if (!ngpu_ctx_is_render_pass_active(gpu_ctx))
+            ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
+        node->cull_count++;
+        return;
+    }
+
     struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
     struct pipeline_desc *desc = &descs[ctx->rnode_pos->id];
     struct pipeline_compat *pl_compat = desc->pipeline_compat;
@@ -1489,14 +1509,13 @@ static void drawother_draw(struct ngl_node *node, struct draw_common *s, const s
         }
     }
 
-    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
-
     if (!ngpu_ctx_is_render_pass_active(gpu_ctx)) {
         ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
     }
 
     ngpu_ctx_set_viewport(gpu_ctx, &ctx->viewport);
-    ngpu_ctx_set_scissor(gpu_ctx, &ctx->scissor);
+    ngpu_ctx_set_scissor(gpu_ctx, &scissor);
+    ngli_rtt_add_content_area(ctx, &scissor);
 
     s->draw(s, desc->pipeline_compat);
 }
@@ -25,8 +25,12 @@
 
 #include "blending.h"
 #include "box.h"
+#include "culling.h"
 #include "distmap.h"
 #include "internal.h"
+#include "log.h"
+#include "ngpu/block_desc.h"
+#include "ngpu/buffer.h"
 #include "ngpu/ctx.h"
 #include "ngpu/texture.h"
 #include "ngpu/type.h"
@@ -35,12 +39,45 @@
 #include "path.h"
 #include "pipeline_compat.h"
 #include "ngpu/pgcraft.h"
+#include "rtt.h"
+#include "utils/darray.h"
+#include "utils/memory.h"
 #include "utils/utils.h"
 
 /* GLSL fragments as string */
+#include "path_analytic_frag.h"
 #include "path_frag.h"
 #include "path_vert.h"
 
+enum {
+    PATH_MODE_DISTMAP,
+    PATH_MODE_ANALYTIC,
+};
+
+/*
+ * Analytic mode: the path is flattened into lines with a tolerance expressed
+ * in the normalized viewbox space, and the lines are binned into horizontal
+ * bands so that each fragment only visits the lines close to it.
+ */
+#define ANALYTIC_TOLERANCE        (1.f / 1024.f)
+#define ANALYTIC_MAX_SUBDIVISIONS 64
+#define ANALYTIC_LINES_PER_BAND   8
+#define ANALYTIC_MAX_BANDS        64
+
+/* Same padding as the distance map, relative to the largest dimension */
+#define ANALYTIC_PADDING .8f
+
+/* Distance beyond which the glow contribution is below 1/255 (see path.glsl) */
+#define ANALYTIC_GLOW_REACH .55f
+
+/* Extra margin to preserve the anti-aliasing, and margin quantization step */
+#define ANALYTIC_AA_MARGIN (1.f / 64.f)
+
+struct line {
+    float x0, y0, x1, y1;
+    int winding;
+};
+
 struct uniform_map {
     int index;
     const void *data;
@@ -48,6 +85,7 @@ struct uniform_map {
 
 struct pipeline_desc {
     struct pipeline_compat *pipeline_compat;
+    size_t segments_buffer_rev;
 };
 
 struct drawpath_opts {
@@ -73,9 +111,11 @@ struct drawpath_opts {
     float glow_color[3];
     struct ngl_node *blur_node;
     float blur;
+    int mode;
 };
 
 struct drawpath_priv {
+    /* Quad coordinates within the atlas (distmap) or the path space (analytic) */
     struct ngli_aabb atlas_coords;
     float vertices[4];
     struct distmap *distmap;
@@ -88,6 +128,31 @@ struct drawpath_priv {
     int vertices_index;
     int coords_index;
     struct darray pipeline_descs;
+
+    /* Analytic mode */
+    const struct path *src_path;
+    uint32_t src_path_rev;
+    float margin;
+    struct darray lines;      // struct line
+    struct darray band_lines; // float[4]
+    int32_t nb_bands;
+    int32_t bands[ANALYTIC_MAX_BANDS][4];
+    struct ngpu_block_desc segments_block;
+    uint8_t *segments_data;
+    struct ngpu_buffer *segments_buffer;
+    size_t segments_buffer_rev;
+    int32_t segments_index;
+};
+
+static const struct param_choices mode_choices = {
+    .name = "path_mode",
+    .consts = {
+        {"distmap",  PATH_MODE_DISTMAP,  .desc=NGLI_DOCSTRING("render the path once into a signed distance field atlas "
+                                                             "at initialization")},
+        {"analytic", PATH_MODE_ANALYTIC, .desc=NGLI_DOCSTRING("evaluate the path coverage in the fragment shader from "
+                                                             "the path segments, uploaded every time the path changes")},
+        {NULL}
+    }
 };
 
 #define OFFSET(x) offsetof(struct drawpath_opts, x)
@@ -128,6 +193,9 @@ static const struct node_param drawpath_params[] = {
     {"blur",         NGLI_PARAM_TYPE_F32, OFFSET(blur_node),
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
                      .desc=NGLI_DOCSTRING("path blur")},
+    {"mode",         NGLI_PARAM_TYPE_SELECT, OFFSET(mode), {.i32=PATH_MODE_DISTMAP},
+                     .choices=&mode_choices,
+                     .desc=NGLI_DOCSTRING("path rendering implementation")},
     {NULL}
 };
 
@@ -159,13 +227,11 @@ static int build_uniforms_map(struct drawpath_priv *s)
     return 0;
 }
 
-static int drawpath_init(struct ngl_node *node)
+static int init_distmap(struct ngl_node *node)
 {
     struct drawpath_priv *s = node->priv_data;
     const struct drawpath_opts *o = node->opts;
 
-    ngli_darray_init(&s->pipeline_descs, sizeof(struct pipeline_desc), 0);
-
     s->distmap = ngli_distmap_create(node->ctx);
     if (!s->distmap)
         return NGL_ERROR_MEMORY;
@@ -230,6 +296,68 @@ static int drawpath_init(struct ngl_node *node)
     const float vertices[] = {bx, by, bx + nw, by + nh};
     memcpy(s->vertices, vertices, sizeof(s->vertices));
 
+    return 0;
+}
+
+static int init_analytic(struct ngl_node *node)
+{
+    struct drawpath_priv *s = node->priv_data;
+    const struct drawpath_opts *o = node->opts;
+    struct ngpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
+
+    if (!(gpu_ctx->features & NGPU_FEATURE_STORAGE_BUFFER)) {
+        LOG(ERROR, "analytic path rendering is not supported by this context (requires SSBO support)");
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+    }
+
+    s->path = ngli_path_create();
+    if (!s->path)
+        return NGL_ERROR_MEMORY;
+
+    ngli_darray_init(&s->lines, sizeof(struct line), 0);
+    ngli_darray_init(&s->band_lines, 4 * sizeof(float), 0);
+
+    /*
+     * The path is expressed in a space where the viewbox is normalized, and
+     * the box covers the same area as the distance map shape so that both
+     * modes render identically.
+     */
+    const int32_t *ar32 = node->scene->params.aspect_ratio;
+    const float ar = ar32[1] ? (float)ar32[0] / (float)ar32[1] : 1.f;
+    const float shape_w = ar > 1.f ? ar : 1.f;
+    const float shape_h = ar > 1.f ? 1.f : 1.f / ar;
+    const float pad = ANALYTIC_PADDING * NGLI_MAX(shape_w, shape_h);
+    s->atlas_coords = (struct ngli_aabb){-pad, -pad, shape_w + pad, shape_h + pad};
+
+    const struct ngli_box box = {NGLI_ARG_VEC4(o->box)};
+    const float nw = box.w * (shape_w + 2.f * pad) / shape_w;
+    const float nh = box.h * (shape_h + 2.f * pad) / shape_h;
+    const float bx = box.x + (box.w - nw) / 2.f;
+    const float by = box.y + (box.h - nh) / 2.f;
+    const float vertices[] = {bx, by, bx + nw, by + nh};
+    memcpy(s->vertices, vertices, sizeof(s->vertices));
+
+    ngpu_block_desc_init(gpu_ctx, &s->segments_block, NGPU_BLOCK_LAYOUT_STD430);
+    static const struct ngpu_block_field segments_fields[] = {
+        {"nb_bands", NGPU_TYPE_I32,   0},
+        {"margin",   NGPU_TYPE_F32,   0},
+        {"bands",    NGPU_TYPE_IVEC4, ANALYTIC_MAX_BANDS},
+        {"lines",    NGPU_TYPE_VEC4,  NGPU_BLOCK_DESC_VARIADIC_COUNT},
+    };
+    return ngpu_block_desc_add_fields(&s->segments_block, segments_fields, NGLI_ARRAY_NB(segments_fields));
+}
+
+static int drawpath_init(struct ngl_node *node)
+{
+    struct drawpath_priv *s = node->priv_data;
+    const struct drawpath_opts *o = node->opts;
+
+    ngli_darray_init(&s->pipeline_descs, sizeof(struct pipeline_desc), 0);
+
+    int ret = o->mode == PATH_MODE_ANALYTIC ? init_analytic(node) : init_distmap(node);
+    if (ret < 0)
+        return ret;
+
     const struct ngpu_pgcraft_uniform uniforms[] = {
         {.name="modelview_matrix",  .type=NGPU_TYPE_MAT4,  .stage=NGPU_PROGRAM_STAGE_VERT},
         {.name="projection_matrix", .type=NGPU_TYPE_MAT4,  .stage=NGPU_PROGRAM_STAGE_VERT},
@@ -254,13 +382,21 @@ static int drawpath_init(struct ngl_node *node)
         if (!ngli_darray_push(&s->uniforms, &uniforms[i]))
             return NGL_ERROR_MEMORY;
 
-    struct ngpu_texture *texture = ngli_distmap_get_texture(s->distmap);
     const struct ngpu_pgcraft_texture textures[] = {
         {
             .name = "tex",
             .type = NGPU_PGCRAFT_TEXTURE_TYPE_2D,
             .stage = NGPU_PROGRAM_STAGE_FRAG,
-            .texture = texture,
+            .texture = s->distmap ? ngli_distmap_get_texture(s->distmap) : NULL,
+        },
+    };
+
+    const struct ngpu_pgcraft_block blocks[] = {
+        {
+            .name  = "segments",
+            .type  = NGPU_TYPE_STORAGE_BUFFER,
+            .stage = NGPU_PROGRAM_STAGE_FRAG,
+            .block = &s->segments_block,
         },
     };
 
@@ -271,14 +407,17 @@ static int drawpath_init(struct ngl_node *node)
         },
     };
 
+    const int analytic = o->mode == PATH_MODE_ANALYTIC;
     const struct ngpu_pgcraft_params crafter_params = {
-        .program_label    = "nopegl/path",
+        .program_label    = analytic ? "nopegl/path-analytic" : "nopegl/path",
         .vert_base        = path_vert,
-        .frag_base        = path_frag,
-        .textures         = textures,
-        .nb_textures      = NGLI_ARRAY_NB(textures),
+        .frag_base        = analytic ? path_analytic_frag : path_frag,
+        .textures         = analytic ? NULL : textures,
+        .nb_textures      = analytic ? 0 : NGLI_ARRAY_NB(textures),
         .uniforms         = ngli_darray_data(&s->uniforms),
         .nb_uniforms      = ngli_darray_count(&s->uniforms),
+        .blocks           = analytic ? blocks : NULL,
+        .nb_blocks        = analytic ? NGLI_ARRAY_NB(blocks) : 0,
         .vert_out_vars    = vert_out_vars,
         .nb_vert_out_vars = NGLI_ARRAY_NB(vert_out_vars),
     };
@@ -296,6 +435,8 @@ static int drawpath_init(struct ngl_node *node)
     s->projection_matrix_index = ngpu_pgcraft_get_uniform_index(s->crafter, "projection_matrix", NGPU_PROGRAM_STAGE_VERT);
     s->vertices_index          = ngpu_pgcraft_get_uniform_index(s->crafter, "vertices", NGPU_PROGRAM_STAGE_VERT);
     s->coords_index            = ngpu_pgcraft_get_uniform_index(s->crafter, "coords", NGPU_PROGRAM_STAGE_FRAG);
+    if (analytic)
+        s->segments_index      = ngpu_pgcraft_get_block_index(s->crafter, "segments", NGPU_PROGRAM_STAGE_FRAG);
 
     ret = build_uniforms_map(s);
     if (ret < 0)
@@ -304,6 +445,264 @@ static int drawpath_init(struct ngl_node *node)
     return 0;
 }
 
+/*
+ * Number of lines needed to approximate a segment within the tolerance,
+ * following Wang's formula
+ */
+static int32_t get_nb_subdivisions(const struct path_segment *segment)
+{
+    if (segment->degree < 2)
+        return 1;
+
+    const float *x = segment->bezier_x;
+    const float *y = segment->bezier_y;
+    float max_dd = 0.f;
+    for (int32_t i = 0; i + 2 <= segment->degree; i++) {
+        const float ddx = x[i] - 2.f * x[i + 1] + x[i + 2];
+        const float ddy = y[i] - 2.f * y[i + 1] + y[i + 2];
+        max_dd = NGLI_MAX(max_dd, hypotf(ddx, ddy));
+    }
+
+    const float d = (float)segment->degree;
+    const float n = ceilf(sqrtf(d * (d - 1.f) / 8.f * max_dd / ANALYTIC_TOLERANCE));
+    return (int32_t)NGLI_CLAMP(n, 1.f, (float)ANALYTIC_MAX_SUBDIVISIONS);
+}
+
+static void eval_bezier(const struct path_segment *segment, float t, float *dst)
+{
+    const float *x = segment->bezier_x;
+    const float *y = segment->bezier_y;
+    const float u = 1.f - t;
+    switch (segment->degree) {
+    case 1:
+        dst[0] = u*x[0] + t*x[1];
+        dst[1] = u*y[0] + t*y[1];
+        break;
+    case 2:
+        dst[0] = u*u*x[0] + 2.f*u*t*x[1] + t*t*x[2];
+        dst[1] = u*u*y[0] + 2.f*u*t*y[1] + t*t*y[2];
+        break;
+    case 3:
+        dst[0] = u*u*u*x[0] + 3.f*u*u*t*x[1] + 3.f*u*t*t*x[2] + t*t*t*x[3];
+        dst[1] = u*u*u*y[0] + 3.f*u*u*t*y[1] + 3.f*u*t*t*y[2] + t*t*t*y[3];
+        break;
+    default:
+        ngli_assert(0);
+    }
+}
+
+static int flatten_path(struct drawpath_priv *s)
+{
+    ngli_darray_clear(&s->lines);
+
+    const struct darray *segments_array = ngli_path_get_segments(s->path);
+    const struct path_segment *segments = ngli_darray_data(segments_array);
+    size_t group_start = 0;
+    for (size_t i = 0; i < ngli_darray_count(segments_array); i++) {
+        const struct path_segment *segment = &segments[i];
+
+        const int32_t n = get_nb_subdivisions(segment);
+        float prev[2] = {segment->bezier_x[0], segment->bezier_y[0]};
+        for (int32_t k = 1; k <= n; k++) {
+            float cur[2];
+            eval_bezier(segment, (float)k / (float)n, cur);
+            const struct line line = {prev[0], prev[1], cur[0], cur[1], 0};
+            if (!ngli_darray_push(&s->lines, &line))
+                return NGL_ERROR_MEMORY;
+            memcpy(prev, cur, sizeof(prev));
+        }
+
+        /* Only the closed sub-paths define an inside, like the distance map */
+        if (segment->flags & (NGLI_PATH_SEGMENT_FLAG_CLOSING | NGLI_PATH_SEGMENT_FLAG_OPEN_END)) {
+            const int closed = (segment->flags & NGLI_PATH_SEGMENT_FLAG_CLOSING) != 0;
+            struct line *lines = ngli_darray_data(&s->lines);
+            const size_t nb_lines = ngli_darray_count(&s->lines);
+            for (size_t j = group_start; j < nb_lines; j++)
+                lines[j].winding = closed;
+            group_start = nb_lines;
+        }
+    }
+
+    return 0;
+}
+
+static int push_band_lines(struct drawpath_priv *s, float y0, float y1, int winding)
+{
+    const struct line *lines = ngli_darray_data(&s->lines);
+    for (size_t i = 0; i < ngli_darray_count(&s->lines); i++) {
+        const struct line *line = &lines[i];
+        if (line->winding != winding ||
+            NGLI_MAX(line->y0, line->y1) < y0 ||
+            NGLI_MIN(line->y0, line->y1) > y1)
+            continue;
+        const float band_line[] = {line->x0, line->y0, line->x1, line->y1};
+        if (!ngli_darray_push(&s->band_lines, band_line))
+            return NGL_ERROR_MEMORY;
+    }
+    return 0;
+}
+
+/*
+ * Dispatch the lines into horizontal bands covering the quad, the lines
+ * contributing to the winding number first
+ */
+static int bin_lines(struct drawpath_priv *s)
+{
+    ngli_darray_clear(&s->band_lines);
+
+    const size_t nb_lines = ngli_darray_count(&s->lines);
+    s->nb_bands = (int32_t)NGLI_CLAMP(nb_lines / ANALYTIC_LINES_PER_BAND, 1, ANALYTIC_MAX_BANDS);
+
+    const float band_h = (s->atlas_coords.y1 - s->atlas_coords.y0) / (float)s->nb_bands;
+    for (int32_t i = 0; i < s->nb_bands; i++) {
+        const float y0 = s->atlas_coords.y0 + (float)i * band_h - s->margin;
+        const float y1 = y0 + band_h + 2.f * s->margin;
+
+        const size_t offset = ngli_darray_count(&s->band_lines);
+        int ret = push_band_lines(s, y0, y1, 1);
+        if (ret < 0)
+            return ret;
+        const size_t nb_winding = ngli_darray_count(&s->band_lines) - offset;
+        ret = push_band_lines(s, y0, y1, 0);
+        if (ret < 0)
+            return ret;
+        const size_t count = ngli_darray_count(&s->band_lines) - offset;
+
+        s->bands[i][0] = (int32_t)offset;
+        s->bands[i][1] = (int32_t)nb_winding;
+        s->bands[i][2] = (int32_t)count;
+        s->bands[i][3] = 0;
+    }
+
+    /* The variadic array of the block can not be empty */
+    if (!ngli_darray_count(&s->band_lines)) {
+        static const float dummy_line[4] = {0};
+        if (!ngli_darray_push(&s->band_lines, dummy_line))
+            return NGL_ERROR_MEMORY;
+    }
+
+    return 0;
+}
+
+static int upload_segments(struct ngl_node *node)
+{
+    struct drawpath_priv *s = node->priv_data;
+    struct ngpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
+
+    const size_t nb_band_lines = ngli_darray_count(&s->band_lines);
+    const size_t size = ngpu_block_desc_get_size(&s->segments_block, nb_band_lines);
+
+    /* Grow the buffer with some headroom to absorb the path changes */
+    if (!s->segments_buffer || size > s->segments_buffer->size) {
+        ngpu_buffer_freep(&s->segments_buffer);
+        ngli_freep(&s->segments_data);
+
+        const size_t capacity = ngpu_block_desc_get_size(&s->segments_block, nb_band_lines + nb_band_lines / 2);
+        s->segments_data = ngli_calloc(1, capacity);
+        if (!s->segments_data)
+            return NGL_ERROR_MEMORY;
+
+        s->segments_buffer = ngpu_buffer_create(gpu_ctx);
+        if (!s->segments_buffer)
+            return NGL_ERROR_MEMORY;
+
+        int ret = ngpu_buffer_init(s->segments_buffer, capacity,
+                                   NGPU_BUFFER_USAGE_STORAGE_BUFFER_BIT | NGPU_BUFFER_USAGE_TRANSFER_DST_BIT);
+        if (ret < 0)
+            return ret;
+
+        s->segments_buffer_rev++;
+    }
+
+    const void *data_src[] = {&s->nb_bands, &s->margin, s->bands};
+    const struct ngpu_block_field *fields = ngli_darray_data(&s->segments_block.fields);
+    for (size_t i = 0; i < NGLI_ARRAY_NB(data_src); i++)
+        ngpu_block_field_copy(&fields[i], s->segments_data + fields[i].offset, data_src[i]);
+
+    /* The variadic field has no offset in the block description: it starts right after the fixed fields */
+    const size_t lines_offset = ngpu_block_desc_get_size(&s->segments_block, 0);
+    memcpy(s->segments_data + lines_offset, ngli_darray_data(&s->band_lines), nb_band_lines * 4 * sizeof(float));
+
+    return ngpu_buffer_replace(s->segments_buffer, s->segments_data);
+}
+
+/*
+ * Distance up to which the signed distance must be exact to honor the
+ * outline, glow and blur effects
+ */
+static float get_margin(const struct drawpath_opts *o)
+{
+    const float outline = *(const float *)ngli_node_get_data_ptr(o->outline_node, &o->outline);
+    const float glow    = *(const float *)ngli_node_get_data_ptr(o->glow_node, &o->glow);
+    const float blur    = *(const float *)ngli_node_get_data_ptr(o->blur_node, &o->blur);
+    const float margin  = NGLI_MAX(outline, 0.f) + NGLI_MAX(blur, 0.f)
+                        + (glow > 0.f ? ANALYTIC_GLOW_REACH : 0.f) + ANALYTIC_AA_MARGIN;
+
+    /* Quantize the margin to avoid re-binning on every small variation */
+    return ceilf(margin / ANALYTIC_AA_MARGIN) * ANALYTIC_AA_MARGIN;
+}
+
+static int load_path(struct ngl_node *node, const struct path *src_path)
+{
+    struct drawpath_priv *s = node->priv_data;
+    const struct drawpath_opts *o = node->opts;
+
+    ngli_path_clear(s->path);
+    int ret = ngli_path_add_path(s->path, src_path);
+    if (ret < 0)
+        return ret;
+
+    const struct ngli_box vb = {NGLI_ARG_VEC4(o->viewbox)};
+    const NGLI_ALIGNED_MAT(path_transform) = {
+        1.f/vb.w, 0.f, 0.f, 0.f,
+        0.f, 1.f/vb.h, 0.f, 0.f,
+        0.f, 0.f, 1.f, 0.f,
+        -vb.x/vb.w, -vb.y/vb.h, 0.f, 1.f,
+    };
+    ngli_path_transform(s->path, path_transform);
+
+    ret = ngli_path_finalize(s->path);
+    if (ret < 0)
+        return ret;
+
+    return flatten_path(s);
+}
+
+static int drawpath_update(struct ngl_node *node, double t)
+{
+    struct drawpath_priv *s = node->priv_data;
+    const struct drawpath_opts *o = node->opts;
+
+    int ret = ngli_node_update_children(node, t);
+    if (ret < 0)
+        return ret;
+
+    if (o->mode != PATH_MODE_ANALYTIC)
+        return 0;
+
+    const struct path *src_path = *(struct path **)o->path_node->priv_data;
+    const uint32_t src_path_rev = ngli_path_get_revision(src_path);
+    const int path_changed = src_path != s->src_path || src_path_rev != s->src_path_rev;
+    const float margin = get_margin(o);
+    if (!path_changed && margin == s->margin)
+        return 0;
+
+    if (path_changed) {
+        ret = load_path(node, src_path);
+        if (ret < 0)
+            return ret;
+        s->src_path = src_path;
+        s->src_path_rev = src_path_rev;
+    }
+
+    s->margin = margin;
+    ret = bin_lines(s);
+    if (ret < 0)
+        return ret;
+
+    return upload_segments(node);
+}
+
 static int drawpath_prepare(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -315,6 +714,7 @@ static int drawpath_prepare(struct ngl_node *node)
     if (!desc)
         return NGL_ERROR_MEMORY;
     rnode->id = ngli_darray_count(&s->pipeline_descs) - 1;
+    desc->segments_buffer_rev = SIZE_MAX;
 
     struct ngpu_graphics_state state = rnode->graphics_state;
     int ret = ngli_blending_apply_preset(&state, NGLI_BLENDING_SRC_OVER);
@@ -354,6 +754,17 @@ static void drawpath_draw(struct ngl_node *node)
     struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
     struct pipeline_desc *desc = &descs[ctx->rnode_pos->id];
     struct pipeline_compat *pl_compat = desc->pipeline_compat;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+
+    struct ngpu_scissor scissor;
+    const float bmin[3] = {s->vertices[0], s->vertices[1], 0.f};
+    const float bmax[3] = {s->vertices[2], s->vertices[3], 0.f};
+    if (ngli_culling_clip_box(ctx, bmin, bmax, &scissor)) {
+        if (!ngpu_ctx_is_render_pass_active(gpu_ctx))
+            ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
+        node->cull_count++;
+        return;
+    }
 
     const float *modelview_matrix  = ngli_darray_tail(&ctx->modelview_matrix_stack);
     const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
@@ -364,17 +775,22 @@ static void drawpath_draw(struct ngl_node *node)
 
     ngli_pipeline_compat_update_uniform(desc->pipeline_compat, s->coords_index, (const float *)&s->atlas_coords);
 
+    if (s->segments_buffer && desc->segments_buffer_rev != s->segments_buffer_rev) {
+        ngli_pipeline_compat_update_buffer(pl_compat, s->segments_index, s->segments_buffer, 0, 0);
+        desc->segments_buffer_rev = s->segments_buffer_rev;
+    }
+
     const struct uniform_map *map = ngli_darray_data(&s->uniforms_map);
     for (size_t i = 0; i < ngli_darray_count(&s->uniforms_map); i++)
         ngli_pipeline_compat_update_uniform(pl_compat, map[i].index, map[i].data);
 
-    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
     if (!ngpu_ctx_is_render_pass_active(gpu_ctx)) {
         ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
     }
 
     ngpu_ctx_set_viewport(gpu_ctx, &ctx->viewport);
-    ngpu_ctx_set_scissor(gpu_ctx, &ctx->scissor);
+    ngpu_ctx_set_scissor(gpu_ctx, &scissor);
+    ngli_rtt_add_content_area(ctx, &scissor);
 
     ngli_pipeline_compat_draw(desc->pipeline_compat, 4, 1, 0);
 }
@@ -392,6 +808,11 @@ static void drawpath_uninit(struct ngl_node *node)
     ngpu_pgcraft_freep(&s->crafter);
     ngli_distmap_freep(&s->distmap);
     ngli_path_freep(&s->path);
+    ngli_darray_reset(&s->lines);
+    ngli_darray_reset(&s->band_lines);
+    ngpu_block_desc_reset(&s->segments_block);
+    ngli_freep(&s->segments_data);
+    ngpu_buffer_freep(&s->segments_buffer);
     ngli_darray_reset(&s->pipeline_descs);
 }
 
@@ -400,7 +821,7 @@ const struct node_class ngli_drawpath_class = {
     .name      = "DrawPath",
     .init      = drawpath_init,
     .prepare   = drawpath_prepare,
-    .update    = ngli_node_update_children,
+    .update    = drawpath_update,
     .draw      = drawpath_draw,
     .uninit    = drawpath_uninit,
     .opts_size = sizeof(struct drawpath_opts),
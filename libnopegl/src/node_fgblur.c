@@ -36,6 +36,7 @@
 #include "nopegl.h"
 #include "pipeline_compat.h"
 #include "rtt.h"
+#include "rtt_pool.h"
 #include "ngpu/pgcraft.h"
 #include "utils/bits.h"
 #include "utils/utils.h"
@@ -75,11 +76,12 @@ struct fgblur_priv {
     uint32_t max_lod;
     float blurriness;
 
-    /* Intermediates Mips used by the blur passses */
+    /*
+     * Intermediates Mips used by the blur passses, acquired from the context
+     * transient render target pool for the duration of the draw
+     */
     struct ngpu_rendertarget_layout mip_layout;
-
-    struct rtt_ctx *mip;
-    struct rtt_ctx *mips[MAX_MIP_LEVELS];
+    struct ngpu_texture_params mip_params[MAX_MIP_LEVELS];
 
     struct ngpu_block down_up_data_block;
 
@@ -382,39 +384,9 @@ static int resize(struct ngl_node *node)
                          NGPU_TEXTURE_USAGE_SAMPLED_BIT,
     };
 
-    struct rtt_ctx *mip = NULL;
-    struct rtt_ctx *mips[MAX_MIP_LEVELS] = {0};
-
     struct ngpu_texture *dst = NULL;
     struct rtt_ctx *dst_rtt_ctx = NULL;
 
-    mip = ngli_rtt_create(ctx);
-    if (!mip)
-        return NGL_ERROR_MEMORY;
-
-    ret = ngli_rtt_from_texture_params(mip, &texture_params);
-    if (ret < 0)
-        goto fail;
-
-    uint32_t mip_width = width;
-    uint32_t mip_height = height;
-    for (size_t i = 0; i < MAX_MIP_LEVELS; i++) {
-        mips[i] = ngli_rtt_create(ctx);
-        if (!mips[i]) {
-            ret = NGL_ERROR_MEMORY;
-            goto fail;
-        }
-
-        texture_params.width = mip_width;
-        texture_params.height = mip_height;
-        ret = ngli_rtt_from_texture_params(mips[i], &texture_params);
-        if (ret < 0)
-            goto fail;
-
-        mip_width = NGLI_MAX(mip_width >> 1, 1);
-        mip_height = NGLI_MAX(mip_height >> 1, 1);
-    }
-
     dst = dst_info->texture;
     if (s->dst_is_resizable) {
         dst = ngpu_texture_create(ctx->gpu_ctx);
@@ -452,12 +424,15 @@ static int resize(struct ngl_node *node)
     if (ret < 0)
         goto fail;
 
-    ngli_rtt_freep(&s->mip);
-    s->mip = mip;
-
+    uint32_t mip_width = width;
+    uint32_t mip_height = height;
     for (size_t i = 0; i < MAX_MIP_LEVELS; i++) {
-        ngli_rtt_freep(&s->mips[i]);
-        s->mips[i] = mips[i];
+        texture_params.width = mip_width;
+        texture_params.height = mip_height;
+        s->mip_params[i] = texture_params;
+
+        mip_width = NGLI_MAX(mip_width >> 1, 1);
+        mip_height = NGLI_MAX(mip_height >> 1, 1);
     }
 
     if (s->dst_is_resizable) {
@@ -487,10 +462,6 @@ static int resize(struct ngl_node *node)
     return 0;
 
 fail:
-    ngli_rtt_freep(&mip);
-    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
-        ngli_rtt_freep(&mips[i]);
-
     ngli_rtt_freep(&dst_rtt_ctx);
     if (s->dst_is_resizable)
         ngpu_texture_freep(&dst);
@@ -502,10 +473,12 @@ fail:
 static void execute_down_up_pass(struct ngl_ctx *ctx,
                                  struct rtt_ctx *rtt_ctx,
                                  struct pipeline_compat *pipeline,
-                                 const struct image *image)
+                                 const struct image *image,
+                                 const struct ngli_aabb *area)
 {
     ngli_rtt_begin(rtt_ctx);
     ngpu_ctx_begin_render_pass(ctx->gpu_ctx, ctx->current_rendertarget);
+    ngli_rtt_set_area(rtt_ctx, area);
     ngli_pipeline_compat_update_image(pipeline, 0, image);
     ngli_pipeline_compat_draw(pipeline, 3, 1, 0);
     ngli_rtt_end(rtt_ctx);
@@ -556,15 +529,41 @@ static void fgblur_draw(struct ngl_node *node)
     const int32_t lod_i = (int32_t)lod;
     const float lod_f = lod - (float)lod_i;
 
+    /*
+     * Every pass reads a couple of texels of the coarsest level around each
+     * destination texel, so the content of the source cannot spread further
+     * than a few texels of mips[lod_i+1]
+     */
+    struct ngli_aabb area;
+    const float margin = (float)(8U << (lod_i + 1));
+    ngli_node_texture_get_content_area(o->source, margin, &area);
+
+    /*
+     * Only the mips up to lod_i+1 are needed for the requested amount of
+     * blurriness
+     */
+    struct rtt_ctx *mip_rtt_ctx = NULL;
+    struct rtt_ctx *mips[MAX_MIP_LEVELS] = {0};
+    for (int32_t i = 0; i <= lod_i + 1; i++) {
+        mips[i] = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->mip_params[i], 1);
+        if (!mips[i])
+            goto end;
+    }
+    if (lod_i > 0) {
+        mip_rtt_ctx = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->mip_params[0], 1);
+        if (!mip_rtt_ctx)
+            goto end;
+    }
+
     /* Downsample source to mips[1] */
     struct texture_info *src_info = o->source->priv_data;
     const struct image *src_image = &src_info->image;
     const struct image *mip = src_image;
-    execute_down_up_pass(ctx, s->mips[1], s->dws.pl, mip);
+    execute_down_up_pass(ctx, mips[1], s->dws.pl, mip, &area);
 
     /* Downsample successively until mips[lod_i+1] is generated */
     for (int32_t i = 2; i <= lod_i + 1; i++)
-        execute_down_up_pass(ctx, s->mips[i], s->dws.pl, ngli_rtt_get_image(s->mips[i - 1], 0));
+        execute_down_up_pass(ctx, mips[i], s->dws.pl, ngli_rtt_get_image(mips[i - 1], 0), &area);
 
     /*
      * Upsample successively from mips[lod_i] back to full resolution and store
@@ -572,9 +571,9 @@ static void fgblur_draw(struct ngl_node *node)
      */
     if (lod_i > 0) {
         for (int32_t i = lod_i - 1; i > 0; i--)
-            execute_down_up_pass(ctx, s->mips[i], s->ups.pl, ngli_rtt_get_image(s->mips[i + 1], 0));
-        execute_down_up_pass(ctx, s->mip, s->ups.pl, ngli_rtt_get_image(s->mips[1], 0));
-        mip = ngli_rtt_get_image(s->mip, 0);
+            execute_down_up_pass(ctx, mips[i], s->ups.pl, ngli_rtt_get_image(mips[i + 1], 0), &area);
+        execute_down_up_pass(ctx, mip_rtt_ctx, s->ups.pl, ngli_rtt_get_image(mips[1], 0), &area);
+        mip = ngli_rtt_get_image(mip_rtt_ctx, 0);
     }
 
     /*
@@ -582,7 +581,7 @@ static void fgblur_draw(struct ngl_node *node)
      * store the result in mips[0]
      */
     for (int32_t i = lod_i; i >= 0; i--)
-        execute_down_up_pass(ctx, s->mips[i], s->ups.pl, ngli_rtt_get_image(s->mips[i + 1], 0));
+        execute_down_up_pass(ctx, mips[i], s->ups.pl, ngli_rtt_get_image(mips[i + 1], 0), &area);
 
     const struct interpolate_block interpolate_block = {.lod = lod_f};
     ngpu_block_update(&s->interpolate.block, 0, &interpolate_block);
@@ -593,8 +592,9 @@ static void fgblur_draw(struct ngl_node *node)
      */
     ngli_rtt_begin(s->dst_rtt_ctx);
     ngpu_ctx_begin_render_pass(ctx->gpu_ctx, ctx->current_rendertarget);
+    ngli_rtt_set_area(s->dst_rtt_ctx, &area);
     ngli_pipeline_compat_update_image(s->interpolate.pl, 0, mip);
-    ngli_pipeline_compat_update_image(s->interpolate.pl, 1, ngli_rtt_get_image(s->mips[0], 0));
+    ngli_pipeline_compat_update_image(s->interpolate.pl, 1, ngli_rtt_get_image(mips[0], 0));
     ngli_pipeline_compat_draw(s->interpolate.pl, 3, 1, 0);
     ngli_rtt_end(s->dst_rtt_ctx);
 
@@ -606,16 +606,19 @@ static void fgblur_draw(struct ngl_node *node)
     struct texture_info *dst_info = o->destination->priv_data;
     struct image *dst_image = &dst_info->image;
     memcpy(dst_image->coordinates_matrix, src_image->coordinates_matrix, sizeof(src_image->coordinates_matrix));
+    dst_info->has_content_area = 1;
+    dst_info->content_area = area;
+
+end:
+    ngli_rtt_pool_release(ctx->rtt_pool, &mip_rtt_ctx);
+    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
+        ngli_rtt_pool_release(ctx->rtt_pool, &mips[i]);
 }
 
 static void fgblur_release(struct ngl_node *node)
 {
     struct fgblur_priv *s = node->priv_data;
 
-    ngli_rtt_freep(&s->mip);
-    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
-        ngli_rtt_freep(&s->mips[i]);
-
     ngli_rtt_freep(&s->dst_rtt_ctx);
 }
 
@@ -27,6 +27,7 @@
 
 #include "internal.h"
 #include "log.h"
+#include "math_utils.h"
 #include "ngpu/block.h"
 #include "ngpu/ctx.h"
 #include "ngpu/graphics_state.h"
@@ -36,12 +37,18 @@
 #include "nopegl.h"
 #include "pipeline_compat.h"
 #include "rtt.h"
+#include "rtt_pool.h"
 #include "ngpu/pgcraft.h"
+#include "utils/bits.h"
 #include "utils/utils.h"
 
 /* GLSL shaders */
+#include "blur_common_vert.h"
+#include "blur_downsample_frag.h"
+#include "blur_gaussian_comp.h"
 #include "blur_gaussian_vert.h"
 #include "blur_gaussian_frag.h"
+#include "blur_upsample_frag.h"
 
 #define _CONSTANT_TO_STR(v) #v
 #define CONSTANT_TO_STR(v) _CONSTANT_TO_STR(v)
@@ -52,6 +59,22 @@ NGLI_STATIC_ASSERT(MAX_KERNEL_SIZE & 0x1, "kernel size is odd");
 #define MAX_RADIUS_SIZE 126
 NGLI_STATIC_ASSERT(MAX_RADIUS_SIZE == (MAX_KERNEL_SIZE - 1), "radius size");
 
+/*
+ * In mip mode, the source is downsampled until the blur radius fits in
+ * MIP_RADIUS_SIZE pixels of the downsampled level
+ */
+#define MAX_MIP_LEVELS 16
+#define MIP_RADIUS_SIZE 16
+
+enum {
+    BLUR_MODE_DIRECT,
+    BLUR_MODE_MIP,
+};
+
+struct down_up_data_block {
+    float offset;
+};
+
 struct direction_block {
     float direction[2];
 };
@@ -61,25 +84,43 @@ struct kernel_block {
     int32_t nb_weights;
 };
 
+/*
+ * The compute passes fetch every texel of the kernel from the shared tile,
+ * so they use the plain weights of the interval [0, radius] (the kernel is
+ * symmetric)
+ */
+#define COMPUTE_GROUP_SIZE 128
+
+struct compute_kernel_block {
+    float weights[MAX_RADIUS_SIZE + 1];
+    int32_t radius;
+};
+
 struct gblur_opts {
     struct ngl_node *source;
     struct ngl_node *destination;
     struct ngl_node *blurriness_node;
     float blurriness;
+    int mode;
 };
 
 struct gblur_priv {
     uint32_t width;
     uint32_t height;
-    float blurriness;
+    uint32_t max_lod;
+    float sigma;
+    int32_t radius;
 
     /* Source image */
     struct image *image;
     size_t image_rev;
 
-    /* Render the horizontal pass to a temporary destination */
+    /*
+     * Render the horizontal pass to a temporary destination, acquired from
+     * the context transient render target pool for the duration of the draw
+     */
     struct ngpu_rendertarget_layout tmp_layout;
-    struct rtt_ctx *tmp;
+    struct ngpu_texture_params tmp_params;
 
     /* Render the vertical pass to the destination */
     int dst_is_resizable;
@@ -91,6 +132,45 @@ struct gblur_priv {
     struct ngpu_pgcraft *crafter;
     struct pipeline_compat *pl_blur_h;
     struct pipeline_compat *pl_blur_v;
+
+    /*
+     * Compute variant of the direct passes, writing to storage images. It is
+     * used instead of the render passes when the source and the destination
+     * have the same dimensions.
+     */
+    int has_compute;
+    int use_compute;
+    struct ngpu_texture_params comp_tmp_params;
+    struct ngpu_block compute_kernel_block;
+    struct {
+        struct ngpu_pgcraft *crafter;
+        struct pipeline_compat *pl_h;
+        struct pipeline_compat *pl_v;
+    } comp;
+
+    /*
+     * Mip mode: intermediate mips acquired from the context transient render
+     * target pool for the duration of the draw, the blur passes are executed
+     * on the last mip with the pl_blur_h pipeline
+     */
+    struct ngpu_texture_params mip_params[MAX_MIP_LEVELS];
+    struct ngpu_block down_up_data_block;
+    struct {
+        struct ngpu_pgcraft *crafter;
+        struct pipeline_compat *pl;
+    } dws, ups, ups_dst;
+};
+
+static const struct param_choices mode_choices = {
+    .name = "blur_mode",
+    .consts = {
+        {"direct", BLUR_MODE_DIRECT, .desc=NGLI_DOCSTRING("apply the kernel on the full resolution source, "
+                                                          "with a cost proportional to the blur radius")},
+        {"mip",    BLUR_MODE_MIP,    .desc=NGLI_DOCSTRING("apply the kernel on a downsampled level of the source "
+                                                          "matching the blur radius, with a cost roughly "
+                                                          "independent of the blur radius")},
+        {NULL}
+    }
 };
 
 #define OFFSET(x) offsetof(struct gblur_opts, x)
@@ -106,39 +186,43 @@ static const struct node_param gblur_params[] = {
     {"blurriness",        NGLI_PARAM_TYPE_F32, OFFSET(blurriness_node), {.f32=0.03f},
                           .flags=NGLI_PARAM_FLAG_ALLOW_NODE,
                           .desc=NGLI_DOCSTRING("amount of blurriness in the range [0,1] "
-                                               "where 1 is equivalent of a blur radius of " CONSTANT_TO_STR(MAX_RADIUS_SIZE) "px")},
+                                               "where 1 is equivalent of a blur radius of " CONSTANT_TO_STR(MAX_RADIUS_SIZE) "px "
+                                               "(values above 1 are only honored in mip mode)")},
+    {"mode",              NGLI_PARAM_TYPE_SELECT, OFFSET(mode), {.i32=BLUR_MODE_DIRECT},
+                          .choices=&mode_choices,
+                          .desc=NGLI_DOCSTRING("blur implementation")},
     {NULL}
 };
 
 #define O(i) (2 * (i))
 #define W(i) (2 * (i) + 1)
 
-static int update_kernel(struct ngl_node *node)
+/*
+ * Compute sigma for a given precision (1e-3f should be fine for up to 10-bit
+ * image formats).
+ * See:
+ * - https://en.wikipedia.org/wiki/Talk%3AGaussian_blur#Radius_again
+ * - https://en.wikipedia.org/wiki/68%E2%80%9395%E2%80%9399.7_rule
+ */
+static float radius_to_sigma(float radius)
 {
-    struct gblur_priv *s = node->priv_data;
-    const struct gblur_opts *o = node->opts;
-
-    const float blurriness = *(float *)ngli_node_get_data_ptr(o->blurriness_node, &o->blurriness);
-    if (blurriness < 0.0)
-        return NGL_ERROR_INVALID_ARG;
+    return (radius + 1.f) / sqrtf(-2.f * logf(1e-3f));
+}
 
-    if (s->blurriness == blurriness)
-        return 0;
+static float sigma_to_radius(float sigma)
+{
+    return sigma * sqrtf(-2.f * logf(1e-3f)) - 1.f;
+}
 
-    s->blurriness = blurriness;
+static int update_kernel(struct ngl_node *node, float sigma, int32_t radius)
+{
+    struct gblur_priv *s = node->priv_data;
 
-    const float radius_f = NGLI_CLAMP(blurriness, 0.f, 1.f) * (float)MAX_RADIUS_SIZE;
-    const int32_t radius_i = (int32_t)ceil(radius_f);
-    const int32_t radius = NGLI_MIN(radius_i, MAX_RADIUS_SIZE);
+    if (s->sigma == sigma && s->radius == radius)
+        return 0;
 
-    /*
-     * Compute sigma for a given precision (1e-3f should be fine for up to
-     * 10-bit image formats).
-     * See:
-     * - https://en.wikipedia.org/wiki/Talk%3AGaussian_blur#Radius_again
-     * - https://en.wikipedia.org/wiki/68%E2%80%9395%E2%80%9399.7_rule
-     */
-    const float sigma = (radius_f + 1.f) / sqrtf(-2.f * logf(1e-3f));
+    s->sigma = sigma;
+    s->radius = radius;
 
     /*
      * Compute the weights for the interval [-radius, radius].
@@ -187,6 +271,14 @@ static int update_kernel(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
+    if (s->has_compute) {
+        struct compute_kernel_block compute_kernel_block = {.radius = radius};
+        memcpy(compute_kernel_block.weights, weights + radius, (size_t)(radius + 1) * sizeof(*weights));
+        ret = ngpu_block_update(&s->compute_kernel_block, 0, &compute_kernel_block);
+        if (ret < 0)
+            return ret;
+    }
+
     return 0;
 }
 
@@ -214,6 +306,213 @@ static int setup_pipeline(struct ngpu_pgcraft *crafter, struct pipeline_compat *
     return 0;
 }
 
+static int setup_down_up_pipeline(struct ngpu_pgcraft *crafter,
+                                  const char *name,
+                                  const char *frag_base,
+                                  struct pipeline_compat *pipeline,
+                                  const struct ngpu_rendertarget_layout *layout,
+                                  struct ngpu_block *block)
+{
+    const struct ngpu_pgcraft_iovar vert_out_vars[] = {
+        {.name = "tex_coord", .type = NGPU_TYPE_VEC2},
+    };
+
+    const struct ngpu_pgcraft_texture textures[] = {
+        {
+            .name      = "tex",
+            .type      = NGPU_PGCRAFT_TEXTURE_TYPE_2D,
+            .precision = NGPU_PRECISION_HIGH,
+            .stage     = NGPU_PROGRAM_STAGE_FRAG,
+        },
+    };
+
+    const struct ngpu_pgcraft_block blocks[] = {
+        {
+            .name          = "data",
+            .instance_name = "",
+            .type          = NGPU_TYPE_UNIFORM_BUFFER,
+            .stage         = NGPU_PROGRAM_STAGE_FRAG,
+            .block         = &block->block_desc,
+            .buffer        = {
+                .buffer    = block->buffer,
+                .size      = block->block_size,
+            },
+        }
+    };
+
+    const struct ngpu_pgcraft_params crafter_params = {
+        .program_label    = name,
+        .vert_base        = blur_common_vert,
+        .frag_base        = frag_base,
+        .textures         = textures,
+        .nb_textures      = NGLI_ARRAY_NB(textures),
+        .blocks           = blocks,
+        .nb_blocks        = NGLI_ARRAY_NB(blocks),
+        .vert_out_vars    = vert_out_vars,
+        .nb_vert_out_vars = NGLI_ARRAY_NB(vert_out_vars),
+    };
+
+    int ret = ngpu_pgcraft_craft(crafter, &crafter_params);
+    if (ret < 0)
+        return ret;
+
+    return setup_pipeline(crafter, pipeline, layout);
+}
+
+static int setup_compute_pipeline(struct ngpu_pgcraft *crafter, struct pipeline_compat *pipeline)
+{
+    const struct pipeline_compat_params params = {
+        .type        = NGPU_PIPELINE_TYPE_COMPUTE,
+        .program     = ngpu_pgcraft_get_program(crafter),
+        .layout_desc = ngpu_pgcraft_get_bindgroup_layout_desc(crafter),
+        .resources   = ngpu_pgcraft_get_bindgroup_resources(crafter),
+        .compat_info = ngpu_pgcraft_get_compat_info(crafter),
+    };
+
+    return ngli_pipeline_compat_init(pipeline, &params);
+}
+
+/*
+ * Only the formats every implementation supporting compute shaders must
+ * support as storage images are considered
+ */
+static int is_storage_format(enum ngpu_format format)
+{
+    return format == NGPU_FORMAT_R8G8B8A8_UNORM ||
+           format == NGPU_FORMAT_R16G16B16A16_SFLOAT ||
+           format == NGPU_FORMAT_R32G32B32A32_SFLOAT;
+}
+
+static int init_compute_passes(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    struct gblur_priv *s = node->priv_data;
+
+    const struct ngpu_block_entry compute_kernel_block_fields[] = {
+        NGPU_BLOCK_FIELD(struct compute_kernel_block, weights, NGPU_TYPE_F32, MAX_RADIUS_SIZE + 1),
+        NGPU_BLOCK_FIELD(struct compute_kernel_block, radius,  NGPU_TYPE_I32, 0),
+    };
+    const struct ngpu_block_params compute_kernel_block_params = {
+        .entries    = compute_kernel_block_fields,
+        .nb_entries = NGLI_ARRAY_NB(compute_kernel_block_fields),
+    };
+    int ret = ngpu_block_init(gpu_ctx, &s->compute_kernel_block, &compute_kernel_block_params);
+    if (ret < 0)
+        return ret;
+
+    const struct ngpu_pgcraft_texture textures[] = {
+        {
+            .name      = "tex",
+            .type      = NGPU_PGCRAFT_TEXTURE_TYPE_2D,
+            .precision = NGPU_PRECISION_HIGH,
+            .stage     = NGPU_PROGRAM_STAGE_COMP,
+        }, {
+            .name      = "dst",
+            .type      = NGPU_PGCRAFT_TEXTURE_TYPE_IMAGE_2D,
+            .precision = NGPU_PRECISION_HIGH,
+            .stage     = NGPU_PROGRAM_STAGE_COMP,
+            .writable  = 1,
+            .format    = s->dst_layout.colors[0].format,
+        },
+    };
+
+    const struct ngpu_pgcraft_block crafter_blocks[] = {
+        {
+            .name          = "direction",
+            .type          = NGPU_TYPE_UNIFORM_BUFFER_DYNAMIC,
+            .stage         = NGPU_PROGRAM_STAGE_COMP,
+            .block         = &s->direction_block.block_desc,
+            .buffer        = {
+                .buffer = s->direction_block.buffer,
+                .size   = s->direction_block.block_size,
+            },
+        }, {
+            .name          = "kernel",
+            .type          = NGPU_TYPE_UNIFORM_BUFFER,
+            .stage         = NGPU_PROGRAM_STAGE_COMP,
+            .block         = &s->compute_kernel_block.block_desc,
+            .buffer        = {
+                .buffer = s->compute_kernel_block.buffer,
+                .size   = s->compute_kernel_block.block_size,
+            },
+        },
+    };
+
+    const struct ngpu_pgcraft_params crafter_params = {
+        .program_label  = "nopegl/gaussian-blur-compute",
+        .comp_base      = blur_gaussian_comp,
+        .textures       = textures,
+        .nb_textures    = NGLI_ARRAY_NB(textures),
+        .blocks         = crafter_blocks,
+        .nb_blocks      = NGLI_ARRAY_NB(crafter_blocks),
+        .workgroup_size = {COMPUTE_GROUP_SIZE, 1, 1},
+    };
+
+    s->comp.crafter = ngpu_pgcraft_create(gpu_ctx);
+    if (!s->comp.crafter)
+        return NGL_ERROR_MEMORY;
+
+    ret = ngpu_pgcraft_craft(s->comp.crafter, &crafter_params);
+    if (ret < 0)
+        return ret;
+
+    s->comp.pl_h = ngli_pipeline_compat_create(gpu_ctx);
+    s->comp.pl_v = ngli_pipeline_compat_create(gpu_ctx);
+    if (!s->comp.pl_h || !s->comp.pl_v)
+        return NGL_ERROR_MEMORY;
+
+    if ((ret = setup_compute_pipeline(s->comp.crafter, s->comp.pl_h)) < 0 ||
+        (ret = setup_compute_pipeline(s->comp.crafter, s->comp.pl_v)) < 0)
+        return ret;
+
+    return 0;
+}
+
+static int init_mip_passes(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    struct gblur_priv *s = node->priv_data;
+
+    const struct ngpu_block_entry down_up_data_block_fields[] = {
+        NGPU_BLOCK_FIELD(struct down_up_data_block, offset, NGPU_TYPE_F32, 0),
+    };
+    const struct ngpu_block_params down_up_data_block_params = {
+        .entries    = down_up_data_block_fields,
+        .nb_entries = NGLI_ARRAY_NB(down_up_data_block_fields),
+    };
+    int ret = ngpu_block_init(gpu_ctx, &s->down_up_data_block, &down_up_data_block_params);
+    if (ret < 0)
+        return ret;
+
+    ret = ngpu_block_update(&s->down_up_data_block, 0, &(struct down_up_data_block){.offset=1.f});
+    if (ret < 0)
+        return ret;
+
+    s->dws.crafter = ngpu_pgcraft_create(gpu_ctx);
+    s->ups.crafter = ngpu_pgcraft_create(gpu_ctx);
+    s->ups_dst.crafter = ngpu_pgcraft_create(gpu_ctx);
+    if (!s->dws.crafter || !s->ups.crafter || !s->ups_dst.crafter)
+        return NGL_ERROR_MEMORY;
+
+    s->dws.pl = ngli_pipeline_compat_create(gpu_ctx);
+    s->ups.pl = ngli_pipeline_compat_create(gpu_ctx);
+    s->ups_dst.pl = ngli_pipeline_compat_create(gpu_ctx);
+    if (!s->dws.pl || !s->ups.pl || !s->ups_dst.pl)
+        return NGL_ERROR_MEMORY;
+
+    if ((ret = setup_down_up_pipeline(s->dws.crafter, "nopegl/gaussian-blur-dws", blur_downsample_frag,
+                                      s->dws.pl, &s->tmp_layout, &s->down_up_data_block)) < 0 ||
+        (ret = setup_down_up_pipeline(s->ups.crafter, "nopegl/gaussian-blur-ups", blur_upsample_frag,
+                                      s->ups.pl, &s->tmp_layout, &s->down_up_data_block)) < 0 ||
+        (ret = setup_down_up_pipeline(s->ups_dst.crafter, "nopegl/gaussian-blur-ups", blur_upsample_frag,
+                                      s->ups_dst.pl, &s->dst_layout, &s->down_up_data_block)) < 0)
+        return ret;
+
+    return 0;
+}
+
 static int gblur_init(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -244,6 +543,10 @@ static int gblur_init(struct ngl_node *node)
     s->dst_layout.colors[0].format = dst_info->params.format;
     s->dst_layout.nb_colors = 1;
 
+    s->has_compute = (gpu_ctx->features & NGPU_FEATURE_COMPUTE) && is_storage_format(dst_info->params.format);
+    if (s->has_compute)
+        dst_info->params.usage |= NGPU_TEXTURE_USAGE_STORAGE_BIT;
+
     const struct ngpu_block_entry direction_block_fields[] = {
         NGPU_BLOCK_FIELD(struct direction_block, direction, NGPU_TYPE_VEC2, 0),
     };
@@ -331,6 +634,18 @@ static int gblur_init(struct ngl_node *node)
         (ret = setup_pipeline(s->crafter, s->pl_blur_v, &s->dst_layout)) < 0)
         return ret;
 
+    if (s->has_compute) {
+        ret = init_compute_passes(node);
+        if (ret < 0)
+            return ret;
+    }
+
+    if (o->mode == BLUR_MODE_MIP) {
+        ret = init_mip_passes(node);
+        if (ret < 0)
+            return ret;
+    }
+
     return 0;
 }
 
@@ -356,12 +671,10 @@ static int resize(struct ngl_node *node)
     struct texture_info *dst_info = o->destination->priv_data;
     ngli_assert(dst_info->params.format == s->dst_layout.colors[0].format);
 
-    struct rtt_ctx *tmp = NULL;
-
     struct ngpu_texture *dst = NULL;
     struct rtt_ctx *dst_rtt_ctx = NULL;
 
-    const struct ngpu_texture_params texture_params = {
+    const struct ngpu_texture_params tmp_params = {
         .type          = NGPU_TEXTURE_TYPE_2D,
         .format        = src_info->params.format,
         .width         = width,
@@ -374,16 +687,6 @@ static int resize(struct ngl_node *node)
                          NGPU_TEXTURE_USAGE_SAMPLED_BIT,
     };
 
-    tmp = ngli_rtt_create(ctx);
-    if (!tmp) {
-        ret = NGL_ERROR_MEMORY;
-        goto fail;
-    }
-
-    ret = ngli_rtt_from_texture_params(tmp, &texture_params);
-    if (ret < 0)
-        goto fail;
-
     dst = dst_info->texture;
     if (s->dst_is_resizable) {
         dst = ngpu_texture_create(ctx->gpu_ctx);
@@ -400,9 +703,6 @@ static int resize(struct ngl_node *node)
             goto fail;
     }
 
-    ngli_rtt_freep(&s->tmp);
-    s->tmp = tmp;
-
     if (s->dst_is_resizable) {
         ngpu_texture_freep(&dst_info->texture);
         dst_info->texture = dst;
@@ -436,17 +736,36 @@ static int resize(struct ngl_node *node)
     ngli_rtt_freep(&s->dst_rtt_ctx);
     s->dst_rtt_ctx = dst_rtt_ctx;
 
+    s->tmp_params = tmp_params;
     s->width = width;
     s->height = height;
 
+    /* The compute passes operate on texels and thus can not rescale */
+    s->use_compute = s->has_compute && dst->params.width == width && dst->params.height == height;
+    s->comp_tmp_params = tmp_params;
+    s->comp_tmp_params.format = s->dst_layout.colors[0].format;
+    s->comp_tmp_params.usage |= NGPU_TEXTURE_USAGE_STORAGE_BIT;
+
+    uint32_t mip_width = width;
+    uint32_t mip_height = height;
+    for (size_t i = 0; i < MAX_MIP_LEVELS; i++) {
+        s->mip_params[i] = tmp_params;
+        s->mip_params[i].width = mip_width;
+        s->mip_params[i].height = mip_height;
+
+        mip_width = NGLI_MAX(mip_width >> 1, 1);
+        mip_height = NGLI_MAX(mip_height >> 1, 1);
+    }
+
+    const uint32_t max_lod = ngli_log2(NGLI_MAX(width, height));
+    s->max_lod = NGLI_MIN(max_lod, MAX_MIP_LEVELS - 1);
+
     /* Trigger a kernel update on resolution change */
-    s->blurriness = -1.f;
+    s->sigma = -1.f;
 
     return 0;
 
 fail:
-    ngli_rtt_freep(&tmp);
-
     ngli_rtt_freep(&dst_rtt_ctx);
     if (s->dst_is_resizable)
         ngpu_texture_freep(&dst);
@@ -455,22 +774,120 @@ fail:
     return ret;
 }
 
-static void gblur_draw(struct ngl_node *node)
+/*
+ * Map a normalized area of the source render target to the destination of the
+ * direct render passes, which sample the source through its coordinates
+ * matrix, while the render target areas are expressed with a bottom-up origin
+ * independently of how the backend samples the textures. Only the matrices
+ * without rotation are supported, otherwise the whole destination is used.
+ */
+static void get_direct_area(struct ngpu_ctx *gpu_ctx, const float *matrix,
+                            const struct ngli_aabb *src, struct ngli_aabb *dst)
+{
+    if (matrix[1] != 0.f || matrix[4] != 0.f || matrix[0] == 0.f || matrix[5] == 0.f) {
+        *dst = (struct ngli_aabb){0.f, 0.f, 1.f, 1.f};
+        return;
+    }
+
+    /* Render target area to texture coordinates (y flipped or not) */
+    NGLI_ALIGNED_MAT(rt_matrix);
+    ngpu_ctx_get_rendertarget_uvcoord_matrix(gpu_ctx, rt_matrix);
+    const int flip = rt_matrix[5] > 0.f;
+
+    const float src_y0 = flip ? 1.f - src->y1 : src->y0;
+    const float src_y1 = flip ? 1.f - src->y0 : src->y1;
+    const float x0 = (src->x0 - matrix[12]) / matrix[0];
+    const float x1 = (src->x1 - matrix[12]) / matrix[0];
+    const float y0 = (src_y0 - matrix[13]) / matrix[5];
+    const float y1 = (src_y1 - matrix[13]) / matrix[5];
+    const float dst_y0 = NGLI_MIN(y0, y1);
+    const float dst_y1 = NGLI_MAX(y0, y1);
+    *dst = (struct ngli_aabb){
+        .x0 = NGLI_MAX(NGLI_MIN(x0, x1), 0.f),
+        .y0 = NGLI_MAX(flip ? 1.f - dst_y1 : dst_y0, 0.f),
+        .x1 = NGLI_MIN(NGLI_MAX(x0, x1), 1.f),
+        .y1 = NGLI_MIN(flip ? 1.f - dst_y0 : dst_y1, 1.f),
+    };
+}
+
+static void draw_direct_compute(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gblur_priv *s = node->priv_data;
+    const struct gblur_opts *o = node->opts;
+
+    struct rtt_ctx *tmp = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->comp_tmp_params, 1);
+    if (!tmp)
+        return;
+
+    if (ngpu_ctx_is_render_pass_active(ctx->gpu_ctx)) {
+        ngpu_ctx_end_render_pass(ctx->gpu_ctx);
+        ctx->current_rendertarget = ctx->available_rendertargets[1];
+    }
+
+    const struct image *tmp_image = ngli_rtt_get_image(tmp, 0);
+    struct texture_info *dst_info = o->destination->priv_data;
+
+    uint32_t offset = 0;
+    ngli_pipeline_compat_update_dynamic_offsets(s->comp.pl_h, &offset, 1);
+    ngli_pipeline_compat_update_image(s->comp.pl_h, 0, s->image);
+    ngli_pipeline_compat_update_image(s->comp.pl_h, 1, tmp_image);
+    ngli_pipeline_compat_dispatch(s->comp.pl_h, NGLI_ALIGN(s->width, COMPUTE_GROUP_SIZE) / COMPUTE_GROUP_SIZE, s->height, 1);
+
+    offset = (uint32_t)s->direction_block.block_size;
+    ngli_pipeline_compat_update_dynamic_offsets(s->comp.pl_v, &offset, 1);
+    ngli_pipeline_compat_update_image(s->comp.pl_v, 0, tmp_image);
+    ngli_pipeline_compat_update_image(s->comp.pl_v, 1, &dst_info->image);
+    ngli_pipeline_compat_dispatch(s->comp.pl_v, NGLI_ALIGN(s->height, COMPUTE_GROUP_SIZE) / COMPUTE_GROUP_SIZE, s->width, 1);
+
+    ngli_rtt_pool_release(ctx->rtt_pool, &tmp);
+}
+
+static void draw_direct(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
     struct gblur_priv *s = node->priv_data;
+    const struct gblur_opts *o = node->opts;
 
-    int ret = resize(node);
-    if (ret < 0)
+    struct texture_info *dst_info = o->destination->priv_data;
+    struct image *dst_image = &dst_info->image;
+
+    /*
+     * Outside of the source content extended by the kernel radius, the result
+     * is transparent black. The horizontal pass does not spread the content
+     * vertically, so the same area can be used for both passes.
+     */
+    struct ngli_aabb area;
+    ngli_node_texture_get_content_area(o->source, (float)s->radius + 2.f, &area);
+
+    if (s->use_compute) {
+        /*
+         * The compute passes fetch the texels as they are stored, so the
+         * source coordinates matrix is forwarded to the destination
+         */
+        memcpy(dst_image->coordinates_matrix, s->image->coordinates_matrix, sizeof(s->image->coordinates_matrix));
+        draw_direct_compute(node);
+        dst_info->has_content_area = 1;
+        dst_info->content_area = area;
         return;
+    }
 
-    ret = update_kernel(node);
-    if (ret < 0)
+    /* The render passes apply the source coordinates matrix */
+    static const NGLI_ALIGNED_MAT(identity_matrix) = NGLI_MAT4_IDENTITY;
+    memcpy(dst_image->coordinates_matrix, identity_matrix, sizeof(identity_matrix));
+
+    get_direct_area(gpu_ctx, s->image->coordinates_matrix, &area, &area);
+    dst_info->has_content_area = 1;
+    dst_info->content_area = area;
+
+    struct rtt_ctx *tmp = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->tmp_params, 1);
+    if (!tmp)
         return;
 
-    ngli_rtt_begin(s->tmp);
+    ngli_rtt_begin(tmp);
     ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
+    ngli_rtt_set_area(tmp, &area);
     uint32_t offset = 0;
     ngli_pipeline_compat_update_dynamic_offsets(s->pl_blur_h, &offset, 1);
     if (s->image_rev != s->image->rev) {
@@ -478,22 +895,157 @@ static void gblur_draw(struct ngl_node *node)
         s->image_rev = s->image->rev;
     }
     ngli_pipeline_compat_draw(s->pl_blur_h, 3, 1, 0);
-    ngli_rtt_end(s->tmp);
+    ngli_rtt_end(tmp);
 
     ngli_rtt_begin(s->dst_rtt_ctx);
     ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
+    ngli_rtt_set_area(s->dst_rtt_ctx, &area);
     offset = (uint32_t)s->direction_block.block_size;
     ngli_pipeline_compat_update_dynamic_offsets(s->pl_blur_v, &offset, 1);
-    ngli_pipeline_compat_update_image(s->pl_blur_v, 0, ngli_rtt_get_image(s->tmp, 0));
+    ngli_pipeline_compat_update_image(s->pl_blur_v, 0, ngli_rtt_get_image(tmp, 0));
     ngli_pipeline_compat_draw(s->pl_blur_v, 3, 1, 0);
     ngli_rtt_end(s->dst_rtt_ctx);
+
+    ngli_rtt_pool_release(ctx->rtt_pool, &tmp);
+}
+
+static void execute_pass(struct ngl_ctx *ctx,
+                         struct rtt_ctx *rtt_ctx,
+                         struct pipeline_compat *pipeline,
+                         const struct image *image,
+                         const struct ngli_aabb *area)
+{
+    ngli_rtt_begin(rtt_ctx);
+    ngpu_ctx_begin_render_pass(ctx->gpu_ctx, ctx->current_rendertarget);
+    ngli_rtt_set_area(rtt_ctx, area);
+    ngli_pipeline_compat_update_image(pipeline, 0, image);
+    ngli_pipeline_compat_draw(pipeline, 3, 1, 0);
+    ngli_rtt_end(rtt_ctx);
+}
+
+static void draw_mip(struct ngl_node *node, uint32_t lod)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gblur_priv *s = node->priv_data;
+    const struct gblur_opts *o = node->opts;
+
+    /*
+     * The passes are restricted to the source content extended by the kernel
+     * radius at the selected level, plus the footprint of the downsample and
+     * upsample passes (a couple of texels of each level involved)
+     */
+    struct ngli_aabb area;
+    const float margin = (float)((uint32_t)(s->radius + 8) << lod);
+    ngli_node_texture_get_content_area(o->source, margin, &area);
+
+    struct texture_info *dst_info = o->destination->priv_data;
+    dst_info->has_content_area = 1;
+    dst_info->content_area = area;
+
+    struct rtt_ctx *tmp = NULL;
+    struct rtt_ctx *mips[MAX_MIP_LEVELS] = {0};
+    for (uint32_t i = 1; i <= lod; i++) {
+        mips[i] = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->mip_params[i], 1);
+        if (!mips[i])
+            goto end;
+    }
+    tmp = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->mip_params[lod], 1);
+    if (!tmp)
+        goto end;
+
+    /* Downsample the source successively until mips[lod] is generated */
+    execute_pass(ctx, mips[1], s->dws.pl, s->image, &area);
+    for (uint32_t i = 2; i <= lod; i++)
+        execute_pass(ctx, mips[i], s->dws.pl, ngli_rtt_get_image(mips[i - 1], 0), &area);
+
+    /*
+     * Blur mips[lod] horizontally into tmp and then vertically back into
+     * mips[lod]. Both passes use the same pipeline since they share the same
+     * render target layout, so the source image cached for the direct mode is
+     * invalidated.
+     */
+    uint32_t offset = 0;
+    ngli_pipeline_compat_update_dynamic_offsets(s->pl_blur_h, &offset, 1);
+    execute_pass(ctx, tmp, s->pl_blur_h, ngli_rtt_get_image(mips[lod], 0), &area);
+    offset = (uint32_t)s->direction_block.block_size;
+    ngli_pipeline_compat_update_dynamic_offsets(s->pl_blur_h, &offset, 1);
+    execute_pass(ctx, mips[lod], s->pl_blur_h, ngli_rtt_get_image(tmp, 0), &area);
+    s->image_rev = SIZE_MAX;
+
+    /* Upsample successively from mips[lod] back to the destination */
+    for (uint32_t i = lod - 1; i > 0; i--)
+        execute_pass(ctx, mips[i], s->ups.pl, ngli_rtt_get_image(mips[i + 1], 0), &area);
+    execute_pass(ctx, s->dst_rtt_ctx, s->ups_dst.pl, ngli_rtt_get_image(mips[1], 0), &area);
+
+end:
+    ngli_rtt_pool_release(ctx->rtt_pool, &tmp);
+    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
+        ngli_rtt_pool_release(ctx->rtt_pool, &mips[i]);
+}
+
+static void gblur_draw(struct ngl_node *node)
+{
+    struct gblur_priv *s = node->priv_data;
+    const struct gblur_opts *o = node->opts;
+
+    int ret = resize(node);
+    if (ret < 0)
+        return;
+
+    const float blurriness = *(float *)ngli_node_get_data_ptr(o->blurriness_node, &o->blurriness);
+    if (blurriness < 0.f)
+        return;
+
+    if (o->mode == BLUR_MODE_DIRECT) {
+        const float radius_f = NGLI_MIN(blurriness, 1.f) * (float)MAX_RADIUS_SIZE;
+        const int32_t radius = NGLI_MIN((int32_t)ceilf(radius_f), MAX_RADIUS_SIZE);
+        ret = update_kernel(node, radius_to_sigma(radius_f), radius);
+        if (ret < 0)
+            return;
+        draw_direct(node);
+        return;
+    }
+
+    /*
+     * Pick the first mip level where the blur radius fits in MIP_RADIUS_SIZE
+     * pixels. Each downsample and upsample pass introduces a blur on its own
+     * (estimated to a variance of 0.5 texel² of the finest level involved),
+     * which is deducted from the kernel applied on the selected level.
+     */
+    const float radius_f = blurriness * (float)MAX_RADIUS_SIZE;
+    const float sigma = radius_to_sigma(radius_f);
+    uint32_t lod = 0;
+    if (radius_f > MIP_RADIUS_SIZE)
+        lod = (uint32_t)ceilf(log2f(radius_f / MIP_RADIUS_SIZE));
+    lod = NGLI_MIN(lod, s->max_lod);
+
+    const float scale = (float)(1U << lod);
+    const float chain_variance = (scale * scale - 1.f) / 3.f;
+    const float lod_sigma = sqrtf(NGLI_MAX(sigma * sigma - chain_variance, 1e-3f)) / scale;
+    const float lod_radius_f = NGLI_MAX(sigma_to_radius(lod_sigma), 0.f);
+    const int32_t lod_radius = NGLI_MIN((int32_t)ceilf(lod_radius_f), MAX_RADIUS_SIZE);
+    ret = update_kernel(node, lod_sigma, lod_radius);
+    if (ret < 0)
+        return;
+
+    if (lod == 0) {
+        draw_direct(node);
+    } else {
+        /*
+         * The mip passes do not deal with the texture coordinates at all, thus
+         * we need to forward the source coordinates matrix to the destination.
+         */
+        struct texture_info *dst_info = o->destination->priv_data;
+        struct image *dst_image = &dst_info->image;
+        memcpy(dst_image->coordinates_matrix, s->image->coordinates_matrix, sizeof(s->image->coordinates_matrix));
+        draw_mip(node, lod);
+    }
 }
 
 static void gblur_release(struct ngl_node *node)
 {
     struct gblur_priv *s = node->priv_data;
 
-    ngli_rtt_freep(&s->tmp);
     ngli_rtt_freep(&s->dst_rtt_ctx);
 }
 
@@ -506,6 +1058,19 @@ static void gblur_uninit(struct ngl_node *node)
     ngli_pipeline_compat_freep(&s->pl_blur_h);
     ngli_pipeline_compat_freep(&s->pl_blur_v);
     ngpu_pgcraft_freep(&s->crafter);
+
+    ngpu_block_reset(&s->down_up_data_block);
+    ngli_pipeline_compat_freep(&s->dws.pl);
+    ngpu_pgcraft_freep(&s->dws.crafter);
+    ngli_pipeline_compat_freep(&s->ups.pl);
+    ngpu_pgcraft_freep(&s->ups.crafter);
+    ngli_pipeline_compat_freep(&s->ups_dst.pl);
+    ngpu_pgcraft_freep(&s->ups_dst.crafter);
+
+    ngpu_block_reset(&s->compute_kernel_block);
+    ngli_pipeline_compat_freep(&s->comp.pl_h);
+    ngli_pipeline_compat_freep(&s->comp.pl_v);
+    ngpu_pgcraft_freep(&s->comp.crafter);
 }
 
 const struct node_class ngli_gblur_class = {
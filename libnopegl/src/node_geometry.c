@@ -103,7 +103,7 @@ static int geometry_init(struct ngl_node *node)
     const struct geometry_opts *o = node->opts;
     struct ngpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
 
-    s->geom = ngli_geometry_create(gpu_ctx);
+    s->geom = ngli_geometry_create(gpu_ctx, NULL);
     if (!s->geom)
         return NGL_ERROR_MEMORY;
 
@@ -37,6 +37,7 @@
 #include "nopegl.h"
 #include "pipeline_compat.h"
 #include "rtt.h"
+#include "rtt_pool.h"
 #include "ngpu/pgcraft.h"
 #include "utils/utils.h"
 
@@ -74,12 +75,14 @@ struct hblur_priv {
     struct ngpu_block blur_params_block;
 
     enum ngpu_format preferred_format;
-    struct ngpu_texture *tex0;
-    struct ngpu_texture *tex1;
 
+    /*
+     * The first pass renders to 2 intermediate textures, acquired from the
+     * context transient render target pool for the duration of the draw
+     */
     struct {
         struct ngpu_rendertarget_layout layout;
-        struct rtt_ctx *rtt_ctx;
+        struct ngpu_texture_params texture_params;
         struct ngpu_pgcraft *crafter;
         struct pipeline_compat *pl;
     } pass1;
@@ -442,16 +445,13 @@ static int resize(struct ngl_node *node)
         return 0;
 
     struct ngpu_texture *dst = NULL;
-    struct ngpu_texture *tex0 = ngpu_texture_create(ctx->gpu_ctx);
-    struct ngpu_texture *tex1 = ngpu_texture_create(ctx->gpu_ctx);
-    struct rtt_ctx *pass1_rtt_ctx = ngli_rtt_create(ctx);
     struct rtt_ctx *pass2_rtt_ctx = ngli_rtt_create(ctx);
-    if (!tex0 || !tex1 || !pass1_rtt_ctx || !pass2_rtt_ctx) {
+    if (!pass2_rtt_ctx) {
         ret = NGL_ERROR_MEMORY;
         goto fail;
     }
 
-    struct ngpu_texture_params texture_params = {
+    const struct ngpu_texture_params texture_params = {
         .type          = NGPU_TEXTURE_TYPE_2D,
         .format        = s->preferred_format,
         .width         = width,
@@ -464,32 +464,6 @@ static int resize(struct ngl_node *node)
                          NGPU_TEXTURE_USAGE_SAMPLED_BIT,
     };
 
-    ret = ngpu_texture_init(tex0, &texture_params);
-    if (ret < 0)
-        goto fail;
-
-    ret = ngpu_texture_init(tex1, &texture_params);
-    if (ret < 0)
-        goto fail;
-
-    struct rtt_params pass1_rtt_params = {
-        .width = width,
-        .height = height,
-        .nb_colors = 2,
-        .colors[0] = {
-            .attachment = tex0,
-            .store_op = NGPU_STORE_OP_STORE
-        },
-        .colors[1] = {
-            .attachment = tex1,
-            .store_op = NGPU_STORE_OP_STORE
-        },
-    };
-
-    ret = ngli_rtt_init(pass1_rtt_ctx, &pass1_rtt_params);
-    if (ret < 0)
-        goto fail;
-
     /* Assert that the destination texture format does not change */
     struct texture_info *dst_info = o->destination->priv_data;
     ngli_assert(dst_info->params.format == s->pass2.layout.colors[0].format);
@@ -525,21 +499,11 @@ static int resize(struct ngl_node *node)
     if (ret < 0)
         goto fail;
 
-    ngli_rtt_freep(&s->pass1.rtt_ctx);
-    s->pass1.rtt_ctx = pass1_rtt_ctx;
-
-    ngpu_texture_freep(&s->tex0);
-    s->tex0 = tex0;
-
-    ngpu_texture_freep(&s->tex1);
-    s->tex1 = tex1;
+    s->pass1.texture_params = texture_params;
 
     ngli_rtt_freep(&s->pass2.rtt_ctx);
     s->pass2.rtt_ctx = pass2_rtt_ctx;
 
-    ngli_pipeline_compat_update_image(s->pass2.pl, 0, ngli_rtt_get_image(s->pass1.rtt_ctx, 0));
-    ngli_pipeline_compat_update_image(s->pass2.pl, 1, ngli_rtt_get_image(s->pass1.rtt_ctx, 1));
-
     if (s->dst_is_resizable) {
         ngpu_texture_freep(&dst_info->texture);
         dst_info->texture = dst;
@@ -555,10 +519,6 @@ static int resize(struct ngl_node *node)
     return 0;
 
 fail:
-    ngpu_texture_freep(&tex0);
-    ngpu_texture_freep(&tex1);
-    ngli_rtt_freep(&pass1_rtt_ctx);
-
     ngli_rtt_freep(&pass2_rtt_ctx);
     if (s->dst_is_resizable)
         ngpu_texture_freep(&dst);
@@ -591,8 +551,22 @@ static void hblur_draw(struct ngl_node *node)
         .nb_samples = nb_samples,
     });
 
-    ngli_rtt_begin(s->pass1.rtt_ctx);
+    /*
+     * Each pass gathers the samples up to the blur radius (read from the
+     * source mipmaps beyond MAX_SAMPLES), so the result is transparent black
+     * outside of the source content extended by twice this radius
+     */
+    struct ngli_aabb area;
+    const float margin = 2.f * (float)(radius + radius / MAX_SAMPLES + 2);
+    ngli_node_texture_get_content_area(o->source, margin, &area);
+
+    struct rtt_ctx *pass1_rtt_ctx = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->pass1.texture_params, 2);
+    if (!pass1_rtt_ctx)
+        return;
+
+    ngli_rtt_begin(pass1_rtt_ctx);
     ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
+    ngli_rtt_set_area(pass1_rtt_ctx, &area);
     if (s->image_rev != s->image->rev) {
         ngli_pipeline_compat_update_image(s->pass1.pl, 0, s->image);
         s->image_rev = s->image->rev;
@@ -602,10 +576,13 @@ static void hblur_draw(struct ngl_node *node)
         s->image_rev = s->map_image->rev;
     }
     ngli_pipeline_compat_draw(s->pass1.pl, 3, 1, 0);
-    ngli_rtt_end(s->pass1.rtt_ctx);
+    ngli_rtt_end(pass1_rtt_ctx);
 
     ngli_rtt_begin(s->pass2.rtt_ctx);
     ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
+    ngli_rtt_set_area(s->pass2.rtt_ctx, &area);
+    ngli_pipeline_compat_update_image(s->pass2.pl, 0, ngli_rtt_get_image(pass1_rtt_ctx, 0));
+    ngli_pipeline_compat_update_image(s->pass2.pl, 1, ngli_rtt_get_image(pass1_rtt_ctx, 1));
     if (s->map_rev != s->map_image->rev) {
         ngli_pipeline_compat_update_image(s->pass2.pl, 2, s->map_image);
         s->image_rev = s->map_image->rev;
@@ -613,6 +590,8 @@ static void hblur_draw(struct ngl_node *node)
     ngli_pipeline_compat_draw(s->pass2.pl, 3, 1, 0);
     ngli_rtt_end(s->pass2.rtt_ctx);
 
+    ngli_rtt_pool_release(ctx->rtt_pool, &pass1_rtt_ctx);
+
     /*
      * The blur render passes do not deal with the texture coordinates at all,
      * thus we need to forward the source coordinates matrix to the
@@ -621,15 +600,14 @@ static void hblur_draw(struct ngl_node *node)
     struct texture_info *dst_info = o->destination->priv_data;
     struct image *dst_image = &dst_info->image;
     memcpy(dst_image->coordinates_matrix, s->image->coordinates_matrix, sizeof(s->image->coordinates_matrix));
+    dst_info->has_content_area = 1;
+    dst_info->content_area = area;
 }
 
 static void hblur_release(struct ngl_node *node)
 {
     struct hblur_priv *s = node->priv_data;
 
-    ngpu_texture_freep(&s->tex0);
-    ngpu_texture_freep(&s->tex1);
-    ngli_rtt_freep(&s->pass1.rtt_ctx);
     ngli_rtt_freep(&s->pass2.rtt_ctx);
 }
 
@@ -20,12 +20,12 @@
  */
 
 #include <stddef.h>
-#include <string.h>
 
 #include "internal.h"
 #include "math_utils.h"
 #include "node_transform.h"
 #include "nopegl.h"
+#include "transforms.h"
 
 struct identity_priv {
     struct transform trf;
@@ -35,7 +35,7 @@ static int identity_init(struct ngl_node *node)
 {
     struct identity_priv *s = node->priv_data;
     static const NGLI_ALIGNED_MAT(id_matrix) = NGLI_MAT4_IDENTITY;
-    memcpy(s->trf.matrix, id_matrix, sizeof(id_matrix));
+    ngli_transform_set_matrix(&s->trf, id_matrix);
     s->trf.child = NULL;
     return 0;
 }
@@ -32,6 +32,7 @@
 
 #include "internal.h"
 #include "log.h"
+#include "node_animated.h"
 #include "node_animkeyframe.h"
 #include "node_media.h"
 #include "node_uniform.h"
@@ -206,6 +207,8 @@ static int media_init(struct ngl_node *node)
     struct media_priv *s = node->priv_data;
     const struct media_opts *o = node->opts;
 
+    s->activation_time = -1.0;
+
     s->player = nmd_create(o->filename);
     if (!s->player)
         return NGL_ERROR_MEMORY;
@@ -270,10 +273,83 @@ static int media_init(struct ngl_node *node)
     return 0;
 }
 
+static int get_media_time(struct ngl_node *node, double t, bool ahead, double *media_time)
+{
+    const struct media_opts *o = node->opts;
+    struct ngl_node *anim_node = o->anim;
+
+    if (!anim_node) {
+        *media_time = t;
+        return 0;
+    }
+
+    const struct variable_opts *anim_o = anim_node->opts;
+    const struct animkeyframe_opts *kf0 = anim_o->animkf[0]->opts;
+    const double initial_seek = kf0->scalar;
+    double dval;
+    if (ahead) {
+        /*
+         * The time animation may be shared with nodes displayed in the
+         * current frame: its evaluated state must not move to the future
+         */
+        int ret = ngli_animated_time_evaluate(anim_node, &dval, t);
+        if (ret < 0)
+            return ret;
+    } else {
+        int ret = ngli_node_update(anim_node, t);
+        if (ret < 0)
+            return ret;
+        const struct variable_info *anim = anim_node->priv_data;
+        dval = *(double *)anim->data;
+    }
+    *media_time = NGLI_MAX(0, dval - initial_seek);
+
+    TRACE("remapped time f(%g)=%g", t, *media_time);
+    return 0;
+}
+
+static int media_visit(struct ngl_node *node, bool is_active, double t)
+{
+    struct media_priv *s = node->priv_data;
+
+    /*
+     * Record when the media is going to be displayed if it is being activated
+     * ahead of time, so the prefetch can start decoding at that position.
+     */
+    if (is_active && node->state != NGLI_NODE_STATE_READY)
+        s->activation_time = node->ctx->visit_activation_time;
+
+    struct ngl_node **children = ngli_darray_data(&node->children);
+    for (size_t i = 0; i < ngli_darray_count(&node->children); i++) {
+        int ret = ngli_node_visit(children[i], is_active, t);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
 static int media_prefetch(struct ngl_node *node)
 {
     struct media_priv *s = node->priv_data;
     nmd_start(s->player);
+
+    /*
+     * Without a seek request, the first frame would be requested (and
+     * decoded) synchronously by the first update, stalling the rendering at
+     * the clip boundary whenever the media does not start at its beginning.
+     */
+    if (s->activation_time >= 0.0) {
+        double media_time;
+        int ret = get_media_time(node, s->activation_time, true, &media_time);
+        s->activation_time = -1.0;
+        if (ret < 0)
+            return ret;
+        if (media_time > 0.0) {
+            TRACE("seek %s ahead of time at %g", node->label, media_time);
+            nmd_seek(s->player, media_time);
+        }
+    }
+
     return 0;
 }
 
@@ -317,28 +393,17 @@ static int media_update(struct ngl_node *node, double t)
 {
     struct media_priv *s = node->priv_data;
     const struct media_opts *o = node->opts;
-    struct ngl_node *anim_node = o->anim;
-    double media_time = t;
-
-    if (anim_node) {
-        struct variable_info *anim = anim_node->priv_data;
-        const struct variable_opts *anim_o = anim_node->opts;
-        const struct animkeyframe_opts *kf0 = anim_o->animkf[0]->opts;
-        const double initial_seek = kf0->scalar;
-        int ret = ngli_node_update(anim_node, t);
-        if (ret < 0)
-            return ret;
-        const double dval = *(double *)anim->data;
-        media_time = NGLI_MAX(0, dval - initial_seek);
 
-        TRACE("remapped time f(%g)=%g", t, media_time);
-    }
+    double media_time;
+    int ret = get_media_time(node, t, false, &media_time);
+    if (ret < 0)
+        return ret;
 
     nmd_frame_releasep(&s->frame);
 
     TRACE("get frame from %s at t=%g", node->label, media_time);
     struct nmd_frame *frame = NULL;
-    int ret = nmd_get_frame(s->player, media_time, &frame);
+    ret = nmd_get_frame(s->player, media_time, &frame);
     if (ret == NMD_RET_NEWFRAME) {
         const char *pix_fmt_str = get_pix_fmt_name(frame->pix_fmt);
         if (o->audio_tex) {
@@ -402,6 +467,7 @@ const struct node_class ngli_media_class = {
     .id        = NGL_NODE_MEDIA,
     .name      = "Media",
     .init      = media_init,
+    .visit     = media_visit,
     .prefetch  = media_prefetch,
     .update    = media_update,
     .release   = media_release,
@@ -44,6 +44,7 @@ struct media_priv {
     double start_time;
     double end_time;
     int invalidated;
+    double activation_time;
 
 #if defined(TARGET_ANDROID)
     struct android_surface_compat android_surface;
@@ -25,8 +25,11 @@
 
 #include "internal.h"
 #include "node_pathkey.h"
+#include "node_uniform.h"
 #include "nopegl.h"
 #include "path.h"
+#include "utils/memory.h"
+#include "utils/utils.h"
 
 struct path_opts {
     struct ngl_node **keyframes;
@@ -36,6 +39,18 @@ struct path_opts {
 
 struct path_priv {
     struct path *path;
+
+    /*
+     * When any of the keyframes coordinates is driven by a node, the path is
+     * rebuilt into next_path whenever these coordinates change, and the two
+     * paths are then swapped so that the path exposed to the users stays
+     * valid even if the construction fails.
+     */
+    int dynamic;
+    struct path *next_path;
+    float *key_values;
+    float *next_key_values;
+    size_t nb_key_values;
 };
 
 #define OFFSET(x) offsetof(struct path_opts, x)
@@ -52,39 +67,98 @@ static const struct node_param path_params[] = {
                   .flags=NGLI_PARAM_FLAG_NON_NULL | NGLI_PARAM_FLAG_DOT_DISPLAY_PACKED,
                   .desc=NGLI_DOCSTRING("anchor points the path go through")},
     {"precision", NGLI_PARAM_TYPE_I32, OFFSET(precision), {.i32=64},
-                  .desc=NGLI_DOCSTRING("number of divisions per curve segment")},
+                  .desc=NGLI_DOCSTRING("number of divisions per curve segment, adjusted to its curvature")},
     {NULL}
 };
 
 /* We must have the struct path in 1st position for AnimatedPath */
 NGLI_STATIC_ASSERT(offsetof(struct path_priv, path) == 0, "path 1st field");
 
-static int path_init(struct ngl_node *node)
+/*
+ * Collect the current coordinates of all the keyframes, in order. If dst is
+ * NULL, only the number of values is returned.
+ */
+static size_t get_key_values(const struct path_opts *o, float *dst)
 {
-    int ret;
-    struct path_priv *s = node->priv_data;
-    const struct path_opts *o = node->opts;
+    size_t n = 0;
+    for (size_t i = 0; i < o->nb_keyframes; i++) {
+        const struct ngl_node *kf = o->keyframes[i];
+        const float *values[3] = {0};
+        if (kf->cls->id == NGL_NODE_PATHKEYMOVE) {
+            const struct pathkey_move_opts *move = kf->opts;
+            values[0] = ngli_node_get_data_ptr(move->to_node, move->to);
+        } else if (kf->cls->id == NGL_NODE_PATHKEYLINE) {
+            const struct pathkey_line_opts *line = kf->opts;
+            values[0] = ngli_node_get_data_ptr(line->to_node, line->to);
+        } else if (kf->cls->id == NGL_NODE_PATHKEYBEZIER2) {
+            const struct pathkey_bezier2_opts *bezier2 = kf->opts;
+            values[0] = ngli_node_get_data_ptr(bezier2->control_node, bezier2->control);
+            values[1] = ngli_node_get_data_ptr(bezier2->to_node, bezier2->to);
+        } else if (kf->cls->id == NGL_NODE_PATHKEYBEZIER3) {
+            const struct pathkey_bezier3_opts *bezier3 = kf->opts;
+            values[0] = ngli_node_get_data_ptr(bezier3->control1_node, bezier3->control1);
+            values[1] = ngli_node_get_data_ptr(bezier3->control2_node, bezier3->control2);
+            values[2] = ngli_node_get_data_ptr(bezier3->to_node, bezier3->to);
+        }
+        for (size_t j = 0; j < NGLI_ARRAY_NB(values) && values[j]; j++) {
+            if (dst)
+                memcpy(dst + n, values[j], 3 * sizeof(*dst));
+            n += 3;
+        }
+    }
+    return n;
+}
 
-    s->path = ngli_path_create();
-    if (!s->path)
-        return NGL_ERROR_MEMORY;
+static int is_dynamic(const struct path_opts *o)
+{
+    for (size_t i = 0; i < o->nb_keyframes; i++) {
+        const struct ngl_node *kf = o->keyframes[i];
+        if (kf->cls->id == NGL_NODE_PATHKEYMOVE) {
+            const struct pathkey_move_opts *move = kf->opts;
+            if (move->to_node)
+                return 1;
+        } else if (kf->cls->id == NGL_NODE_PATHKEYLINE) {
+            const struct pathkey_line_opts *line = kf->opts;
+            if (line->to_node)
+                return 1;
+        } else if (kf->cls->id == NGL_NODE_PATHKEYBEZIER2) {
+            const struct pathkey_bezier2_opts *bezier2 = kf->opts;
+            if (bezier2->control_node || bezier2->to_node)
+                return 1;
+        } else if (kf->cls->id == NGL_NODE_PATHKEYBEZIER3) {
+            const struct pathkey_bezier3_opts *bezier3 = kf->opts;
+            if (bezier3->control1_node || bezier3->control2_node || bezier3->to_node)
+                return 1;
+        }
+    }
+    return 0;
+}
+
+static int build_path(struct path *path, const struct path_opts *o)
+{
+    int ret;
 
     for (size_t i = 0; i < o->nb_keyframes; i++) {
         const struct ngl_node *kf = o->keyframes[i];
         if (kf->cls->id == NGL_NODE_PATHKEYMOVE) {
             const struct pathkey_move_opts *move = kf->opts;
-            ret = ngli_path_move_to(s->path, move->to);
+            ret = ngli_path_move_to(path, ngli_node_get_data_ptr(move->to_node, move->to));
         } else if (kf->cls->id == NGL_NODE_PATHKEYLINE) {
             const struct pathkey_line_opts *line = kf->opts;
-            ret = ngli_path_line_to(s->path, line->to);
+            ret = ngli_path_line_to(path, ngli_node_get_data_ptr(line->to_node, line->to));
         } else if (kf->cls->id == NGL_NODE_PATHKEYBEZIER2) {
             const struct pathkey_bezier2_opts *bezier2 = kf->opts;
-            ret = ngli_path_bezier2_to(s->path, bezier2->control, bezier2->to);
+            ret = ngli_path_bezier2_to(path,
+                                       ngli_node_get_data_ptr(bezier2->control_node, bezier2->control),
+                                       ngli_node_get_data_ptr(bezier2->to_node, bezier2->to));
         } else if (kf->cls->id == NGL_NODE_PATHKEYBEZIER3) {
             const struct pathkey_bezier3_opts *bezier3 = kf->opts;
-            ret = ngli_path_bezier3_to(s->path, bezier3->control1, bezier3->control2, bezier3->to);
+            ret = ngli_path_bezier3_to(path,
+                                       ngli_node_get_data_ptr(bezier3->control1_node, bezier3->control1),
+                                       ngli_node_get_data_ptr(bezier3->control2_node, bezier3->control2),
+                                       ngli_node_get_data_ptr(bezier3->to_node, bezier3->to));
         } else if (kf->cls->id == NGL_NODE_PATHKEYCLOSE) {
-            ret = ngli_path_close(s->path);
+            ret = ngli_path_close(path);
         } else {
             ngli_assert(0);
         }
@@ -92,23 +166,85 @@ static int path_init(struct ngl_node *node)
             return ret;
     }
 
-    ret = ngli_path_finalize(s->path);
+    ret = ngli_path_finalize(path);
     if (ret < 0)
         return ret;
 
-    return ngli_path_init(s->path, o->precision);
+    return ngli_path_init(path, o->precision);
+}
+
+static int path_init(struct ngl_node *node)
+{
+    struct path_priv *s = node->priv_data;
+    const struct path_opts *o = node->opts;
+
+    s->path = ngli_path_create();
+    if (!s->path)
+        return NGL_ERROR_MEMORY;
+
+    int ret = build_path(s->path, o);
+    if (ret < 0)
+        return ret;
+
+    s->dynamic = is_dynamic(o);
+    if (!s->dynamic)
+        return 0;
+
+    s->next_path = ngli_path_create();
+    if (!s->next_path)
+        return NGL_ERROR_MEMORY;
+
+    s->nb_key_values = get_key_values(o, NULL);
+    s->key_values = ngli_calloc(s->nb_key_values, sizeof(*s->key_values));
+    s->next_key_values = ngli_calloc(s->nb_key_values, sizeof(*s->next_key_values));
+    if (!s->key_values || !s->next_key_values)
+        return NGL_ERROR_MEMORY;
+    get_key_values(o, s->key_values);
+
+    return 0;
+}
+
+static int path_update(struct ngl_node *node, double t)
+{
+    struct path_priv *s = node->priv_data;
+    const struct path_opts *o = node->opts;
+
+    int ret = ngli_node_update_children(node, t);
+    if (ret < 0)
+        return ret;
+
+    if (!s->dynamic)
+        return 0;
+
+    get_key_values(o, s->next_key_values);
+    if (!memcmp(s->next_key_values, s->key_values, s->nb_key_values * sizeof(*s->key_values)))
+        return 0;
+
+    ngli_path_clear(s->next_path);
+    ret = build_path(s->next_path, o);
+    if (ret < 0)
+        return ret;
+
+    NGLI_SWAP(struct path *, s->path, s->next_path);
+    NGLI_SWAP(float *, s->key_values, s->next_key_values);
+
+    return 0;
 }
 
 static void path_uninit(struct ngl_node *node)
 {
     struct path_priv *s = node->priv_data;
     ngli_path_freep(&s->path);
+    ngli_path_freep(&s->next_path);
+    ngli_freep(&s->key_values);
+    ngli_freep(&s->next_key_values);
 }
 
 const struct node_class ngli_path_class = {
     .id        = NGL_NODE_PATH,
     .name      = "Path",
     .init      = path_init,
+    .update    = path_update,
     .uninit    = path_uninit,
     .opts_size = sizeof(struct path_opts),
     .priv_size = sizeof(struct path_priv),
@@ -23,21 +23,28 @@
 #define NODE_PATHKEY_H
 
 struct pathkey_move_opts {
+    struct ngl_node *to_node;
     float to[3];
 };
 
 struct pathkey_line_opts {
+    struct ngl_node *to_node;
     float to[3];
 };
 
 struct pathkey_bezier2_opts {
+    struct ngl_node *control_node;
     float control[3];
+    struct ngl_node *to_node;
     float to[3];
 };
 
 struct pathkey_bezier3_opts {
+    struct ngl_node *control1_node;
     float control1[3];
+    struct ngl_node *control2_node;
     float control2[3];
+    struct ngl_node *to_node;
     float to[3];
 };
 
@@ -99,7 +99,7 @@ static int quad_init(struct ngl_node *node)
 
     struct ngpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
 
-    s->geom = ngli_geometry_create(gpu_ctx);
+    s->geom = ngli_geometry_create(gpu_ctx, node->ctx->geometry_cache);
     if (!s->geom)
         return NGL_ERROR_MEMORY;
 
@@ -51,7 +51,9 @@ static void update_trf_matrix(struct ngl_node *node, float deg_angle)
     struct transform *trf = &s->trf;
 
     const float angle = NGLI_DEG2RAD(deg_angle);
-    ngli_mat4_rotate(trf->matrix, angle, s->normed_axis, s->anchor);
+    NGLI_ALIGNED_MAT(matrix);
+    ngli_mat4_rotate(matrix, angle, s->normed_axis, s->anchor);
+    ngli_transform_set_matrix(trf, matrix);
 }
 
 static int rotate_init(struct ngl_node *node)
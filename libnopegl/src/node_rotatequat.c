@@ -47,7 +47,9 @@ static void update_trf_matrix(struct ngl_node *node, const float *quat)
     struct rotatequat_priv *s = node->priv_data;
     struct transform *trf = &s->trf;
 
-    ngli_mat4_from_quat(trf->matrix, quat, s->anchor);
+    NGLI_ALIGNED_MAT(matrix);
+    ngli_mat4_from_quat(matrix, quat, s->anchor);
+    ngli_transform_set_matrix(trf, matrix);
 }
 
 static int rotatequat_init(struct ngl_node *node)
@@ -475,6 +475,26 @@ static void rtt_draw(struct ngl_node *node)
     ngli_node_draw(o->child);
     ngli_rtt_end(s->rtt_ctx);
 
+    /*
+     * Record the area of the color textures touched by the draws so that the
+     * post processing passes sampling them (such as the blurs) can restrict
+     * their work to it. This is only possible if the rest of the textures is
+     * transparent black and cannot be written as a storage image.
+     */
+    const int transparent_clear = o->clear_color[0] == 0.f && o->clear_color[1] == 0.f &&
+                                  o->clear_color[2] == 0.f && o->clear_color[3] == 0.f;
+    struct ngli_aabb content_area;
+    ngli_rtt_get_content_area(s->rtt_ctx, &content_area);
+    for (size_t i = 0; i < o->nb_color_textures; i++) {
+        const struct ngl_node *texture = o->color_textures[i];
+        if (texture->cls->id != NGL_NODE_TEXTURE2D)
+            continue;
+        struct texture_info *texture_info = texture->priv_data;
+        const int storage = texture_info->params.usage & NGPU_TEXTURE_USAGE_STORAGE_BIT;
+        texture_info->has_content_area = transparent_clear && !storage;
+        texture_info->content_area = content_area;
+    }
+
     if (!o->forward_transforms) {
         ngli_darray_pop(&ctx->modelview_matrix_stack);
         ngli_darray_pop(&ctx->projection_matrix_stack);
@@ -47,7 +47,9 @@ static void update_trf_matrix(struct ngl_node *node, const float *f)
     struct scale_priv *s = node->priv_data;
     struct transform *trf = &s->trf;
 
-    ngli_mat4_scale(trf->matrix, f[0], f[1], f[2], s->anchor);
+    NGLI_ALIGNED_MAT(matrix);
+    ngli_mat4_scale(matrix, f[0], f[1], f[2], s->anchor);
+    ngli_transform_set_matrix(trf, matrix);
 }
 
 static int scale_init(struct ngl_node *node)
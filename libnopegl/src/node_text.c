@@ -31,6 +31,7 @@
 #include "ngpu/type.h"
 #include "params.h"
 #include "pipeline_compat.h"
+#include "rtt.h"
 #include "text.h"
 #include "utils/darray.h"
 #include "utils/utils.h"
@@ -736,6 +737,7 @@ static void text_draw(struct ngl_node *node)
     struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
     ngpu_ctx_set_viewport(gpu_ctx, &ctx->viewport);
     ngpu_ctx_set_scissor(gpu_ctx, &ctx->scissor);
+    ngli_rtt_add_content_area(ctx, &ctx->scissor);
 
     ngli_pipeline_compat_draw(bg_desc->common.pipeline_compat, 4, 1, 0);
 
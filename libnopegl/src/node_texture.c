@@ -39,6 +39,7 @@
 #include "node_texture.h"
 #include "nopegl.h"
 #include "rtt.h"
+#include "utils/utils.h"
 
 struct texture_opts {
     int requested_format;
@@ -109,6 +110,30 @@ int ngli_node_texture_has_media_data_src(const struct ngl_node *node)
     return 0;
 }
 
+void ngli_node_texture_get_content_area(const struct ngl_node *node, float margin, struct ngli_aabb *dst)
+{
+    const struct texture_info *s = node->priv_data;
+    if (!s->has_content_area) {
+        *dst = (struct ngli_aabb){0.f, 0.f, 1.f, 1.f};
+        return;
+    }
+
+    const struct ngli_aabb *area = &s->content_area;
+    if (area->x0 >= area->x1 || area->y0 >= area->y1) {
+        *dst = (struct ngli_aabb){0};
+        return;
+    }
+
+    const float margin_x = margin / (float)s->image.params.width;
+    const float margin_y = margin / (float)s->image.params.height;
+    *dst = (struct ngli_aabb){
+        .x0 = NGLI_MAX(area->x0 - margin_x, 0.f),
+        .y0 = NGLI_MAX(area->y0 - margin_y, 0.f),
+        .x1 = NGLI_MIN(area->x1 + margin_x, 1.f),
+        .y1 = NGLI_MIN(area->y1 + margin_y, 1.f),
+    };
+}
+
 const struct param_choices ngli_mipmap_filter_choices = {
     .name = "mipmap_filter",
     .consts = {
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 
+#include "box.h"
 #include "image.h"
 #include "ngpu/texture.h"
 #include "nopegl.h"
@@ -39,10 +40,23 @@ struct texture_info {
     struct ngpu_texture *texture;
     struct image image;
     size_t image_rev;
+
+    /*
+     * Normalized area of the texture that may hold something else than
+     * transparent black, only known for render targets cleared with it
+     */
+    int has_content_area;
+    struct ngli_aabb content_area;
 };
 
 enum ngpu_pgcraft_texture_type ngli_node_texture_get_pgcraft_texture_type(const struct ngl_node *node);
 enum ngpu_pgcraft_texture_type ngli_node_texture_get_pgcraft_image_type(const struct ngl_node *node);
 int ngli_node_texture_has_media_data_src(const struct ngl_node *node);
 
+/*
+ * Get the normalized content area of the texture extended by a margin (in
+ * texels), or the whole texture if its content area is unknown
+ */
+void ngli_node_texture_get_content_area(const struct ngl_node *node, float margin, struct ngli_aabb *dst);
+
 #endif
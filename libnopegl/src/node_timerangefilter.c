@@ -27,6 +27,7 @@
 #include "nopegl.h"
 #include "internal.h"
 #include "params.h"
+#include "utils/utils.h"
 
 struct timerangefilter_opts {
     struct ngl_node *child;
@@ -80,9 +81,11 @@ static int timerangefilter_init(struct ngl_node *node)
 
 static int timerangefilter_visit(struct ngl_node *node, bool is_active, double t)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct timerangefilter_priv *s = node->priv_data;
     const struct timerangefilter_opts *o = node->opts;
     struct ngl_node *child = o->child;
+    const double activation_time = ctx->visit_activation_time;
 
     /*
      * The life of the parent takes over the life of its children: if the
@@ -98,9 +101,19 @@ static int timerangefilter_visit(struct ngl_node *node, bool is_active, double t
         // otherwise the child will stay uninitialized.
         if (!child->is_active)
             s->updated = 0;
+
+        /*
+         * Within the prefetch window, let the children know when they will
+         * actually be displayed so they can prepare their content for that
+         * time (typically medias seeking ahead).
+         */
+        if (is_active && t < o->start_time)
+            ctx->visit_activation_time = NGLI_MAX(activation_time, o->start_time);
     }
 
-    return ngli_node_visit(child, is_active, t);
+    int ret = ngli_node_visit(child, is_active, t);
+    ctx->visit_activation_time = activation_time;
+    return ret;
 }
 
 static int timerangefilter_update(struct ngl_node *node, double t)
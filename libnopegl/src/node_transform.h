@@ -22,6 +22,8 @@
 #ifndef NODE_TRANSFORM_H
 #define NODE_TRANSFORM_H
 
+#include <stdint.h>
+
 #include "utils/utils.h"
 
 struct ngl_node;
@@ -29,6 +31,12 @@ struct ngl_node;
 struct transform {
     struct ngl_node *child;
     NGLI_ALIGNED_MAT(matrix);
+    uint64_t revision;              /* incremented every time the matrix changes */
+
+    /* Cached composition of the consecutive transforms starting at this node */
+    NGLI_ALIGNED_MAT(chain_matrix);
+    uint64_t chain_revision;        /* sum of the revisions of the chain, 0 if never computed */
+    const struct ngl_node *chain_child;
 };
 
 #endif
@@ -43,7 +43,9 @@ static void update_trf_matrix(struct ngl_node *node, const float *vec)
 {
     struct translate_priv *s = node->priv_data;
     struct transform *trf = &s->trf;
-    ngli_mat4_translate(trf->matrix, vec[0], vec[1], vec[2]);
+    NGLI_ALIGNED_MAT(matrix);
+    ngli_mat4_translate(matrix, vec[0], vec[1], vec[2]);
+    ngli_transform_set_matrix(trf, matrix);
 }
 
 static int update_vector(struct ngl_node *node)
@@ -31,8 +31,10 @@
 #include "nodes_register.h"
 #include "nopegl.h"
 #include "params.h"
+#include "trace.h"
 #include "utils/memory.h"
 #include "utils/string.h"
+#include "utils/time.h"
 #include "utils/utils.h"
 
 /* We depend on the monotonically incrementing by 1 property of these fields */
@@ -366,7 +368,11 @@ static int node_prefetch(struct ngl_node *node)
 
     if (node->cls->prefetch) {
         TRACE("PREFETCH %s @ %p", node->label, node);
+        struct trace *trace = node->ctx->trace;
+        const int64_t start_time = trace ? ngli_gettime_relative() : 0;
         int ret = node->cls->prefetch(node);
+        if (trace)
+            ngli_trace_add_cpu_event(trace, node, "prefetch", start_time, ngli_gettime_relative());
         if (ret < 0) {
             LOG(ERROR, "prefetching node %s failed: %s", node->label, NGLI_RET_STR(ret));
             node->visit_time = -1.;
@@ -387,6 +393,7 @@ int ngli_node_honor_release_prefetch(struct ngl_node *scene, double t)
     /* Build a new list of activity checks nodes */
     struct darray *nodes_array = &scene->ctx->activitycheck_nodes;
     ngli_darray_clear(nodes_array);
+    scene->ctx->visit_activation_time = -1.0;
     int ret = ngli_node_visit(scene, true, t);
     if (ret < 0)
         return ret;
@@ -419,13 +426,18 @@ int ngli_node_update(struct ngl_node *node, double t)
     if (node->cls->update) {
         if (node->last_update_time != t) {
             TRACE("UPDATE %s @ %p with t=%g", node->label, node, t);
+            struct trace *trace = node->ctx->trace;
+            const int64_t start_time = trace ? ngli_gettime_relative() : 0;
             int ret = node->cls->update(node, t);
+            if (trace)
+                ngli_trace_add_cpu_event(trace, node, "update", start_time, ngli_gettime_relative());
             if (ret < 0) {
                 LOG(ERROR, "updating node %s failed: %s", node->label, NGLI_RET_STR(ret));
                 return ret;
             }
             node->last_update_time = t;
             node->draw_count = 0;
+            node->cull_count = 0;
         } else {
             TRACE("%s already updated for t=%g, skip it", node->label, t);
         }
@@ -468,7 +480,16 @@ void ngli_node_draw(struct ngl_node *node)
 {
     if (node->cls->draw) {
         TRACE("DRAW %s @ %p", node->label, node);
-        node->cls->draw(node);
+        struct trace *trace = node->ctx->trace;
+        if (trace) {
+            const int32_t gpu_event = ngli_trace_begin_gpu_event(trace, node);
+            const int64_t start_time = ngli_gettime_relative();
+            node->cls->draw(node);
+            ngli_trace_add_cpu_event(trace, node, "draw", start_time, ngli_gettime_relative());
+            ngli_trace_end_gpu_event(trace, gpu_event);
+        } else {
+            node->cls->draw(node);
+        }
         node->draw_count++;
     }
 }
@@ -610,6 +631,12 @@ int ngl_node_param_set_data(struct ngl_node *node, const char *key, size_t size,
     FORWARD_TO_PARAM(data, size, data);
 }
 
+int ngl_node_param_set_data_ref(struct ngl_node *node, const char *key, size_t size, const void *data,
+                                ngl_data_release_callback_type release_cb, void *release_arg)
+{
+    FORWARD_TO_PARAM(data_ref, size, data, release_cb, release_arg);
+}
+
 int ngl_node_param_set_f32(struct ngl_node *node, const char *key, float value)
 {
     FORWARD_TO_PARAM(f32, value);
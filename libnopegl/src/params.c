@@ -98,7 +98,7 @@ const struct param_specs ngli_params_specs[] = {
     },
     [NGLI_PARAM_TYPE_DATA] = {
         .name = "data",
-        .size = sizeof(void *) + sizeof(size_t),
+        .size = sizeof(void *) + sizeof(size_t) + sizeof(void *),
         .desc = NGLI_DOCSTRING("Agnostic data buffer"),
     },
     [NGLI_PARAM_TYPE_F32] = {
@@ -373,6 +373,32 @@ int ngli_params_set_bool(uint8_t *dstp, const struct node_param *par, int value)
     return 0;
 }
 
+/*
+ * A data parameter is stored as a data pointer, its size, and an opaque
+ * pointer to the release callback in case the data is not owned by the node
+ * (NULL if the data was copied).
+ */
+struct data_release {
+    ngl_data_release_callback_type callback;
+    void *arg;
+};
+
+static void reset_data(uint8_t *dstp)
+{
+    uint8_t **dst = (uint8_t **)dstp;
+    struct data_release **releasep = (struct data_release **)(dstp + sizeof(void *) + sizeof(size_t));
+    struct data_release *release = *releasep;
+    if (release) {
+        if (release->callback)
+            release->callback(release->arg, *dst);
+        ngli_freep(releasep);
+        *dst = NULL;
+    } else {
+        ngli_freep(dst);
+    }
+    memset(dstp + sizeof(void *), 0, sizeof(size_t));
+}
+
 int ngli_params_set_data(uint8_t *dstp, const struct node_param *par, size_t size, const void *data)
 {
     int ret = check_param_type(par, NGLI_PARAM_TYPE_DATA);
@@ -382,7 +408,7 @@ int ngli_params_set_data(uint8_t *dstp, const struct node_param *par, size_t siz
     LOG(VERBOSE, "set %s to %p (of size %zu)", par->key, data, size);
     uint8_t **dst = (uint8_t **)dstp;
 
-    ngli_freep(dst);
+    reset_data(dstp);
     if (data && size) {
         *dst = ngli_memdup(data, size);
         if (!*dst)
@@ -394,6 +420,30 @@ int ngli_params_set_data(uint8_t *dstp, const struct node_param *par, size_t siz
     return 0;
 }
 
+int ngli_params_set_data_ref(uint8_t *dstp, const struct node_param *par, size_t size, const void *data,
+                             ngl_data_release_callback_type release_cb, void *release_arg)
+{
+    int ret = check_param_type(par, NGLI_PARAM_TYPE_DATA);
+    if (ret < 0)
+        return ret;
+
+    struct data_release *release = ngli_calloc(1, sizeof(*release));
+    if (!release)
+        return NGL_ERROR_MEMORY;
+    release->callback = release_cb;
+    release->arg = release_arg;
+
+    LOG(VERBOSE, "set %s to reference %p (of size %zu)", par->key, data, size);
+
+    reset_data(dstp);
+    if (!data)
+        size = 0;
+    memcpy(dstp, &data, sizeof(data));
+    memcpy(dstp + sizeof(void *), &size, sizeof(size));
+    memcpy(dstp + sizeof(void *) + sizeof(size_t), &release, sizeof(release));
+    return 0;
+}
+
 int ngli_params_set_dict(uint8_t *dstp, const struct node_param *par, const char *name, struct ngl_node *node)
 {
     int ret = check_param_type(par, NGLI_PARAM_TYPE_NODEDICT);
@@ -1027,11 +1077,9 @@ void ngli_params_free(uint8_t *base_ptr, const struct node_param *params)
                 ngli_free(s);
                 break;
             }
-            case NGLI_PARAM_TYPE_DATA: {
-                uint8_t *data = *(uint8_t **)parp;
-                ngli_free(data);
+            case NGLI_PARAM_TYPE_DATA:
+                reset_data(parp);
                 break;
-            }
             case NGLI_PARAM_TYPE_NODE: {
                 struct ngl_node *node = *(struct ngl_node **)parp;
                 ngl_node_unrefp(&node);
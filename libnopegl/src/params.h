@@ -22,6 +22,7 @@
 #ifndef PARAMS_H
 #define PARAMS_H
 
+#include "nopegl.h"
 #include "utils/bstr.h"
 
 enum param_type {
@@ -175,6 +176,8 @@ const struct node_param *ngli_params_find(const struct node_param *params, const
 void ngli_params_bstr_print_val(struct bstr *b, uint8_t *base_ptr, const struct node_param *par);
 int ngli_params_set_bool(uint8_t *dstp, const struct node_param *par, int value);
 int ngli_params_set_data(uint8_t *dstp, const struct node_param *par, size_t size, const void *data);
+int ngli_params_set_data_ref(uint8_t *dstp, const struct node_param *par, size_t size, const void *data,
+                             ngl_data_release_callback_type release_cb, void *release_arg);
 int ngli_params_set_dict(uint8_t *dstp, const struct node_param *par, const char *name, struct ngl_node *value);
 int ngli_params_set_f32(uint8_t *dstp, const struct node_param *par, float value);
 int ngli_params_set_f64(uint8_t *dstp, const struct node_param *par, double value);
@@ -47,6 +47,7 @@
 #include "pass.h"
 #include "pipeline_compat.h"
 #include "ngpu/pgcraft.h"
+#include "rtt.h"
 #include "utils/darray.h"
 #include "utils/hmap.h"
 #include "utils/utils.h"
@@ -216,7 +217,18 @@ static int register_block(struct pass *s, const char *name, struct ngl_node *blo
         ngli_assert(0);
 
     const struct ngpu_buffer *buffer = block_info->buffer;
-    const size_t buffer_size = buffer ? buffer->size : 0;
+    size_t buffer_size = buffer ? buffer->size : 0;
+
+    /* Multi-buffered blocks select their current copy with a dynamic offset */
+    if (block_info->multi_buffered) {
+        if (writable) {
+            LOG(ERROR, "block %s cannot be both writable and multi-buffered", name);
+            return NGL_ERROR_INVALID_USAGE;
+        }
+        type = type == NGPU_TYPE_UNIFORM_BUFFER ? NGPU_TYPE_UNIFORM_BUFFER_DYNAMIC
+                                                : NGPU_TYPE_STORAGE_BUFFER_DYNAMIC;
+        buffer_size = block_info->data_size;
+    }
     struct ngpu_pgcraft_block crafter_block = {
         .type     = type,
         .stage    = stage,
@@ -650,14 +662,28 @@ int ngli_pass_exec(struct pass *s)
         }
     }
 
+    /*
+     * The blocks map follows the order of the bindgroup layout buffers, which
+     * is also the order expected for the dynamic offsets
+     */
+    uint32_t dynamic_offsets[NGPU_MAX_DYNAMIC_OFFSETS];
+    size_t nb_dynamic_offsets = 0;
+
     struct resource_map *resource_map = ngli_darray_data(&desc->blocks_map);
     for (size_t i = 0; i < ngli_darray_count(&desc->blocks_map); i++) {
         const struct block_info *info = resource_map[i].info;
         if (resource_map[i].buffer_rev != info->buffer_rev) {
-            ngli_pipeline_compat_update_buffer(pipeline_compat, resource_map[i].index, info->buffer, 0, 0);
+            const size_t size = info->multi_buffered ? info->data_size : 0;
+            ngli_pipeline_compat_update_buffer(pipeline_compat, resource_map[i].index, info->buffer, 0, size);
             resource_map[i].buffer_rev = info->buffer_rev;
         }
+        if (info->multi_buffered) {
+            ngli_assert(nb_dynamic_offsets < NGLI_ARRAY_NB(dynamic_offsets));
+            dynamic_offsets[nb_dynamic_offsets++] = info->buffer_offset;
+        }
     }
+    if (nb_dynamic_offsets)
+        ngli_pipeline_compat_update_dynamic_offsets(pipeline_compat, dynamic_offsets, nb_dynamic_offsets);
 
     if (s->pipeline_type == NGPU_PIPELINE_TYPE_GRAPHICS) {
         struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
@@ -668,6 +694,7 @@ int ngli_pass_exec(struct pass *s)
 
         ngpu_ctx_set_viewport(gpu_ctx, &ctx->viewport);
         ngpu_ctx_set_scissor(gpu_ctx, &ctx->scissor);
+        ngli_rtt_add_content_area(ctx, &ctx->scissor);
 
         if (s->indices)
             ngli_pipeline_compat_draw_indexed(pipeline_compat, s->indices, s->indices_layout->format,
@@ -20,6 +20,7 @@
  * under the License.
  */
 
+#include <math.h>
 #include <string.h>
 
 #include "log.h"
@@ -53,6 +54,7 @@ struct path {
     float origin[3];            /* temporary origin for the current sub-path */
     float cursor[3];            /* temporary cursor used during path construction */
     uint32_t segment_flags;     /* temporary segment flags used during path construction */
+    uint32_t revision;          /* number of times the path was cleared */
 };
 
 struct path *ngli_path_create(void)
@@ -344,19 +346,19 @@ void ngli_path_transform(struct path *s, const float *matrix)
         const float *y = segment->bezier_y;
         const float *z = segment->bezier_z;
 
-        NGLI_ALIGNED_VEC(p0) = {x[0], y[0], z[0], 1.f};
-        NGLI_ALIGNED_VEC(p1) = {x[1], y[1], z[1], 1.f};
-        NGLI_ALIGNED_VEC(p2) = {x[2], y[2], z[2], 1.f};
-        NGLI_ALIGNED_VEC(p3) = {x[3], y[3], z[3], 1.f};
+        /* The 4 control points, transformed at once */
+        NGLI_ALIGNED_MAT(p) = {
+            x[0], y[0], z[0], 1.f,
+            x[1], y[1], z[1], 1.f,
+            x[2], y[2], z[2], 1.f,
+            x[3], y[3], z[3], 1.f,
+        };
 
-        ngli_mat4_mul_vec4(p0, matrix, p0);
-        ngli_mat4_mul_vec4(p1, matrix, p1);
-        ngli_mat4_mul_vec4(p2, matrix, p2);
-        ngli_mat4_mul_vec4(p3, matrix, p3);
+        ngli_mat4_mul_vec4_array(p, matrix, p, 4);
 
-        const float xt[4] = {p0[0], p1[0], p2[0], p3[0]};
-        const float yt[4] = {p0[1], p1[1], p2[1], p3[1]};
-        const float zt[4] = {p0[2], p1[2], p2[2], p3[2]};
+        const float xt[4] = {p[0], p[4], p[ 8], p[12]};
+        const float yt[4] = {p[1], p[5], p[ 9], p[13]};
+        const float zt[4] = {p[2], p[6], p[10], p[14]};
 
         memcpy(segment->bezier_x, xt, sizeof(xt));
         memcpy(segment->bezier_y, yt, sizeof(yt));
@@ -372,6 +374,52 @@ int ngli_path_finalize(struct path *s)
     return 0;
 }
 
+/*
+ * Estimate the number of steps needed to approximate the arc length of a
+ * curved segment.
+ *
+ * The largest second difference of the control points (M) bounds how much a
+ * curve deviates from a uniform-speed straight motion (Wang's formula), while
+ * the length of the control polygon (L) bounds its length. Since M <= L, the
+ * ratio gives a scale-independent estimate of the bending in [0,1]: a flat
+ * curve with evenly spaced control points needs a single step, a 60° turn
+ * (ratio of 1/2) gets `precision` steps, and a curve folding back on itself
+ * gets √2 times more. The square root follows the chord error of a
+ * uniform subdivision, which decreases with the square of the number of steps.
+ */
+static int32_t get_segment_precision(const struct path_segment *segment, int32_t precision)
+{
+    /* Straight lines have an exact length */
+    if (segment->degree == 1)
+        return 1;
+
+    const float *x = segment->bezier_x;
+    const float *y = segment->bezier_y;
+    const float *z = segment->bezier_z;
+
+    float length = 0.f;
+    for (int32_t i = 0; i < segment->degree; i++) {
+        const float v[3] = {x[i + 1] - x[i], y[i + 1] - y[i], z[i + 1] - z[i]};
+        length += ngli_vec3_length(v);
+    }
+    if (length == 0.f)
+        return 1;
+
+    float max_dd = 0.f;
+    for (int32_t i = 0; i + 2 <= segment->degree; i++) {
+        const float dd[3] = {
+            x[i] - 2.f * x[i + 1] + x[i + 2],
+            y[i] - 2.f * y[i + 1] + y[i + 2],
+            z[i] - 2.f * z[i + 1] + z[i + 2],
+        };
+        max_dd = NGLI_MAX(max_dd, ngli_vec3_length(dd));
+    }
+
+    const float bending = NGLI_MIN(max_dd / length, 1.f);
+    const float nb_steps = ceilf((float)precision * sqrtf(2.f * bending));
+    return (int32_t)NGLI_MAX(nb_steps, 1.f);
+}
+
 /*
  * Lexicon:
  *
@@ -383,8 +431,9 @@ int ngli_path_finalize(struct path *s)
  *   the 1st, 2nd and 3rd degree. The segments form a chain where the end
  *   coordinate of one segment overlaps with the starting point of the next
  *   segment.
- * - step: a step is a coordinate on the curve; every segment is divided
- *   into an arbitrary number of `precision` steps.
+ * - step: a step is a coordinate on the curve; every curved segment is
+ *   divided into a number of steps derived from `precision` and from how
+ *   much it bends (see get_segment_precision()).
  * - dist: growing distance between the origin of the path up to a given step:
  *   those are approximations of an arc length.
  * - arc: 2 steps form an arc, it represents a (usually small) chunk of a
@@ -448,11 +497,7 @@ int ngli_path_init(struct path *s, int32_t precision)
     for (size_t i = 0; i < nb_segments; i++) {
         struct path_segment *segment = &segments[i];
 
-        /*
-         * Compared to curves, straight lines do not need to be divided into
-         * small chunks because their length can be calculated exactly.
-         */
-        const int32_t segment_precision = segment->degree == 1 ? 1 : s->precision;
+        const int32_t segment_precision = get_segment_precision(segment, s->precision);
 
         /*
          * We're not using 1/(P-1) but 1/P for the scale because each segment is
@@ -539,18 +584,26 @@ int ngli_path_init(struct path *s, int32_t precision)
     for (size_t i = 0; i < nb_arcs; i++)
         s->arc_to_segment[i] = steps[i].segment_id;
 
-    /* We don't need to store all the intermediate positions anymore */
+    /*
+     * We don't need to store all the intermediate positions anymore, but the
+     * array must remain usable for a re-initialization after a clear.
+     */
     ngli_darray_reset(&s->steps);
+    ngli_darray_init(&s->steps, sizeof(struct path_step), 0);
 
     s->state = PATH_STATE_INITIALIZED;
     return 0;
 }
 
 /*
- * Return the index of the vector where `value` belongs, starting the search
- * from index `*cache` (and looping back to 0 if necessary). A vector is
- * defined by 2 consecutive points in the `values` array, with `values`
- * composed of monotonically increasing values.
+ * Return the index of the vector where `value` belongs. A vector is defined
+ * by 2 consecutive points in the `values` array, with `values` composed of
+ * monotonically increasing values. When several vectors match (zero length
+ * vectors), the last one is returned.
+ *
+ * The vector at index `*cache` and its successor are checked first since
+ * consecutive evaluations usually fall in the same or the next vector, and
+ * a binary search is used otherwise.
  *
  * The range of the returned index is within [0,nb_values-2].
  *
@@ -566,29 +619,38 @@ int ngli_path_init(struct path *s, int32_t precision)
  *      15    |   3     | after end value, clamped to last index
  *
  */
+static int match_vector(const float *values, int nb_indexes, int i, float value)
+{
+    return values[i] <= value && (i == nb_indexes - 1 || values[i + 1] > value);
+}
+
 static int get_vector_id(const float *values, int nb_values, int *cache, float value)
 {
-    int ret = -1;
     const int nb_indexes = nb_values - 1;
     const int start = *cache;
 
-    for (int i = start; i < nb_indexes; i++) {
-        if (values[i] > value)
-            break;
-        ret = i;
+    if (match_vector(values, nb_indexes, start, value))
+        return start;
+    if (start + 1 < nb_indexes && match_vector(values, nb_indexes, start + 1, value)) {
+        *cache = start + 1;
+        return start + 1;
     }
-    if (ret < 0) {
-        for (int i = 0; i < nb_indexes; i++) {
-            if (values[i] > value)
-                break;
-            ret = i;
-        }
+
+    /* Find the first value strictly above the requested one */
+    int lo = 0, hi = nb_indexes;
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (values[mid] > value)
+            hi = mid;
+        else
+            lo = mid + 1;
     }
+
     /*
-     * We only need to clamp the negative boundary because ret can never reach
+     * We only need to clamp the negative boundary because lo can never exceed
      * nb_indexes, meaning the maximum value is nb_indexes-1, or nb_values-2.
      */
-    ret = NGLI_MAX(ret, 0);
+    const int ret = NGLI_MAX(lo - 1, 0);
     *cache = ret;
     return ret;
 }
@@ -618,11 +680,9 @@ static float remap(float a, float b, float c, float d, float x)
  * https://pomax.github.io/bezierinfo/#arclengthapprox
  * https://pomax.github.io/bezierinfo/#tracing
  */
-void ngli_path_evaluate(struct path *s, float *dst, float distance)
+static void evaluate_arc(const struct path *s, float *dst, int arc_id, float distance)
 {
     const float *distances = ngli_darray_data(&s->steps_dist);
-    const int nb_dists = (int)ngli_darray_count(&s->steps_dist);
-    const int arc_id = get_vector_id(distances, nb_dists, &s->current_arc, distance);
     const int segment_id = s->arc_to_segment[arc_id];
     const struct path_segment *segments = ngli_darray_data(&s->segments);
     const struct path_segment *segment = &segments[segment_id];
@@ -636,12 +696,48 @@ void ngli_path_evaluate(struct path *s, float *dst, float distance)
     poly_eval(dst, segment, t);
 }
 
+void ngli_path_evaluate(struct path *s, float *dst, float distance)
+{
+    const float *distances = ngli_darray_data(&s->steps_dist);
+    const int nb_dists = (int)ngli_darray_count(&s->steps_dist);
+    const int arc_id = get_vector_id(distances, nb_dists, &s->current_arc, distance);
+    evaluate_arc(s, dst, arc_id, distance);
+}
+
+/*
+ * Same as ngli_path_evaluate() for every distance, but an ascending distance
+ * walks forward from the previous arc instead of searching for it: sampling
+ * the whole path in order costs one pass over the arcs.
+ */
+void ngli_path_evaluate_batch(struct path *s, float *dst, const float *distances, size_t count)
+{
+    const float *steps_dist = ngli_darray_data(&s->steps_dist);
+    const int nb_dists = (int)ngli_darray_count(&s->steps_dist);
+    const int last_arc = nb_dists - 2;
+
+    for (size_t i = 0; i < count; i++) {
+        const float distance = distances[i];
+        if (i > 0 && distance >= distances[i - 1]) {
+            while (s->current_arc < last_arc && steps_dist[s->current_arc + 1] <= distance)
+                s->current_arc++;
+        } else {
+            get_vector_id(steps_dist, nb_dists, &s->current_arc, distance);
+        }
+        evaluate_arc(s, dst + i * 3, s->current_arc, distance);
+    }
+}
+
 const struct darray *ngli_path_get_segments(const struct path *s)
 {
     ngli_assert(s->state == PATH_STATE_INITIALIZED || s->state == PATH_STATE_FINALIZED);
     return &s->segments;
 }
 
+uint32_t ngli_path_get_revision(const struct path *s)
+{
+    return s->revision;
+}
+
 void ngli_path_clear(struct path *s)
 {
     s->state = PATH_STATE_DEFAULT;
@@ -651,9 +747,10 @@ void ngli_path_clear(struct path *s)
     ngli_darray_clear(&s->segments);
     ngli_darray_clear(&s->steps);
     ngli_darray_clear(&s->steps_dist);
-    memset(s->origin, 0, sizeof(*s->origin));
-    memset(s->cursor, 0, sizeof(*s->cursor));
+    memset(s->origin, 0, sizeof(s->origin));
+    memset(s->cursor, 0, sizeof(s->cursor));
     s->segment_flags = 0;
+    s->revision++;
 }
 
 void ngli_path_freep(struct path **sp)
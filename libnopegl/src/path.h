@@ -23,6 +23,7 @@
 #ifndef PATH_H
 #define PATH_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 struct path;
@@ -74,12 +75,24 @@ int ngli_path_init(struct path *s, int32_t precision);
 /* Evaluate an initialized path */
 void ngli_path_evaluate(struct path *s, float *dst, float distance);
 
+/*
+ * Evaluate an initialized path at `count` distances, writing `count` 3D points
+ * in `dst`. Sorted distances are the fastest to evaluate.
+ */
+void ngli_path_evaluate_batch(struct path *s, float *dst, const float *distances, size_t count);
+
 /*
  * Read back every segment. Require the path to be initialized or at least
  * finalized.
  */
 const struct darray *ngli_path_get_segments(const struct path *s);
 
+/*
+ * Get the number of times the path was cleared. Along with the path pointer,
+ * it allows the users to detect that a path has been reconstructed.
+ */
+uint32_t ngli_path_get_revision(const struct path *s);
+
 /*
  * Clear the segments. It is possible to re-use the same path to construct
  * another one, but it will require a new initialization.
@@ -58,6 +58,9 @@ struct pipeline_compat {
     const struct ngpu_pgcraft_compat_info *compat_info;
     struct ngpu_buffer *ubuffers[NGPU_PROGRAM_STAGE_NB];
     uint8_t *mapped_datas[NGPU_PROGRAM_STAGE_NB];
+    /* CPU copies of the uniform blocks, used without persistent mapping */
+    uint8_t *shadow_datas[NGPU_PROGRAM_STAGE_NB];
+    int shadow_dirty[NGPU_PROGRAM_STAGE_NB];
 };
 
 static int wait_buffer(struct pipeline_compat *s, enum ngpu_program_stage stage)
@@ -69,23 +72,23 @@ static int wait_buffer(struct pipeline_compat *s, enum ngpu_program_stage stage)
     return ngpu_buffer_wait(buffer);
 }
 
-static int map_buffer(struct pipeline_compat *s, enum ngpu_program_stage stage)
-{
-    if (s->mapped_datas[stage])
-        return 0;
-
-    struct ngpu_buffer *buffer = s->ubuffers[stage];
-    return ngpu_buffer_map(buffer, 0, buffer->size, (void **) &s->mapped_datas[stage]);
-}
-
-static void unmap_buffers(struct pipeline_compat *s)
+/*
+ * Without persistent mapping, mapping the uniform buffer would wait for the
+ * GPU to be done with it. Instead, the uniforms are written in a CPU copy and
+ * the whole block is submitted before the draw, which allows the backend to
+ * orphan the buffer storage if it is still in use.
+ */
+static int flush_shadow_buffers(struct pipeline_compat *s)
 {
     for (size_t i = 0; i < NGPU_PROGRAM_STAGE_NB; i++) {
-        if (s->mapped_datas[i]) {
-            ngpu_buffer_unmap(s->ubuffers[i]);
-            s->mapped_datas[i] = NULL;
-        }
+        if (!s->shadow_dirty[i])
+            continue;
+        int ret = ngpu_buffer_replace(s->ubuffers[i], s->shadow_datas[i]);
+        if (ret < 0)
+            return ret;
+        s->shadow_dirty[i] = 0;
     }
+    return 0;
 }
 
 struct pipeline_compat *ngli_pipeline_compat_create(struct ngpu_ctx *gpu_ctx)
@@ -126,6 +129,10 @@ static int init_blocks_buffers(struct pipeline_compat *s, const struct pipeline_
             ret = ngpu_buffer_map(buffer, 0, buffer->size, (void **) &s->mapped_datas[i]);
             if (ret < 0)
                 return ret;
+        } else {
+            s->shadow_datas[i] = ngli_calloc(1, block_size);
+            if (!s->shadow_datas[i])
+                return NGL_ERROR_MEMORY;
         }
 
         ngli_pipeline_compat_update_buffer(s, s->compat_info->uindices[i], buffer, 0, buffer->size);
@@ -287,17 +294,22 @@ int ngli_pipeline_compat_update_uniform_count(struct pipeline_compat *s, int32_t
     const struct ngpu_block_field *fields = ngli_darray_data(&block->fields);
     const struct ngpu_block_field *field = &fields[field_index];
     if (value) {
+        uint8_t *data;
         if (!(gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT)) {
-            int ret = map_buffer(s, stage);
-            if (ret < 0)
-                return ret;
+            data = s->shadow_datas[stage];
+            s->shadow_dirty[stage] = 1;
         } else {
             int ret = wait_buffer(s, stage);
             if (ret < 0)
                 return ret;
+            data = s->mapped_datas[stage];
         }
-        uint8_t *dst = s->mapped_datas[stage] + field->offset;
+        uint8_t *dst = data + field->offset;
         ngpu_block_field_copy_count(field, dst, value, count);
+
+        /* The shadow copies are accounted when they are submitted */
+        if (gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT)
+            gpu_ctx->nb_uploaded_bytes += field->stride * NGLI_MAX(count ? count : field->count, 1);
     }
 
     return 0;
@@ -543,8 +555,11 @@ static int prepare_pipeline(struct pipeline_compat *s)
 {
     struct ngpu_ctx *gpu_ctx = s->gpu_ctx;
 
-    if (!(gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT))
-       unmap_buffers(s);
+    if (!(gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT)) {
+        int ret = flush_shadow_buffers(s);
+        if (ret < 0)
+            return ret;
+    }
 
     int ret = prepare_bindgroup(s);
     if (ret < 0)
@@ -622,6 +637,7 @@ void ngli_pipeline_compat_freep(struct pipeline_compat **sp)
                     ngpu_buffer_unmap(s->ubuffers[i]);
                 ngpu_buffer_freep(&s->ubuffers[i]);
             }
+            ngli_freep(&s->shadow_datas[i]);
         }
     }
     ngli_freep(sp);
@@ -21,6 +21,7 @@
  * under the License.
  */
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -30,6 +31,7 @@
 #include "ngpu/rendertarget.h"
 #include "rtt.h"
 #include "utils/memory.h"
+#include "utils/utils.h"
 
 struct rtt_ctx {
     struct ngl_ctx *ctx;
@@ -51,6 +53,8 @@ struct rtt_ctx {
     int started;
     struct ngpu_viewport prev_viewport;
     struct ngpu_scissor prev_scissor;
+    struct ngpu_scissor prev_content_area;
+    struct ngpu_scissor content_area;
     struct ngpu_rendertarget *prev_rendertargets[2];
     struct ngpu_rendertarget *prev_rendertarget;
 };
@@ -288,6 +292,7 @@ void ngli_rtt_begin(struct rtt_ctx *s)
     s->started = 1;
     s->prev_viewport = ctx->viewport;
     s->prev_scissor = ctx->scissor;
+    s->prev_content_area = ctx->content_area;
     s->prev_rendertargets[0] = ctx->available_rendertargets[0];
     s->prev_rendertargets[1] = ctx->available_rendertargets[1];
     s->prev_rendertarget = ctx->current_rendertarget;
@@ -301,6 +306,7 @@ void ngli_rtt_begin(struct rtt_ctx *s)
     const uint32_t height = s->params.height;
     ctx->viewport = (struct ngpu_viewport){0.f, 0.f, (float)width, (float)height};
     ctx->scissor = (struct ngpu_scissor){0, 0, width, height};
+    ctx->content_area = (struct ngpu_scissor){0};
 
     ctx->available_rendertargets[0] = s->available_rendertargets[0];
     ctx->available_rendertargets[1] = s->available_rendertargets[1];
@@ -325,6 +331,8 @@ void ngli_rtt_end(struct rtt_ctx *s)
     ctx->available_rendertargets[1] = s->prev_rendertargets[1];
     ctx->viewport = s->prev_viewport;
     ctx->scissor = s->prev_scissor;
+    s->content_area = ctx->content_area;
+    ctx->content_area = s->prev_content_area;
 
     for (size_t i = 0; i < s->params.nb_colors; i++) {
         struct ngpu_texture *texture = s->params.colors[i].attachment;
@@ -334,6 +342,51 @@ void ngli_rtt_end(struct rtt_ctx *s)
     }
 }
 
+void ngli_rtt_set_area(struct rtt_ctx *s, const struct ngli_aabb *area)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    const float width = (float)s->params.width;
+    const float height = (float)s->params.height;
+    const uint32_t x0 = (uint32_t)NGLI_CLAMP(floorf(area->x0 * width), 0.f, width);
+    const uint32_t y0 = (uint32_t)NGLI_CLAMP(floorf(area->y0 * height), 0.f, height);
+    const uint32_t x1 = (uint32_t)NGLI_CLAMP(ceilf(area->x1 * width), 0.f, width);
+    const uint32_t y1 = (uint32_t)NGLI_CLAMP(ceilf(area->y1 * height), 0.f, height);
+    ctx->scissor = (struct ngpu_scissor){x0, y0, NGLI_MAX(x1, x0) - x0, NGLI_MAX(y1, y0) - y0};
+    ngpu_ctx_set_scissor(ctx->gpu_ctx, &ctx->scissor);
+}
+
+void ngli_rtt_add_content_area(struct ngl_ctx *ctx, const struct ngpu_scissor *area)
+{
+    if (!area->width || !area->height)
+        return;
+
+    struct ngpu_scissor *dst = &ctx->content_area;
+    if (!dst->width || !dst->height) {
+        *dst = *area;
+        return;
+    }
+
+    const uint32_t x0 = NGLI_MIN(dst->x, area->x);
+    const uint32_t y0 = NGLI_MIN(dst->y, area->y);
+    const uint32_t x1 = NGLI_MAX(dst->x + dst->width, area->x + area->width);
+    const uint32_t y1 = NGLI_MAX(dst->y + dst->height, area->y + area->height);
+    *dst = (struct ngpu_scissor){x0, y0, x1 - x0, y1 - y0};
+}
+
+void ngli_rtt_get_content_area(const struct rtt_ctx *s, struct ngli_aabb *dst)
+{
+    const struct ngpu_scissor *area = &s->content_area;
+    const float width = (float)s->params.width;
+    const float height = (float)s->params.height;
+    *dst = (struct ngli_aabb){
+        .x0 = (float)area->x / width,
+        .y0 = (float)area->y / height,
+        .x1 = (float)(area->x + area->width) / width,
+        .y1 = (float)(area->y + area->height) / height,
+    };
+}
+
 void ngli_rtt_freep(struct rtt_ctx **sp)
 {
     struct rtt_ctx *s = *sp;
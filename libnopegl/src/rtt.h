@@ -25,11 +25,13 @@
 
 #include <stdint.h>
 
+#include "box.h"
 #include "image.h"
 #include "ngpu/limits.h"
 #include "ngpu/rendertarget.h"
 
 struct ngl_ctx;
+struct ngpu_scissor;
 struct rtt_ctx;
 
 struct rtt_params {
@@ -53,6 +55,21 @@ struct ngpu_texture *ngli_rtt_get_texture(struct rtt_ctx *s, size_t index);
 struct image *ngli_rtt_get_image(struct rtt_ctx *s, size_t index);
 void ngli_rtt_begin(struct rtt_ctx *s);
 void ngli_rtt_end(struct rtt_ctx *s);
+
+/*
+ * Restrict the rasterization of the started render pass to a normalized area
+ * (in the [0,1] range) of the render target
+ */
+void ngli_rtt_set_area(struct rtt_ctx *s, const struct ngli_aabb *area);
+
+/*
+ * The draws report the area of the current render target they touch so that
+ * the rest of the target is known to only hold the clear color
+ */
+void ngli_rtt_add_content_area(struct ngl_ctx *ctx, const struct ngpu_scissor *area);
+
+/* Normalized area touched by the draws between the last begin/end */
+void ngli_rtt_get_content_area(const struct rtt_ctx *s, struct ngli_aabb *dst);
 void ngli_rtt_freep(struct rtt_ctx **sp);
 
 #endif
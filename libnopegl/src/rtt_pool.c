@@ -0,0 +1,216 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "internal.h"
+#include "log.h"
+#include "ngpu/ctx.h"
+#include "rtt.h"
+#include "rtt_pool.h"
+#include "utils/darray.h"
+#include "utils/memory.h"
+
+struct entry {
+    struct ngpu_texture_params params;
+    size_t nb_colors;
+    struct ngpu_texture *textures[NGPU_MAX_COLOR_ATTACHMENTS];
+    struct rtt_ctx *rtt_ctx;
+    int in_use;
+    int used;
+};
+
+struct rtt_pool {
+    struct ngl_ctx *ctx;
+    struct darray entries; // array of struct entry pointers
+};
+
+static void free_entry(struct entry **entryp)
+{
+    struct entry *entry = *entryp;
+    if (!entry)
+        return;
+
+    ngli_rtt_freep(&entry->rtt_ctx);
+    for (size_t i = 0; i < entry->nb_colors; i++)
+        ngpu_texture_freep(&entry->textures[i]);
+    ngli_freep(entryp);
+}
+
+static void free_entry_ptr(void *user_arg, void *data)
+{
+    free_entry(data);
+}
+
+struct rtt_pool *ngli_rtt_pool_create(struct ngl_ctx *ctx)
+{
+    struct rtt_pool *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->ctx = ctx;
+    ngli_darray_init(&s->entries, sizeof(struct entry *), 0);
+    ngli_darray_set_free_func(&s->entries, free_entry_ptr, NULL);
+    return s;
+}
+
+static int texture_params_are_equal(const struct ngpu_texture_params *a, const struct ngpu_texture_params *b)
+{
+    return a->type          == b->type          &&
+           a->format        == b->format        &&
+           a->width         == b->width         &&
+           a->height        == b->height        &&
+           a->depth         == b->depth         &&
+           a->samples       == b->samples       &&
+           a->min_filter    == b->min_filter    &&
+           a->mag_filter    == b->mag_filter    &&
+           a->mipmap_filter == b->mipmap_filter &&
+           a->wrap_s        == b->wrap_s        &&
+           a->wrap_t        == b->wrap_t        &&
+           a->wrap_r        == b->wrap_r        &&
+           a->usage         == b->usage;
+}
+
+static struct entry *create_entry(struct rtt_pool *s, const struct ngpu_texture_params *params, size_t nb_colors)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+
+    struct entry *entry = ngli_calloc(1, sizeof(*entry));
+    if (!entry)
+        return NULL;
+
+    entry->params = *params;
+    entry->nb_colors = nb_colors;
+
+    struct rtt_params rtt_params = {
+        .width     = params->width,
+        .height    = params->height,
+        .nb_colors = nb_colors,
+    };
+
+    for (size_t i = 0; i < nb_colors; i++) {
+        entry->textures[i] = ngpu_texture_create(gpu_ctx);
+        if (!entry->textures[i])
+            goto fail;
+
+        int ret = ngpu_texture_init(entry->textures[i], params);
+        if (ret < 0)
+            goto fail;
+
+        /* The content of a transient render target never outlives a draw */
+        rtt_params.colors[i] = (struct ngpu_attachment) {
+            .attachment = entry->textures[i],
+            .load_op    = NGPU_LOAD_OP_CLEAR,
+            .store_op   = NGPU_STORE_OP_STORE,
+        };
+    }
+
+    entry->rtt_ctx = ngli_rtt_create(ctx);
+    if (!entry->rtt_ctx)
+        goto fail;
+
+    int ret = ngli_rtt_init(entry->rtt_ctx, &rtt_params);
+    if (ret < 0)
+        goto fail;
+
+    if (!ngli_darray_push(&s->entries, &entry))
+        goto fail;
+
+    return entry;
+
+fail:
+    free_entry(&entry);
+    return NULL;
+}
+
+struct rtt_ctx *ngli_rtt_pool_acquire(struct rtt_pool *s, const struct ngpu_texture_params *params, size_t nb_colors)
+{
+    ngli_assert(nb_colors > 0 && nb_colors <= NGPU_MAX_COLOR_ATTACHMENTS);
+
+    struct entry *entry = NULL;
+    struct entry **entries = ngli_darray_data(&s->entries);
+    for (size_t i = 0; i < ngli_darray_count(&s->entries); i++) {
+        if (!entries[i]->in_use &&
+            entries[i]->nb_colors == nb_colors &&
+            texture_params_are_equal(&entries[i]->params, params)) {
+            entry = entries[i];
+            break;
+        }
+    }
+
+    if (!entry) {
+        entry = create_entry(s, params, nb_colors);
+        if (!entry) {
+            LOG(ERROR, "unable to create transient render target: %ux%u", params->width, params->height);
+            return NULL;
+        }
+    }
+
+    entry->in_use = 1;
+    entry->used = 1;
+    return entry->rtt_ctx;
+}
+
+void ngli_rtt_pool_release(struct rtt_pool *s, struct rtt_ctx **rtt_ctxp)
+{
+    struct rtt_ctx *rtt_ctx = *rtt_ctxp;
+    if (!rtt_ctx)
+        return;
+
+    struct entry **entries = ngli_darray_data(&s->entries);
+    for (size_t i = 0; i < ngli_darray_count(&s->entries); i++) {
+        if (entries[i]->rtt_ctx == rtt_ctx) {
+            ngli_assert(entries[i]->in_use);
+            entries[i]->in_use = 0;
+            break;
+        }
+    }
+    *rtt_ctxp = NULL;
+}
+
+void ngli_rtt_pool_collect(struct rtt_pool *s)
+{
+    size_t i = 0;
+    while (i < ngli_darray_count(&s->entries)) {
+        struct entry **entries = ngli_darray_data(&s->entries);
+        struct entry *entry = entries[i];
+        if (!entry->in_use && !entry->used) {
+            /*
+             * The textures may still be referenced by the in-flight frames,
+             * the GPU backends keep them alive until they are done with them
+             */
+            ngli_darray_remove(&s->entries, i);
+            continue;
+        }
+        entry->used = 0;
+        i++;
+    }
+}
+
+void ngli_rtt_pool_freep(struct rtt_pool **sp)
+{
+    struct rtt_pool *s = *sp;
+    if (!s)
+        return;
+    ngli_darray_reset(&s->entries);
+    ngli_freep(sp);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef RTT_POOL_H
+#define RTT_POOL_H
+
+#include <stddef.h>
+
+#include "ngpu/texture.h"
+
+struct ngl_ctx;
+struct rtt_ctx;
+struct rtt_pool;
+
+/*
+ * Pool of render targets used as transient intermediates by the nodes (blur
+ * passes typically).
+ *
+ * A node acquires a render target right before rendering to it, and releases
+ * it as soon as its content has been consumed, within the same draw call. A
+ * released render target can then be aliased by any node drawn later in the
+ * frame and requesting matching texture parameters, since their usages never
+ * overlap. Render targets which have not been acquired during a whole frame
+ * are destroyed by ngli_rtt_pool_collect().
+ */
+struct rtt_pool *ngli_rtt_pool_create(struct ngl_ctx *ctx);
+struct rtt_ctx *ngli_rtt_pool_acquire(struct rtt_pool *s, const struct ngpu_texture_params *params, size_t nb_colors);
+void ngli_rtt_pool_release(struct rtt_pool *s, struct rtt_ctx **rtt_ctxp);
+void ngli_rtt_pool_collect(struct rtt_pool *s);
+void ngli_rtt_pool_freep(struct rtt_pool **sp);
+
+#endif
@@ -21,9 +21,50 @@
  */
 
 #include <immintrin.h>
+#if defined(_MSC_VER)
+# include <intrin.h>
+#endif
 
 #include "math_utils.h"
 
+/*
+ * The AVX2 functions are compiled for their target only, the rest of the
+ * library keeps the baseline instruction set. MSVC needs no attribute to use
+ * the AVX2 intrinsics.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+# define TARGET_AVX2
+#else
+# define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+int ngli_cpu_has_avx2(void)
+{
+#if defined(_MSC_VER)
+    /* Every thread computes the same value, so the race is harmless */
+    static int has_avx2 = -1;
+    if (has_avx2 < 0) {
+        int regs[4];
+        __cpuid(regs, 0);
+        const int max_leaf = regs[0];
+        __cpuid(regs, 1);
+        const int fma     = regs[2] & (1 << 12);
+        const int osxsave = regs[2] & (1 << 27);
+        const int avx     = regs[2] & (1 << 28);
+        int avx2 = 0;
+        /* The OS must also save the YMM registers on context switches */
+        if (max_leaf >= 7 && fma && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(regs, 7, 0);
+            avx2 = regs[1] & (1 << 5);
+        }
+        has_avx2 = avx2 != 0;
+    }
+    return has_avx2;
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
 void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2)
 {
     __m128 m1_0 = _mm_load_ps(m1);
@@ -57,6 +98,57 @@ void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2)
     _mm_store_ps(dst + 12, r3);
 }
 
+void ngli_mat4_mul_array_sse(float *dst, const float *m1, const float *m2, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        ngli_mat4_mul_sse(dst + i * 16, m1 + i * 16, m2 + i * 16);
+}
+
+/*
+ * The columns of m1 are duplicated in both 128-bit lanes, and each lane of the
+ * m2 registers holds a different column: 2 columns of the result are computed
+ * at once, with half the instructions of the SSE version.
+ */
+TARGET_AVX2
+void ngli_mat4_mul_array_avx2(float *dst, const float *m1, const float *m2, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        const float *a = m1 + i * 16;
+        const float *b = m2 + i * 16;
+
+        const __m256 a0 = _mm256_broadcast_ps((const __m128 *)a);
+        const __m256 a1 = _mm256_broadcast_ps((const __m128 *)(a + 4));
+        const __m256 a2 = _mm256_broadcast_ps((const __m128 *)(a + 8));
+        const __m256 a3 = _mm256_broadcast_ps((const __m128 *)(a + 12));
+
+        const __m256 b01 = _mm256_loadu_ps(b);
+        const __m256 b23 = _mm256_loadu_ps(b + 8);
+
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, _MM_SHUFFLE(0, 0, 0, 0)));
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, _MM_SHUFFLE(0, 0, 0, 0)));
+
+        r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, _MM_SHUFFLE(1, 1, 1, 1)), r01);
+        r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, _MM_SHUFFLE(1, 1, 1, 1)), r23);
+
+        r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, _MM_SHUFFLE(2, 2, 2, 2)), r01);
+        r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, _MM_SHUFFLE(2, 2, 2, 2)), r23);
+
+        r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, _MM_SHUFFLE(3, 3, 3, 3)), r01);
+        r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, _MM_SHUFFLE(3, 3, 3, 3)), r23);
+
+        _mm256_storeu_ps(dst + i * 16,     r01);
+        _mm256_storeu_ps(dst + i * 16 + 8, r23);
+    }
+}
+
+void ngli_mat4_mul_array_x86(float *dst, const float *m1, const float *m2, size_t count)
+{
+    if (ngli_cpu_has_avx2())
+        ngli_mat4_mul_array_avx2(dst, m1, m2, count);
+    else
+        ngli_mat4_mul_array_sse(dst, m1, m2, count);
+}
+
 void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v)
 {
     __m128 m0 = _mm_load_ps(m);
@@ -73,3 +165,218 @@ void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v)
 
     _mm_store_ps(dst, r);
 }
+
+void ngli_mat4_mul_vec4_array_sse(float *dst, const float *m, const float *v, size_t count)
+{
+    /* The matrix is loaded once and kept in registers for all the vectors */
+    __m128 m0 = _mm_load_ps(m);
+    __m128 m1 = _mm_load_ps(m + 4);
+    __m128 m2 = _mm_load_ps(m + 8);
+    __m128 m3 = _mm_load_ps(m + 12);
+
+    for (size_t i = 0; i < count; i++) {
+        __m128 vec = _mm_load_ps(v + i * 4);
+
+        __m128 r0 = _mm_mul_ps(m0, _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(0, 0, 0, 0)));
+        __m128 r1 = _mm_mul_ps(m1, _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1)));
+        __m128 r2 = _mm_mul_ps(m2, _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 2, 2, 2)));
+        __m128 r3 = _mm_mul_ps(m3, _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(3, 3, 3, 3)));
+
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_add_ps(r0, r1), r2), r3);
+
+        _mm_store_ps(dst + i * 4, r);
+    }
+}
+
+/*
+ * Matrix inversion on several matrices at once: the matrices are transposed so
+ * that each register holds the same element of every matrix, and the scalar
+ * formula of ngli_mat4_inverse() is then applied to all the lanes. The vector
+ * operations are defined by the caller.
+ */
+#define DOT3(a, x, b, y, c, z) VADD(VSUB(VMUL(a, x), VMUL(b, y)), VMUL(c, z))
+
+#define MAT4_INVERSE_SOA(type, o, m) do {                                           \
+    const type x00 = VSUB(VMUL(m[ 4], m[ 9]), VMUL(m[ 5], m[ 8]));                  \
+    const type x01 = VSUB(VMUL(m[ 4], m[13]), VMUL(m[ 5], m[12]));                  \
+    const type x02 = VSUB(VMUL(m[ 4], m[10]), VMUL(m[ 6], m[ 8]));                  \
+    const type x03 = VSUB(VMUL(m[ 4], m[11]), VMUL(m[ 7], m[ 8]));                  \
+    const type x04 = VSUB(VMUL(m[ 4], m[14]), VMUL(m[ 6], m[12]));                  \
+    const type x05 = VSUB(VMUL(m[ 4], m[15]), VMUL(m[ 7], m[12]));                  \
+    const type x06 = VSUB(VMUL(m[ 5], m[10]), VMUL(m[ 6], m[ 9]));                  \
+    const type x07 = VSUB(VMUL(m[ 5], m[11]), VMUL(m[ 7], m[ 9]));                  \
+    const type x08 = VSUB(VMUL(m[ 6], m[11]), VMUL(m[ 7], m[10]));                  \
+    const type x09 = VSUB(VMUL(m[ 5], m[14]), VMUL(m[ 6], m[13]));                  \
+    const type x10 = VSUB(VMUL(m[ 5], m[15]), VMUL(m[ 7], m[13]));                  \
+    const type x11 = VSUB(VMUL(m[ 6], m[15]), VMUL(m[ 7], m[14]));                  \
+    const type x12 = VSUB(VMUL(m[ 8], m[13]), VMUL(m[ 9], m[12]));                  \
+    const type x13 = VSUB(VMUL(m[ 8], m[14]), VMUL(m[10], m[12]));                  \
+    const type x14 = VSUB(VMUL(m[ 8], m[15]), VMUL(m[11], m[12]));                  \
+    const type x15 = VSUB(VMUL(m[ 9], m[14]), VMUL(m[10], m[13]));                  \
+    const type x16 = VSUB(VMUL(m[ 9], m[15]), VMUL(m[11], m[13]));                  \
+    const type x17 = VSUB(VMUL(m[10], m[15]), VMUL(m[11], m[14]));                  \
+                                                                                    \
+    const type det_p0 = DOT3(m[5], x17, m[6], x16, m[7], x15);                      \
+    const type det_p1 = DOT3(m[4], x17, m[6], x14, m[7], x13);                      \
+    const type det_p2 = DOT3(m[4], x16, m[5], x14, m[7], x12);                      \
+    const type det_p3 = DOT3(m[4], x15, m[5], x13, m[6], x12);                      \
+                                                                                    \
+    const type det = VSUB(DOT3(m[0], det_p0, m[1], det_p1, m[2], det_p2),           \
+                          VMUL(m[3], det_p3));                                      \
+    const type singular = VCMPEQ(det, VSET1(0.f));                                  \
+    const type pdet = VDIV(VSET1(1.f), det);                                        \
+    const type ndet = VSUB(VSET1(0.f), pdet);                                       \
+                                                                                    \
+    o[ 0] = VMUL(pdet, det_p0);                                                     \
+    o[ 1] = VMUL(ndet, DOT3(m[1], x17, m[2], x16, m[3], x15));                      \
+    o[ 2] = VMUL(pdet, DOT3(m[1], x11, m[2], x10, m[3], x09));                      \
+    o[ 3] = VMUL(ndet, DOT3(m[1], x08, m[2], x07, m[3], x06));                      \
+    o[ 4] = VMUL(ndet, det_p1);                                                     \
+    o[ 5] = VMUL(pdet, DOT3(m[0], x17, m[2], x14, m[3], x13));                      \
+    o[ 6] = VMUL(ndet, DOT3(m[0], x11, m[2], x05, m[3], x04));                      \
+    o[ 7] = VMUL(pdet, DOT3(m[0], x08, m[2], x03, m[3], x02));                      \
+    o[ 8] = VMUL(pdet, det_p2);                                                     \
+    o[ 9] = VMUL(ndet, DOT3(m[0], x16, m[1], x14, m[3], x12));                      \
+    o[10] = VMUL(pdet, DOT3(m[0], x10, m[1], x05, m[3], x01));                      \
+    o[11] = VMUL(ndet, DOT3(m[0], x07, m[1], x03, m[3], x00));                      \
+    o[12] = VMUL(ndet, det_p3);                                                     \
+    o[13] = VMUL(pdet, DOT3(m[0], x15, m[1], x13, m[2], x12));                      \
+    o[14] = VMUL(ndet, DOT3(m[0], x09, m[1], x04, m[2], x01));                      \
+    o[15] = VMUL(pdet, DOT3(m[0], x06, m[1], x02, m[2], x00));                      \
+                                                                                    \
+    /* A singular matrix is copied as is */                                         \
+    for (size_t j = 0; j < 16; j++)                                                 \
+        o[j] = VSELECT(singular, m[j], o[j]);                                       \
+} while (0)
+
+#define VADD(a, b)         _mm_add_ps(a, b)
+#define VSUB(a, b)         _mm_sub_ps(a, b)
+#define VMUL(a, b)         _mm_mul_ps(a, b)
+#define VDIV(a, b)         _mm_div_ps(a, b)
+#define VSET1(x)           _mm_set1_ps(x)
+#define VCMPEQ(a, b)       _mm_cmpeq_ps(a, b)
+#define VSELECT(mask, a, b) _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b))
+
+void ngli_mat4_inverse_array_sse(float *dst, const float *m, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float *src = m + i * 16;
+        __m128 e[16], o[16];
+
+        for (size_t k = 0; k < 4; k++) {
+            __m128 r0 = _mm_load_ps(src + 0 * 16 + k * 4);
+            __m128 r1 = _mm_load_ps(src + 1 * 16 + k * 4);
+            __m128 r2 = _mm_load_ps(src + 2 * 16 + k * 4);
+            __m128 r3 = _mm_load_ps(src + 3 * 16 + k * 4);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            e[k * 4 + 0] = r0;
+            e[k * 4 + 1] = r1;
+            e[k * 4 + 2] = r2;
+            e[k * 4 + 3] = r3;
+        }
+
+        MAT4_INVERSE_SOA(__m128, o, e);
+
+        float *out = dst + i * 16;
+        for (size_t k = 0; k < 4; k++) {
+            __m128 r0 = o[k * 4 + 0];
+            __m128 r1 = o[k * 4 + 1];
+            __m128 r2 = o[k * 4 + 2];
+            __m128 r3 = o[k * 4 + 3];
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_store_ps(out + 0 * 16 + k * 4, r0);
+            _mm_store_ps(out + 1 * 16 + k * 4, r1);
+            _mm_store_ps(out + 2 * 16 + k * 4, r2);
+            _mm_store_ps(out + 3 * 16 + k * 4, r3);
+        }
+    }
+
+    for (; i < count; i++)
+        ngli_mat4_inverse(dst + i * 16, m + i * 16);
+}
+
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VDIV
+#undef VSET1
+#undef VCMPEQ
+#undef VSELECT
+
+#define VADD(a, b)         _mm256_add_ps(a, b)
+#define VSUB(a, b)         _mm256_sub_ps(a, b)
+#define VMUL(a, b)         _mm256_mul_ps(a, b)
+#define VDIV(a, b)         _mm256_div_ps(a, b)
+#define VSET1(x)           _mm256_set1_ps(x)
+#define VCMPEQ(a, b)       _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define VSELECT(mask, a, b) _mm256_blendv_ps(b, a, mask)
+
+/* Transpose the 4x4 blocks held in the low and high lanes of 4 registers */
+#define TRANSPOSE4_LANES(r0, r1, r2, r3) do {                           \
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);                       \
+    const __m256 t1 = _mm256_unpacklo_ps(r2, r3);                       \
+    const __m256 t2 = _mm256_unpackhi_ps(r0, r1);                       \
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);                       \
+    r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));            \
+    r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));            \
+    r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));            \
+    r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));            \
+} while (0)
+
+/* Matrices i and i+4 of a group of 8 share the registers, one per lane */
+#define LOAD_LANES(src, i, k) \
+    _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps((src) + (i) * 16 + (k) * 4)), \
+                         _mm_load_ps((src) + ((i) + 4) * 16 + (k) * 4), 1)
+
+#define STORE_LANES(dst, i, k, r) do {                                          \
+    _mm_store_ps((dst) + (i) * 16 + (k) * 4, _mm256_castps256_ps128(r));        \
+    _mm_store_ps((dst) + ((i) + 4) * 16 + (k) * 4, _mm256_extractf128_ps(r, 1)); \
+} while (0)
+
+TARGET_AVX2
+void ngli_mat4_inverse_array_avx2(float *dst, const float *m, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float *src = m + i * 16;
+        __m256 e[16], o[16];
+
+        for (size_t k = 0; k < 4; k++) {
+            __m256 r0 = LOAD_LANES(src, 0, k);
+            __m256 r1 = LOAD_LANES(src, 1, k);
+            __m256 r2 = LOAD_LANES(src, 2, k);
+            __m256 r3 = LOAD_LANES(src, 3, k);
+            TRANSPOSE4_LANES(r0, r1, r2, r3);
+            e[k * 4 + 0] = r0;
+            e[k * 4 + 1] = r1;
+            e[k * 4 + 2] = r2;
+            e[k * 4 + 3] = r3;
+        }
+
+        MAT4_INVERSE_SOA(__m256, o, e);
+
+        float *out = dst + i * 16;
+        for (size_t k = 0; k < 4; k++) {
+            __m256 r0 = o[k * 4 + 0];
+            __m256 r1 = o[k * 4 + 1];
+            __m256 r2 = o[k * 4 + 2];
+            __m256 r3 = o[k * 4 + 3];
+            TRANSPOSE4_LANES(r0, r1, r2, r3);
+            STORE_LANES(out, 0, k, r0);
+            STORE_LANES(out, 1, k, r1);
+            STORE_LANES(out, 2, k, r2);
+            STORE_LANES(out, 3, k, r3);
+        }
+    }
+
+    ngli_mat4_inverse_array_sse(dst + i * 16, m + i * 16, count - i);
+}
+
+void ngli_mat4_inverse_array_x86(float *dst, const float *m, size_t count)
+{
+    if (ngli_cpu_has_avx2())
+        ngli_mat4_inverse_array_avx2(dst, m, count);
+    else
+        ngli_mat4_inverse_array_sse(dst, m, count);
+}
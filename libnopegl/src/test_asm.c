@@ -20,6 +20,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "math_utils.h"
@@ -42,6 +43,42 @@ static void flt_check(const float *f, size_t size)
     printf("=> OK\n");
 }
 
+typedef void (*mul_array_func)(float *dst, const float *m1, const float *m2, size_t count);
+typedef void (*inverse_array_func)(float *dst, const float *m, size_t count);
+
+/* The batch results are computed in place, to also check aliasing */
+static void check_mul_array(float (*ref)[4*4], const float (*m1)[4*4], const float (*m2)[4*4],
+                            size_t count, mul_array_func mul_array)
+{
+    float NGLI_ATTR_ALIGNED out[16][4*4];
+    float NGLI_ATTR_ALIGNED diff[4*4];
+    ngli_assert(count <= NGLI_ARRAY_NB(out));
+
+    memcpy(out, m1, count * sizeof(*out));
+    mul_array(out[0], out[0], m2[0], count);
+    for (size_t i = 0; i < count; i++) {
+        flt_diff(diff, ref[i], out[i], 4*4);
+        printf("diff %zu/%zu:\n" NGLI_FMT_MAT4 "\n", i + 1, count, NGLI_ARG_MAT4(diff));
+        flt_check(diff, 4*4);
+    }
+}
+
+static void check_inverse_array(float (*ref)[4*4], const float (*m)[4*4],
+                                size_t count, inverse_array_func inverse_array)
+{
+    float NGLI_ATTR_ALIGNED out[16][4*4];
+    float NGLI_ATTR_ALIGNED diff[4*4];
+    ngli_assert(count <= NGLI_ARRAY_NB(out));
+
+    memcpy(out, m, count * sizeof(*out));
+    inverse_array(out[0], out[0], count);
+    for (size_t i = 0; i < count; i++) {
+        flt_diff(diff, ref[i], out[i], 4*4);
+        printf("diff %zu/%zu:\n" NGLI_FMT_MAT4 "\n", i + 1, count, NGLI_ARG_MAT4(diff));
+        flt_check(diff, 4*4);
+    }
+}
+
 int main(void)
 {
     static const NGLI_ALIGNED_MAT(m1) = {
@@ -95,5 +132,67 @@ int main(void)
         flt_check(v_diff, 4);
     }
 
+    /* The 4 columns of m2 as vectors, transformed in place to check aliasing */
+    printf(":: Testing mat4 mul vec4 array\n");
+
+    NGLI_ALIGNED_MAT(v_ref);
+    NGLI_ALIGNED_MAT(v_out);
+    memcpy(v_out, m2, sizeof(m2));
+    ngli_mat4_mul_vec4_array_c(v_ref, m1, m2, 4);
+    ngli_mat4_mul_vec4_array(v_out, m1, v_out, 4);
+    flt_diff(m_diff, v_ref, v_out, 4*4);
+    printf("diff:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_diff));
+    flt_check(m_diff, 4*4);
+
+    /*
+     * Batches of 11 matrices derived from m1 and m2, with a singular one, to
+     * cover the vector groups as well as the remaining matrices
+     */
+    enum { NB_MATS = 11 };
+    float NGLI_ATTR_ALIGNED batch_m1[NB_MATS][4*4];
+    float NGLI_ATTR_ALIGNED batch_m2[NB_MATS][4*4];
+    float NGLI_ATTR_ALIGNED batch_ref[NB_MATS][4*4];
+    float NGLI_ATTR_ALIGNED batch_out[NB_MATS][4*4];
+    for (size_t i = 0; i < NB_MATS; i++) {
+        memcpy(batch_m1[i], i & 1 ? m2 : m1, sizeof(m1));
+        memcpy(batch_m2[i], i & 1 ? m1 : m2, sizeof(m2));
+        for (size_t j = 0; j < 4; j++) {
+            batch_m1[i][j * 5] += 0.1f * (float)i;
+            batch_m2[i][j * 5] -= 0.1f * (float)i;
+        }
+    }
+    memset(batch_m1[5], 0, sizeof(batch_m1[5]));
+
+    printf(":: Testing mat4 mul array\n");
+
+    ngli_mat4_mul_array_c(batch_ref[0], batch_m1[0], batch_m2[0], NB_MATS);
+    check_mul_array(batch_ref, batch_m1, batch_m2, NB_MATS, ngli_mat4_mul_array);
+#ifdef HAVE_X86_INTR
+    printf(":: Testing mat4 mul array (SSE)\n");
+    check_mul_array(batch_ref, batch_m1, batch_m2, NB_MATS, ngli_mat4_mul_array_sse);
+    if (ngli_cpu_has_avx2()) {
+        printf(":: Testing mat4 mul array (AVX2)\n");
+        check_mul_array(batch_ref, batch_m1, batch_m2, NB_MATS, ngli_mat4_mul_array_avx2);
+    }
+#endif
+
+    printf(":: Testing mat4 inverse array\n");
+
+    ngli_mat4_inverse_array_c(batch_ref[0], batch_m1[0], NB_MATS);
+    for (size_t i = 0; i < NB_MATS; i++) {
+        ngli_mat4_inverse(batch_out[i], batch_m1[i]);
+        flt_diff(m_diff, batch_ref[i], batch_out[i], 4*4);
+        flt_check(m_diff, 4*4);
+    }
+    check_inverse_array(batch_ref, batch_m1, NB_MATS, ngli_mat4_inverse_array);
+#ifdef HAVE_X86_INTR
+    printf(":: Testing mat4 inverse array (SSE)\n");
+    check_inverse_array(batch_ref, batch_m1, NB_MATS, ngli_mat4_inverse_array_sse);
+    if (ngli_cpu_has_avx2()) {
+        printf(":: Testing mat4 inverse array (AVX2)\n");
+        check_inverse_array(batch_ref, batch_m1, NB_MATS, ngli_mat4_inverse_array_avx2);
+    }
+#endif
+
     return 0;
 }
@@ -29,10 +29,8 @@
 #define NB_REFS (16 + 2)
 #define MAX_ERR 1e-5
 
-static int check_value(struct path *path, float t, const float *ref)
+static int check_value(const float *value, float t, const float *ref)
 {
-    float value[3];
-    ngli_path_evaluate(path, value, t);
     if (!ref) {
         fprintf(stderr, "got:("NGLI_FMT_VEC3")\n", NGLI_ARG_VEC3(value));
         return 1;
@@ -54,13 +52,17 @@ static int evaluate_points(struct path *path, const float *refs, const char *tit
 {
     printf("test: %s\n", title);
 
+    /* We make sure t starts before 0 and ends after 1 to check for outbounds */
+    float t[NB_REFS];
+    for (int i = 0; i < NB_REFS; i++)
+        t[i] = (float)(i - 1) / ((NB_REFS - 2) - 1.f);
+
+    float values[NB_REFS][3];
+    ngli_path_evaluate_batch(path, values[0], t, NB_REFS);
+
     int ret = 0;
-    for (int i = 0; i < NB_REFS; i++) {
-        /* We make sure t starts before 0 and ends after 1 to check for
-         * outbounds */
-        const float t = (float)(i - 1) / ((NB_REFS - 2) - 1.f);
-        ret |= check_value(path, t, refs ? &refs[i * 3] : NULL);
-    }
+    for (int i = 0; i < NB_REFS; i++)
+        ret |= check_value(values[i], t[i], refs ? &refs[i * 3] : NULL);
 
     if (ret) {
         fprintf(stderr, "%s failed\n", title);
@@ -87,24 +89,24 @@ static int test_bezier3_vec3(void)
     };
 
     static const float refs[] = {
-       -0.819247f,  0.0975617f,   0.329433f,
+       -0.820891f,  0.0992776f,    0.32992f,
             -0.7f,        0.0f,        0.3f,
-       -0.584421f, -0.0462202f,   0.281569f,
-       -0.471648f, -0.0502734f,   0.271273f,
-       -0.360823f, -0.0213343f,   0.266244f,
-       -0.251085f,  0.0314227f,   0.263616f,
-       -0.151888f,  0.0921073f,   0.260911f,
-      -0.0559586f,   0.155526f,   0.255954f,
-       0.0409618f,   0.217673f,   0.246764f,
-        0.139444f,   0.272461f,   0.231438f,
-        0.240059f,     0.3138f,   0.208073f,
-        0.328808f,   0.333964f,    0.18007f,
-        0.417249f,   0.336013f,    0.14468f,
-        0.508256f,   0.317196f,   0.100088f,
-        0.602161f,   0.273958f,  0.0451851f,
-        0.699298f,   0.202744f, -0.0211406f,
+       -0.582876f,  -0.046536f,   0.281382f,
+       -0.468625f, -0.0498829f,    0.27108f,
+       -0.356349f, -0.0195929f,    0.26611f,
+       -0.256171f,  0.0285763f,   0.263727f,
+        -0.15824f,  0.0879975f,   0.261136f,
+      -0.0599065f,    0.15291f,   0.256228f,
+       0.0398321f,   0.216984f,   0.246902f,
+        0.142287f,   0.273858f,   0.230891f,
+        0.247068f,   0.315994f,   0.206123f,
+        0.354815f,    0.33654f,   0.170458f,
+        0.444514f,   0.332681f,   0.132202f,
+        0.529311f,   0.309649f,  0.0885672f,
+        0.616648f,   0.265063f,  0.0359067f,
+        0.706791f,   0.196116f, -0.0266567f,
              0.8f,        0.1f,       -0.1f,
-        0.904601f, -0.0378311f,  -0.192504f,
+        0.896541f,  -0.026093f,  -0.185001f,
     };
 
     int ret;
@@ -149,24 +151,24 @@ static int test_poly_bezier3(void)
     };
 
     static const float refs[] = {
-         -1.1044f,   0.292227f, 0.0f,
+         -1.1018f,   0.290973f, 0.0f,
             -0.7f,       0.08f, 0.0f,
-       -0.396405f,   -0.12542f, 0.0f,
-       -0.339952f,  -0.380683f, 0.0f,
-        -0.39831f,  -0.117848f, 0.0f,
-      -0.0945053f,  0.0833274f, 0.0f,
-      -0.0141996f,  -0.206802f, 0.0f,
-       -0.190295f, -0.0496436f, 0.0f,
-       -0.230724f,   0.314766f, 0.0f,
-       -0.192237f,   0.608198f, 0.0f,
-      -0.0468001f,   0.271875f, 0.0f,
-            0.11f, -0.0588156f, 0.0f,
-        0.223503f,   0.173489f, 0.0f,
-        0.331497f,   0.245757f, 0.0f,
-        0.486813f, -0.0851905f, 0.0f,
-        0.390109f,   -0.37754f, 0.0f,
+       -0.396585f,  -0.125269f, 0.0f,
+        -0.33997f,  -0.380683f, 0.0f,
+       -0.398396f,  -0.117937f, 0.0f,
+      -0.0945216f,  0.0833235f, 0.0f,
+      -0.0142201f,   -0.20685f, 0.0f,
+       -0.190322f,  -0.049501f, 0.0f,
+       -0.230724f,   0.314771f, 0.0f,
+       -0.192187f,   0.608119f, 0.0f,
+      -0.0467891f,   0.271847f, 0.0f,
+        0.110051f, -0.0588862f, 0.0f,
+        0.223566f,   0.173256f, 0.0f,
+        0.331506f,   0.245744f, 0.0f,
+         0.48681f,   -0.08518f, 0.0f,
+        0.389887f,  -0.377543f, 0.0f,
             0.05f,  -0.250001f, 0.0f,
-        -0.35465f,  0.0274324f, 0.0f,
+       -0.350835f,   0.024522f, 0.0f,
     };
 
     struct path *path = ngli_path_create();
@@ -223,24 +225,24 @@ static int test_composition(void)
     };
 
     static const float refs[] = {
-        -0.812889f,   -0.066111f, 0.0f,
+        -0.812893f,  -0.0661166f, 0.0f,
              -0.6f,         0.2f, 0.0f,
-        -0.387111f,    0.466111f, 0.0f,
-        -0.158955f,     0.70579f, 0.0f,
-         0.139265f,    0.592457f, 0.0f,
-          0.27384f,    0.284733f, 0.0f,
-        -0.197802f,     0.11846f, 0.0f,
-        0.0472765f,    -0.10324f, 0.0f,
-       -0.0918672f,   -0.327911f, 0.0f,
-      -0.00425009f,     -0.4783f, 0.0f,
-         0.313111f,   -0.599806f, 0.0f,
-         0.599048f,    -0.44062f, 0.0f,
-        -0.476377f,   -0.107769f, 0.0f,
-        -0.741631f,    0.100257f, 0.0f,
-         -0.86002f, -0.00575656f, 0.0f,
-        -0.921486f,    0.295537f, 0.0f,
+        -0.387107f,    0.466117f, 0.0f,
+        -0.159024f,    0.705782f, 0.0f,
+          0.13927f,    0.592448f, 0.0f,
+         0.273854f,    0.284723f, 0.0f,
+        -0.197795f,    0.118459f, 0.0f,
+        0.0472857f,   -0.103255f, 0.0f,
+       -0.0918806f,    -0.32792f, 0.0f,
+      -0.00422865f,   -0.478309f, 0.0f,
+         0.313138f,   -0.599805f, 0.0f,
+         0.599068f,    -0.44059f, 0.0f,
+        -0.476409f,   -0.107761f, 0.0f,
+        -0.741662f,    0.100266f, 0.0f,
+         -0.86001f, -0.00577328f, 0.0f,
+        -0.921469f,    0.295543f, 0.0f,
              -0.6f,         0.2f, 0.0f,
-        -0.224002f,  -0.0146044f, 0.0f,
+        -0.225878f,  -0.0134414f, 0.0f,
     };
 
     struct path *path = ngli_path_create();
@@ -276,11 +278,104 @@ end:
     return ret;
 }
 
+/*
+ * The arc lookup must not depend on the previously evaluated distance, so
+ * the batch evaluation (sorted then shuffled) must match the independent
+ * evaluations on a path reconstructed every time.
+ */
+static int test_evaluate_batch(void)
+{
+    static const float points[][3] = {
+        {-0.5f, -0.3f, 0.0f},
+        { 0.4f,  0.2f, 0.0f},
+        {-0.1f,  0.6f, 0.0f},
+        { 0.3f, -0.5f, 0.0f},
+    };
+
+    static const float controls[][3] = {
+        { 0.9f, -0.8f, 0.0f},
+        {-0.7f,  0.9f, 0.0f},
+        { 0.1f,  0.1f, 0.0f},
+    };
+
+    static const float distances[] = {
+        -0.2f, 0.0f, 0.05f, 0.1f, 0.3f, 0.3f, 0.45f, 0.6f, 0.8f, 0.95f, 1.0f, 1.3f,
+        0.7f, -0.1f, 0.9f, 0.2f, 0.05f, 1.0f, 0.55f, 0.0f, 0.35f, 1.2f, 0.15f, 0.65f,
+    };
+
+    printf("test: batch evaluation\n");
+
+    struct path *path = ngli_path_create();
+    struct path *ref_path = ngli_path_create();
+    if (!path || !ref_path) {
+        ngli_path_freep(&path);
+        ngli_path_freep(&ref_path);
+        return -1;
+    }
+
+    int ret;
+    if ((ret = ngli_path_move_to(path, points[0])) < 0 ||
+        (ret = ngli_path_bezier3_to(path, controls[0], controls[1], points[1])) < 0 ||
+        (ret = ngli_path_line_to(path, points[2])) < 0 ||
+        (ret = ngli_path_bezier2_to(path, controls[2], points[3])) < 0 ||
+        (ret = ngli_path_finalize(path)) < 0 ||
+        (ret = ngli_path_init(path, 64)) < 0)
+        goto end;
+
+    float values[NGLI_ARRAY_NB(distances)][3];
+    ngli_path_evaluate_batch(path, values[0], distances, NGLI_ARRAY_NB(distances));
+
+    for (size_t i = 0; i < NGLI_ARRAY_NB(distances); i++) {
+        float ref[3];
+        ngli_path_clear(ref_path);
+        if ((ret = ngli_path_move_to(ref_path, points[0])) < 0 ||
+            (ret = ngli_path_bezier3_to(ref_path, controls[0], controls[1], points[1])) < 0 ||
+            (ret = ngli_path_line_to(ref_path, points[2])) < 0 ||
+            (ret = ngli_path_bezier2_to(ref_path, controls[2], points[3])) < 0 ||
+            (ret = ngli_path_finalize(ref_path)) < 0 ||
+            (ret = ngli_path_init(ref_path, 64)) < 0)
+            goto end;
+        ngli_path_evaluate(ref_path, ref, distances[i]);
+        if (memcmp(ref, values[i], sizeof(ref))) {
+            fprintf(stderr, "! d:%9f ref:("NGLI_FMT_VEC3") got:("NGLI_FMT_VEC3")\n",
+                    distances[i], NGLI_ARG_VEC3(ref), NGLI_ARG_VEC3(values[i]));
+            fprintf(stderr, "batch evaluation failed\n");
+            ret = -1;
+            goto end;
+        }
+    }
+
+    /* A dense sorted sampling walks the arcs forward instead of searching */
+    float dense_distances[1000];
+    float dense_values[NGLI_ARRAY_NB(dense_distances)][3];
+    for (size_t i = 0; i < NGLI_ARRAY_NB(dense_distances); i++)
+        dense_distances[i] = (float)i / (NGLI_ARRAY_NB(dense_distances) - 1.f);
+    ngli_path_evaluate_batch(path, dense_values[0], dense_distances, NGLI_ARRAY_NB(dense_distances));
+
+    for (size_t i = 0; i < NGLI_ARRAY_NB(dense_distances); i++) {
+        float ref[3];
+        ngli_path_evaluate(ref_path, ref, dense_distances[i]);
+        if (memcmp(ref, dense_values[i], sizeof(ref))) {
+            fprintf(stderr, "! d:%9f ref:("NGLI_FMT_VEC3") got:("NGLI_FMT_VEC3")\n",
+                    dense_distances[i], NGLI_ARG_VEC3(ref), NGLI_ARG_VEC3(dense_values[i]));
+            fprintf(stderr, "dense batch evaluation failed\n");
+            ret = -1;
+            goto end;
+        }
+    }
+
+end:
+    ngli_path_freep(&path);
+    ngli_path_freep(&ref_path);
+    return ret;
+}
+
 int main(int ac, char **av)
 {
     if (test_bezier3_vec3() < 0 ||
         test_poly_bezier3() < 0 ||
-        test_composition() < 0)
+        test_composition() < 0 ||
+        test_evaluate_batch() < 0)
         return 1;
     return 0;
 }
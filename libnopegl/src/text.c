@@ -20,6 +20,7 @@
  * under the License.
  */
 
+#include <math.h>
 #include <string.h>
 
 #include "box.h"
@@ -27,6 +28,7 @@
 #include "log.h"
 #include "math_utils.h"
 #include "ngpu/ctx.h"
+#include "node_animkeyframe.h"
 #include "node_text.h"
 #include "node_texteffect.h"
 #include "node_uniform.h"
@@ -123,6 +125,83 @@ struct text *ngli_text_create(struct ngl_ctx *ctx)
     return s;
 }
 
+/*
+ * Extend span with the time range outside of which the value of the node does
+ * not change. Return false if the node is not known to hold this property
+ * (arbitrary time dependent nodes such as noises or streamed data).
+ */
+static bool get_node_time_span(const struct ngl_node *node, double *span)
+{
+    switch (node->cls->id) {
+    case NGL_NODE_ANIMATEDFLOAT:
+    case NGL_NODE_ANIMATEDVEC2:
+    case NGL_NODE_ANIMATEDVEC3:
+    case NGL_NODE_ANIMATEDVEC4:
+    case NGL_NODE_ANIMATEDQUAT:
+    case NGL_NODE_ANIMATEDCOLOR: {
+        /* Animations hold their first and last key frame values outside of their range */
+        const struct variable_opts *o = node->opts;
+        if (!o->nb_animkf)
+            return true;
+        const struct animkeyframe_opts *kf0 = o->animkf[0]->opts;
+        const struct animkeyframe_opts *kfn = o->animkf[o->nb_animkf - 1]->opts;
+        span[0] = NGLI_MIN(span[0], kf0->time + o->time_offset);
+        span[1] = NGLI_MAX(span[1], kfn->time + o->time_offset);
+        return true;
+    }
+    case NGL_NODE_UNIFORMFLOAT:
+    case NGL_NODE_UNIFORMVEC2:
+    case NGL_NODE_UNIFORMVEC3:
+    case NGL_NODE_UNIFORMVEC4:
+    case NGL_NODE_UNIFORMQUAT:
+    case NGL_NODE_UNIFORMMAT4:
+    case NGL_NODE_UNIFORMCOLOR:
+    case NGL_NODE_ROTATE:
+    case NGL_NODE_ROTATEQUAT:
+    case NGL_NODE_TRANSFORM:
+    case NGL_NODE_TRANSLATE:
+    case NGL_NODE_SCALE:
+    case NGL_NODE_SKEW:
+    case NGL_NODE_IDENTITY: {
+        /* These nodes only depend on time through their children */
+        struct ngl_node **children = ngli_darray_data(&node->children);
+        for (size_t i = 0; i < ngli_darray_count(&node->children); i++) {
+            if (!get_node_time_span(children[i], span))
+                return false;
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+static void bake_effect_time_span(struct effect_segmentation *effect, const struct texteffect_opts *o)
+{
+    const struct ngl_node *nodes[] = {
+        o->transform_chain,
+        o->color_node,
+        o->opacity_node,
+        o->outline_node,
+        o->outline_color_node,
+        o->outline_pos_node,
+        o->glow_node,
+        o->glow_color_node,
+        o->blur_node,
+    };
+
+    /* An empty span (start > end) means the parameters never change */
+    effect->time_span[0] = INFINITY;
+    effect->time_span[1] = -INFINITY;
+    effect->time_bounded = true;
+    for (size_t i = 0; i < NGLI_ARRAY_NB(nodes); i++) {
+        if (nodes[i] && !get_node_time_span(nodes[i], effect->time_span)) {
+            effect->time_bounded = false;
+            return;
+        }
+    }
+}
+
 int ngli_text_init(struct text *s, const struct text_config *cfg)
 {
     s->config = *cfg;
@@ -134,6 +213,9 @@ int ngli_text_init(struct text *s, const struct text_config *cfg)
     if (!s->effects)
         return NGL_ERROR_MEMORY;
 
+    for (size_t i = 0; i < cfg->nb_effect_nodes; i++)
+        bake_effect_time_span(&s->effects[i], cfg->effect_nodes[i]->opts);
+
     s->cls = cfg->font_faces ? &ngli_text_external : &ngli_text_builtin;
     if (s->cls->priv_size) {
         s->priv_data = ngli_calloc(1, s->cls->priv_size);
@@ -298,38 +380,98 @@ static int set_value_from_node(float *dst, struct ngl_node *node, double t)
     return 0;
 }
 
+/* Return 1 if the destination has been written, 0 if it was left untouched */
 static int set_f32_value(float *dst, struct ngl_node *node, float value, double t)
 {
-    if (node)
-        return set_value_from_node(dst, node, t);
+    if (node) {
+        int ret = set_value_from_node(dst, node, t);
+        return ret < 0 ? ret : 1;
+    }
     if (value < 0.f)
         return 0;
     *dst = value;
-    return 0;
+    return 1;
 }
 
 static int set_vec3_value(float *dst, struct ngl_node *node, const float *value, double t)
 {
-    if (node)
-        return set_value_from_node(dst, node, t);
+    if (node) {
+        int ret = set_value_from_node(dst, node, t);
+        return ret < 0 ? ret : 1;
+    }
     if (value[0] < 0.f)
         return 0;
     memcpy(dst, value, 3 * sizeof(*dst));
-    return 0;
+    return 1;
+}
+
+enum {
+    EFFECT_VALUE_TRANSFORM     = 1U << 0,
+    EFFECT_VALUE_COLOR         = 1U << 1,
+    EFFECT_VALUE_OPACITY       = 1U << 2,
+    EFFECT_VALUE_OUTLINE_COLOR = 1U << 3,
+    EFFECT_VALUE_OUTLINE       = 1U << 4,
+    EFFECT_VALUE_GLOW_COLOR    = 1U << 5,
+    EFFECT_VALUE_GLOW          = 1U << 6,
+    EFFECT_VALUE_BLUR          = 1U << 7,
+    EFFECT_VALUE_OUTLINE_POS   = 1U << 8,
+};
+
+/*
+ * Effect parameters evaluated at a given target time, independently of the
+ * character they will be applied to
+ */
+struct effect_values {
+    uint32_t flags;       // combination of EFFECT_VALUE_*, for the values to apply
+    float transform[4*4]; // user transform matrix, not relocated to the anchor yet
+    float color[4];       // vec3 color, f32 opacity
+    float outline[4];     // vec3 color, f32 outline width
+    float glow[4];        // vec3 color, f32 glow amount
+    float blur;
+    float outline_pos;
+};
+
+static int add_effect_value(struct effect_values *v, uint32_t flag, int ret)
+{
+    if (ret > 0)
+        v->flags |= flag;
+    return ret;
 }
 
-static int set_transform(float *dst, const struct texteffect_opts *effect_opts,
-                         struct ngli_box box, struct ngli_aabb chr_aabb,
-                         const struct char_info *chr, double t)
+static int evaluate_effect(struct effect_values *v, const struct texteffect_opts *effect_opts, double t)
 {
+    int ret;
+
+    v->flags = 0;
+
     struct ngl_node *node = effect_opts->transform_chain;
+    if (node) {
+        ret = ngli_node_update(node, t);
+        if (ret < 0)
+            return ret;
+        NGLI_ALIGNED_MAT(tm);
+        ngli_transform_chain_compute(node, tm);
+        memcpy(v->transform, tm, sizeof(tm));
+        v->flags |= EFFECT_VALUE_TRANSFORM;
+    }
 
-    if (!node)
-        return 0;
-    int ret = ngli_node_update(node, t);
-    if (ret < 0)
+    if ((ret = add_effect_value(v, EFFECT_VALUE_COLOR,         set_vec3_value(v->color,      effect_opts->color_node,         effect_opts->color,         t))) < 0 ||
+        (ret = add_effect_value(v, EFFECT_VALUE_OPACITY,       set_f32_value( v->color + 3,  effect_opts->opacity_node,       effect_opts->opacity,       t))) < 0 ||
+        (ret = add_effect_value(v, EFFECT_VALUE_OUTLINE_COLOR, set_vec3_value(v->outline,    effect_opts->outline_color_node, effect_opts->outline_color, t))) < 0 ||
+        (ret = add_effect_value(v, EFFECT_VALUE_OUTLINE,       set_f32_value( v->outline + 3, effect_opts->outline_node,      effect_opts->outline,       t))) < 0 ||
+        (ret = add_effect_value(v, EFFECT_VALUE_GLOW_COLOR,    set_vec3_value(v->glow,       effect_opts->glow_color_node,    effect_opts->glow_color,    t))) < 0 ||
+        (ret = add_effect_value(v, EFFECT_VALUE_GLOW,          set_f32_value( v->glow + 3,   effect_opts->glow_node,          effect_opts->glow,          t))) < 0 ||
+        (ret = add_effect_value(v, EFFECT_VALUE_BLUR,          set_f32_value(&v->blur,       effect_opts->blur_node,          effect_opts->blur,          t))) < 0 ||
+        (ret = add_effect_value(v, EFFECT_VALUE_OUTLINE_POS,   set_f32_value(&v->outline_pos, effect_opts->outline_pos_node,  effect_opts->outline_pos,   t))) < 0)
         return ret;
 
+    return 0;
+}
+
+static void relocate_transform(float *dst, const float *transform, const struct texteffect_opts *effect_opts,
+                               struct ngli_box box, struct ngli_aabb chr_aabb,
+                               const struct char_info *chr)
+{
     float anchor_x, anchor_y;
     if (effect_opts->anchor_ref == NGLI_TEXT_ANCHOR_REF_CHAR) {
         /*
@@ -351,23 +493,45 @@ static int set_transform(float *dst, const struct texteffect_opts *effect_opts,
         ngli_assert(0);
     }
 
-    NGLI_ALIGNED_MAT(tm);
-    NGLI_ALIGNED_MAT(tmreloc0);
-    NGLI_ALIGNED_MAT(tmreloc1);
-
-    ngli_transform_chain_compute(node, tm);
-    ngli_mat4_translate(tmreloc0,  anchor_x,  anchor_y, 0.f);
-    ngli_mat4_translate(tmreloc1, -anchor_x, -anchor_y, 0.f);
+    /*
+     * Build T(anchor)·transform·T(-anchor) directly: the relocations being
+     * translations, they only affect the last column (right product) and the
+     * xy rows (left product), which saves 2 matrix products per character.
+     */
+    memcpy(dst, transform, 4 * 4 * sizeof(*dst));
+    for (size_t i = 0; i < 4; i++)
+        dst[12 + i] -= anchor_x * dst[i] + anchor_y * dst[4 + i];
+    for (size_t i = 0; i < 4; i++) {
+        dst[i * 4 + 0] += anchor_x * dst[i * 4 + 3];
+        dst[i * 4 + 1] += anchor_y * dst[i * 4 + 3];
+    }
+}
 
-    NGLI_ALIGNED_MAT(tmp);
-    memcpy(tmp, dst, sizeof(tm));      // start from the existing position
-    ngli_mat4_mul(tmp, tmp, tmreloc0); // go to anchor
-    ngli_mat4_mul(tmp, tmp, tm);       // apply user transform matrix
-    ngli_mat4_mul(tmp, tmp, tmreloc1); // go back from anchor
+/* Apply the effect transforms of a range of characters on top of their existing position */
+static void apply_transforms(struct text *s, size_t start, size_t end)
+{
+    float *dst = s->data_ptrs.transform + start * 4 * 4;
+    const float *tm = s->effect_transforms + start * 4 * 4;
+    ngli_mat4_mul_array(dst, dst, tm, end - start);
+}
 
-    memcpy(dst, tmp, sizeof(tmp));
+static void apply_effect(struct text *s, size_t c, const struct effect_values *v,
+                         const struct texteffect_opts *effect_opts, const struct char_info *chr)
+{
+    const struct text_data_pointers *ptrs = &s->data_ptrs;
 
-    return 0;
+    if (v->flags & EFFECT_VALUE_TRANSFORM) {
+        const struct ngli_aabb chr_aabb = {NGLI_ARG_VEC4(ptrs->vertices + c * 4)};
+        relocate_transform(s->effect_transforms + c * 4 * 4, v->transform, effect_opts, s->config.box, chr_aabb, chr);
+    }
+    if (v->flags & EFFECT_VALUE_COLOR)         memcpy(ptrs->color + c * 4, v->color, 3 * sizeof(*v->color));
+    if (v->flags & EFFECT_VALUE_OPACITY)       ptrs->color[c * 4 + 3] = v->color[3];
+    if (v->flags & EFFECT_VALUE_OUTLINE_COLOR) memcpy(ptrs->outline + c * 4, v->outline, 3 * sizeof(*v->outline));
+    if (v->flags & EFFECT_VALUE_OUTLINE)       ptrs->outline[c * 4 + 3] = v->outline[3];
+    if (v->flags & EFFECT_VALUE_GLOW_COLOR)    memcpy(ptrs->glow + c * 4, v->glow, 3 * sizeof(*v->glow));
+    if (v->flags & EFFECT_VALUE_GLOW)          ptrs->glow[c * 4 + 3] = v->glow[3];
+    if (v->flags & EFFECT_VALUE_BLUR)          ptrs->blur[c] = v->blur;
+    if (v->flags & EFFECT_VALUE_OUTLINE_POS)   ptrs->outline_pos[c] = v->outline_pos;
 }
 
 static void segment_chars(const struct text *s, struct effect_segmentation *effect)
@@ -531,6 +695,7 @@ static void destroy_effects_data(struct text *s)
     ngli_freep(&s->chars_data_default);
     s->chars_data = NULL; // allocation is shared with chars_data_default
     s->chars_data_size = 0;
+    ngli_freep(&s->effect_transforms);
 
     memset(&s->data_ptrs, 0, sizeof(s->data_ptrs)); // user may still be reading them
 }
@@ -647,6 +812,11 @@ int ngli_text_set_string(struct text *s, const char *str)
     const size_t alloc_count = next_pow2(nb_chars);
     const size_t needed_size = alloc_count * sizeof(struct default_data);
     if (s->chars_data_size != needed_size) {
+        float *new_effect_transforms = ngli_realloc(s->effect_transforms, alloc_count, 4 * 4 * sizeof(*new_effect_transforms));
+        if (!new_effect_transforms)
+            return NGL_ERROR_MEMORY;
+        s->effect_transforms = new_effect_transforms;
+
         /*
          * The x2 is because we duplicate the data for the defaults,
          * which is the reference data we use to reset all the characters
@@ -720,6 +890,21 @@ int ngli_text_set_time(struct text *s, double t)
         const double duration  = 1.f / ((double)nb_elems - overlap * (double)(nb_elems - 1));
         const double timescale = (1.f - overlap) * duration;
 
+        /*
+         * Characters for which the effect has not started yet (or is already
+         * over) all share the same values: these are evaluated only once and
+         * reused, so that only the characters actually transitioning require
+         * a node graph evaluation.
+         */
+        struct effect_values values, values_before, values_after;
+        bool has_values_before = false, has_values_after = false;
+
+        /*
+         * The effect transforms are applied in batches, on the contiguous
+         * ranges of transformed characters
+         */
+        size_t range_start = 0, range_end = 0;
+
         /* Apply effect on the selected range of characters */
         const struct char_info *chars = ngli_darray_data(&s->chars);
         for (size_t c = 0; c < ngli_darray_count(&s->chars); c++) {
@@ -737,20 +922,36 @@ int ngli_text_set_time(struct text *s, double t)
             const double next_t = prev_t + duration;
             const double target_t = NGLI_LINEAR_NORM(prev_t, next_t, effect_t);
 
-            const struct ngli_aabb chr_aabb = {NGLI_ARG_VEC4(s->data_ptrs.vertices + c * 4)};
-            const struct char_info *chr = &chars[i];
-
-            if ((ret = set_transform( s->data_ptrs.transform  + c * 4 * 4, effect_opts, s->config.box, chr_aabb, chr,                   target_t)) < 0 ||
-                (ret = set_vec3_value(s->data_ptrs.color      + c * 4,     effect_opts->color_node,         effect_opts->color,         target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.color      + c * 4 + 3, effect_opts->opacity_node,       effect_opts->opacity,       target_t)) < 0 ||
-                (ret = set_vec3_value(s->data_ptrs.outline    + c * 4,     effect_opts->outline_color_node, effect_opts->outline_color, target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.outline    + c * 4 + 3, effect_opts->outline_node,       effect_opts->outline,       target_t)) < 0 ||
-                (ret = set_vec3_value(s->data_ptrs.glow       + c * 4,     effect_opts->glow_color_node,    effect_opts->glow_color,    target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.glow       + c * 4 + 3, effect_opts->glow_node,          effect_opts->glow,          target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.blur       + c,         effect_opts->blur_node,          effect_opts->blur,          target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.outline_pos + c,        effect_opts->outline_pos_node,   effect_opts->outline_pos,   target_t)) < 0)
+            const struct effect_values *v = &values;
+            if (effect->time_bounded && target_t < effect->time_span[0]) {
+                if (!has_values_before) {
+                    if ((ret = evaluate_effect(&values_before, effect_opts, target_t)) < 0)
+                        return ret;
+                    has_values_before = true;
+                }
+                v = &values_before;
+            } else if (effect->time_bounded && target_t > effect->time_span[1]) {
+                if (!has_values_after) {
+                    if ((ret = evaluate_effect(&values_after, effect_opts, target_t)) < 0)
+                        return ret;
+                    has_values_after = true;
+                }
+                v = &values_after;
+            } else if ((ret = evaluate_effect(&values, effect_opts, target_t)) < 0) {
                 return ret;
+            }
+
+            apply_effect(s, c, v, effect_opts, &chars[i]);
+
+            if (v->flags & EFFECT_VALUE_TRANSFORM) {
+                if (c != range_end) {
+                    apply_transforms(s, range_start, range_end);
+                    range_start = c;
+                }
+                range_end = c + 1;
+            }
         }
+        apply_transforms(s, range_start, range_end);
     }
 
     return 0;
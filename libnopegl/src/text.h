@@ -22,6 +22,8 @@
 #ifndef TEXT_H
 #define TEXT_H
 
+#include <stdbool.h>
+
 #include "box.h"
 #include "ngpu/texture.h"
 #include "nopegl.h"
@@ -133,6 +135,8 @@ struct text_data_pointers {
 struct effect_segmentation {
     size_t *positions;     // character index (in chars darray) to position in "target unit" (char, word, ...)
     size_t total_segments; // total number of segment: all values in positions are between [0,total_segments-1]
+    bool time_bounded;     // whether the effect parameters are known to be constant outside of time_span
+    double time_span[2];   // target time range outside of which the effect parameters do not change
 };
 
 struct text {
@@ -152,6 +156,7 @@ struct text {
     float *chars_data;         // data buffer exposed to the user (through data pointers)
     size_t chars_data_size;    // size of chars_data_default and chars_data
     size_t chars_copy_size;    // actual size needed for copy
+    float *effect_transforms;  // per character effect transform, applied in batches on the data transforms
 
     struct darray chars_internal; // struct char_info_internal
 
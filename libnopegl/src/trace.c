@@ -0,0 +1,273 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "internal.h"
+#include "log.h"
+#include "ngpu/ctx.h"
+#include "nopegl.h"
+#include "trace.h"
+#include "utils/bstr.h"
+#include "utils/darray.h"
+#include "utils/memory.h"
+#include "utils/time.h"
+
+enum {
+    TRACE_TID_CPU = 1,
+    TRACE_TID_GPU = 2,
+};
+
+struct gpu_event {
+    const char *name;
+    const char *type;
+    uint32_t queries[2];
+};
+
+struct trace {
+    struct ngl_ctx *ctx;
+    FILE *fp;
+    struct bstr *events;
+    size_t nb_events;
+    int64_t origin_time;
+
+    /* GPU events of the current draw */
+    int gpu_timestamps;
+    int drawing;
+    int64_t draw_start_time;
+    struct darray gpu_events;
+    uint32_t nb_queries;
+    uint64_t *timestamps;
+};
+
+struct trace *ngli_trace_create(struct ngl_ctx *ctx)
+{
+    struct trace *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->ctx = ctx;
+    return s;
+}
+
+static void print_json_str(struct bstr *b, const char *str)
+{
+    ngli_bstr_print(b, "\"");
+    for (const char *p = str; *p; p++) {
+        const unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\')
+            ngli_bstr_printf(b, "\\%c", c);
+        else if (c < 0x20)
+            ngli_bstr_printf(b, "\\u%04x", c);
+        else
+            ngli_bstr_printf(b, "%c", c);
+    }
+    ngli_bstr_print(b, "\"");
+}
+
+/* Timestamps are expressed in microseconds with a nanosecond precision */
+static void print_time(struct bstr *b, int64_t time_ns)
+{
+    const char *sign = time_ns < 0 ? "-" : "";
+    const uint64_t abs_time = time_ns < 0 ? (uint64_t)-time_ns : (uint64_t)time_ns;
+    ngli_bstr_printf(b, "%s%" PRIu64 ".%03" PRIu64, sign, abs_time / 1000, abs_time % 1000);
+}
+
+static void print_separator(struct trace *s)
+{
+    ngli_bstr_print(s->events, s->nb_events++ ? ",\n" : "\n");
+}
+
+static void print_thread_name(struct trace *s, int tid, const char *name)
+{
+    print_separator(s);
+    ngli_bstr_printf(s->events, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                     tid, name);
+}
+
+static void print_event(struct trace *s, int tid, const char *name, const char *type, const char *category,
+                        int64_t start_time_ns, int64_t duration_ns)
+{
+    print_separator(s);
+    ngli_bstr_print(s->events, "{\"name\":");
+    print_json_str(s->events, name);
+    ngli_bstr_printf(s->events, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":", category, tid);
+    print_time(s->events, start_time_ns);
+    ngli_bstr_print(s->events, ",\"dur\":");
+    print_time(s->events, duration_ns);
+    ngli_bstr_printf(s->events, ",\"args\":{\"type\":\"%s\"}}", type);
+}
+
+static int flush_events(struct trace *s)
+{
+    int ret = ngli_bstr_check(s->events);
+    if (ret < 0)
+        return ret;
+
+    const size_t len = ngli_bstr_len(s->events);
+    const size_t n = fwrite(ngli_bstr_strptr(s->events), 1, len, s->fp);
+    ngli_bstr_clear(s->events);
+    if (n != len) {
+        LOG(ERROR, "unable to write trace events");
+        return NGL_ERROR_IO;
+    }
+
+    return 0;
+}
+
+int ngli_trace_init(struct trace *s, const char *filename)
+{
+    s->fp = fopen(filename, "wb");
+    if (!s->fp) {
+        LOG(ERROR, "unable to open \"%s\" for writing", filename);
+        return NGL_ERROR_IO;
+    }
+
+    s->events = ngli_bstr_create();
+    if (!s->events)
+        return NGL_ERROR_MEMORY;
+
+    s->timestamps = ngli_calloc(NGPU_MAX_TIMESTAMP_QUERIES, sizeof(*s->timestamps));
+    if (!s->timestamps)
+        return NGL_ERROR_MEMORY;
+
+    ngli_darray_init(&s->gpu_events, sizeof(struct gpu_event), 0);
+
+    s->gpu_timestamps = 1;
+    s->origin_time = ngli_gettime_relative();
+
+    ngli_bstr_print(s->events, "{\"traceEvents\":[");
+    print_separator(s);
+    ngli_bstr_print(s->events, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"nope.gl\"}}");
+    print_thread_name(s, TRACE_TID_CPU, "CPU");
+    print_thread_name(s, TRACE_TID_GPU, "GPU");
+
+    return flush_events(s);
+}
+
+static const char *get_node_name(const struct ngl_node *node)
+{
+    return node->label ? node->label : node->cls->name;
+}
+
+void ngli_trace_add_cpu_event(struct trace *s, const struct ngl_node *node, const char *category,
+                              int64_t start_time, int64_t end_time)
+{
+    /* CPU times are expressed in microseconds */
+    print_event(s, TRACE_TID_CPU, get_node_name(node), node->cls->name, category,
+                (start_time - s->origin_time) * 1000, (end_time - start_time) * 1000);
+}
+
+int32_t ngli_trace_begin_gpu_event(struct trace *s, const struct ngl_node *node)
+{
+    if (!s->drawing || !s->gpu_timestamps)
+        return -1;
+
+    /* Both the begin and end queries are reserved upfront */
+    if (s->nb_queries + 2 > NGPU_MAX_TIMESTAMP_QUERIES) {
+        LOG(DEBUG, "no timestamp query left to measure the draw of %s", get_node_name(node));
+        return -1;
+    }
+
+    const struct gpu_event event = {
+        .name    = get_node_name(node),
+        .type    = node->cls->name,
+        .queries = {s->nb_queries, s->nb_queries + 1},
+    };
+    if (!ngli_darray_push(&s->gpu_events, &event))
+        return -1;
+    s->nb_queries += 2;
+
+    ngpu_ctx_write_timestamp(s->ctx->gpu_ctx, event.queries[0]);
+
+    return (int32_t)(ngli_darray_count(&s->gpu_events) - 1);
+}
+
+void ngli_trace_end_gpu_event(struct trace *s, int32_t event)
+{
+    if (event < 0)
+        return;
+
+    const struct gpu_event *gpu_event = ngli_darray_get(&s->gpu_events, (size_t)event);
+    ngpu_ctx_write_timestamp(s->ctx->gpu_ctx, gpu_event->queries[1]);
+}
+
+void ngli_trace_begin_draw(struct trace *s)
+{
+    s->drawing = 1;
+    s->draw_start_time = ngli_gettime_relative();
+    ngli_darray_clear(&s->gpu_events);
+    s->nb_queries = 0;
+
+    /* Reference timestamp used to align the GPU events on the CPU timeline */
+    if (s->gpu_timestamps)
+        ngpu_ctx_write_timestamp(s->ctx->gpu_ctx, s->nb_queries++);
+}
+
+int ngli_trace_end_draw(struct trace *s)
+{
+    s->drawing = 0;
+
+    if (s->gpu_timestamps) {
+        int ret = ngpu_ctx_query_timestamps(s->ctx->gpu_ctx, s->nb_queries, s->timestamps);
+        if (ret == NGL_ERROR_GRAPHICS_UNSUPPORTED) {
+            LOG(WARNING, "timestamp queries are not supported, only CPU events will be traced");
+            s->gpu_timestamps = 0;
+        } else if (ret < 0) {
+            return ret;
+        } else {
+            const int64_t origin = (s->draw_start_time - s->origin_time) * 1000;
+            const uint64_t reference = s->timestamps[0];
+            const struct gpu_event *events = ngli_darray_data(&s->gpu_events);
+            for (size_t i = 0; i < ngli_darray_count(&s->gpu_events); i++) {
+                const struct gpu_event *event = &events[i];
+                const uint64_t start = s->timestamps[event->queries[0]];
+                const uint64_t end = s->timestamps[event->queries[1]];
+                print_event(s, TRACE_TID_GPU, event->name, event->type, "draw",
+                            origin + (int64_t)(start - reference), (int64_t)(end - start));
+            }
+        }
+    }
+    ngli_darray_clear(&s->gpu_events);
+
+    return flush_events(s);
+}
+
+void ngli_trace_freep(struct trace **sp)
+{
+    struct trace *s = *sp;
+    if (!s)
+        return;
+
+    if (s->fp) {
+        if (s->events) {
+            ngli_bstr_print(s->events, "\n],\"displayTimeUnit\":\"ms\"}\n");
+            flush_events(s);
+        }
+        fclose(s->fp);
+    }
+
+    ngli_bstr_freep(&s->events);
+    ngli_darray_reset(&s->gpu_events);
+    ngli_freep(&s->timestamps);
+    ngli_freep(sp);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+struct ngl_ctx;
+struct ngl_node;
+struct trace;
+
+/*
+ * Per-node profiling trace, exported in the Chrome trace event JSON format
+ * (readable by Perfetto or chrome://tracing).
+ *
+ * CPU events are recorded around the prefetch, update and draw callbacks of
+ * every node. GPU events are measured with timestamp queries around the draw
+ * callback of every node, they are read back at the end of the frame and
+ * aligned on the CPU time at which the draw started.
+ */
+struct trace *ngli_trace_create(struct ngl_ctx *ctx);
+int ngli_trace_init(struct trace *s, const char *filename);
+void ngli_trace_add_cpu_event(struct trace *s, const struct ngl_node *node, const char *category,
+                              int64_t start_time, int64_t end_time);
+int32_t ngli_trace_begin_gpu_event(struct trace *s, const struct ngl_node *node);
+void ngli_trace_end_gpu_event(struct trace *s, int32_t event);
+void ngli_trace_begin_draw(struct trace *s);
+int ngli_trace_end_draw(struct trace *s);
+void ngli_trace_freep(struct trace **sp);
+
+#endif
@@ -21,11 +21,14 @@
 
 #include <string.h>
 
+#include "internal.h"
 #include "log.h"
 #include "math_utils.h"
 #include "node_transform.h"
 #include "nopegl.h"
+#include "trace.h"
 #include "transforms.h"
+#include "utils/time.h"
 
 const struct ngl_node *ngli_transform_get_leaf_node(const struct ngl_node *node)
 {
@@ -66,11 +69,72 @@ void ngli_transform_chain_compute(const struct ngl_node *node, float *matrix)
     memcpy(matrix, tmp, sizeof(tmp));
 }
 
+void ngli_transform_set_matrix(struct transform *s, const float *matrix)
+{
+    /*
+     * The revision starts at 1 so that a chain revision (sum of the
+     * revisions) is never 0 once all its matrices are set
+     */
+    if (s->revision && !memcmp(s->matrix, matrix, sizeof(s->matrix)))
+        return;
+    memcpy(s->matrix, matrix, sizeof(s->matrix));
+    s->revision++;
+}
+
+/*
+ * Draw the leaf of a collapsed chain. The intermediate transforms have nothing
+ * to draw anymore, but they are accounted like in ngli_node_draw() (draw count
+ * and trace events) so that they remain visible in the statistics.
+ */
+static void draw_chain(struct ngl_node *node, struct ngl_node *leaf)
+{
+    if (node == leaf) {
+        ngli_node_draw(leaf);
+        return;
+    }
+
+    const struct transform *transform = node->priv_data;
+    TRACE("DRAW %s @ %p", node->label, node);
+    struct trace *trace = node->ctx->trace;
+    if (trace) {
+        const int32_t gpu_event = ngli_trace_begin_gpu_event(trace, node);
+        const int64_t start_time = ngli_gettime_relative();
+        draw_chain(transform->child, leaf);
+        ngli_trace_add_cpu_event(trace, node, "draw", start_time, ngli_gettime_relative());
+        ngli_trace_end_gpu_event(trace, gpu_event);
+    } else {
+        draw_chain(transform->child, leaf);
+    }
+    node->draw_count++;
+}
+
 void ngli_transform_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct transform *s = node->priv_data;
+
+    /*
+     * Collapse the consecutive transforms below this node into a single
+     * matrix, and draw the first non-transform node directly. The revisions
+     * only grow, so their sum changes whenever any matrix of the chain
+     * changes, in which case the composed matrix is computed again. Static
+     * chains are thus only composed once.
+     */
+    uint64_t chain_revision = s->revision;
     struct ngl_node *child = s->child;
+    while (child && child->cls->category == NGLI_NODE_CATEGORY_TRANSFORM) {
+        const struct transform *transform = child->priv_data;
+        chain_revision += transform->revision;
+        child = transform->child;
+    }
+
+    /* The child is part of the key because it can change (see GridLayout) */
+    if (chain_revision != s->chain_revision || s->child != s->chain_child) {
+        ngli_transform_chain_compute(s->child, s->chain_matrix);
+        ngli_mat4_mul(s->chain_matrix, s->matrix, s->chain_matrix);
+        s->chain_revision = chain_revision;
+        s->chain_child = s->child;
+    }
 
     float *next_matrix = ngli_darray_push(&ctx->modelview_matrix_stack, NULL);
     if (!next_matrix)
@@ -81,7 +145,7 @@ void ngli_transform_draw(struct ngl_node *node)
      * underlying matrix stack buffer */
     const float *prev_matrix = next_matrix - 4 * 4;
 
-    ngli_mat4_mul(next_matrix, prev_matrix, s->matrix);
-    ngli_node_draw(child);
+    ngli_mat4_mul(next_matrix, prev_matrix, s->chain_matrix);
+    draw_chain(s->child, child);
     ngli_darray_pop(&ctx->modelview_matrix_stack);
 }
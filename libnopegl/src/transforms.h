@@ -36,6 +36,14 @@
 const struct ngl_node *ngli_transform_get_leaf_node(const struct ngl_node *node);
 int ngli_transform_chain_check(const struct ngl_node *node);
 void ngli_transform_chain_compute(const struct ngl_node *node, float *matrix);
+
+/*
+ * Set the matrix of a transform, bumping its revision if the matrix actually
+ * changed. All the transform nodes must go through this function for the
+ * composed chain matrices to be refreshed.
+ */
+struct transform;
+void ngli_transform_set_matrix(struct transform *s, const float *matrix);
 void ngli_transform_draw(struct ngl_node *node);
 
 #endif
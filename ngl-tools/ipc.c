@@ -32,6 +32,7 @@
 #include <nopegl/nopegl.h>
 
 #include "ipc.h"
+#include "sha256.h"
 
 static void u32_write(uint8_t *buf, uint32_t v)
 {
@@ -89,6 +90,22 @@ int ipc_pkt_add_qtag_file(struct ipc_pkt *pkt, const char *filename)
     return pack(pkt, IPC_FILE, filename, strlen(filename) + 1);
 }
 
+/*
+ * The file hash payload is made of the SHA-256 digest of the file content,
+ * followed by the nul-terminated remote filename.
+ */
+int ipc_pkt_add_qtag_filehash(struct ipc_pkt *pkt, const uint8_t *digest, const char *filename)
+{
+    const size_t filename_size = strlen(filename) + 1;
+    int ret = pack(pkt, IPC_FILEHASH, NULL, SHA256_DIGEST_SIZE + filename_size);
+    if (ret < 0)
+        return ret;
+    uint8_t *dst = pkt->data + pkt->size - SHA256_DIGEST_SIZE - filename_size;
+    memcpy(dst, digest, SHA256_DIGEST_SIZE);
+    memcpy(dst + SHA256_DIGEST_SIZE, filename, filename_size);
+    return 0;
+}
+
 int ipc_pkt_add_qtag_filepart(struct ipc_pkt *pkt, const uint8_t *chunk, size_t chunk_size)
 {
     return pack(pkt, IPC_FILEPART, chunk, chunk_size);
@@ -121,6 +138,24 @@ int ipc_pkt_add_qtag_reconfigure(struct ipc_pkt *pkt)
     return pack(pkt, IPC_RECONFIGURE, NULL, 0);
 }
 
+/*
+ * The live control payload is made of 2 consecutive nul-terminated strings:
+ * the live control identifier (live_id) and its new value in textual form
+ * (comma separated list of numbers, or raw string for text nodes).
+ */
+int ipc_pkt_add_qtag_livectl(struct ipc_pkt *pkt, const char *id, const char *value)
+{
+    const size_t id_size = strlen(id) + 1;
+    const size_t value_size = strlen(value) + 1;
+    int ret = pack(pkt, IPC_LIVECTL, NULL, id_size + value_size);
+    if (ret < 0)
+        return ret;
+    uint8_t *dst = pkt->data + pkt->size - id_size - value_size;
+    memcpy(dst, id, id_size);
+    memcpy(dst + id_size, value, value_size);
+    return 0;
+}
+
 int ipc_pkt_add_rtag_info(struct ipc_pkt *pkt, const char *info)
 {
     return pack(pkt, IPC_INFO, info, strlen(info) + 1);
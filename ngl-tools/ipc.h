@@ -34,10 +34,12 @@ enum ipc_tag {
     IPC_FILE         = IPC_U32('f','i','l','e'),
     IPC_FILEPART     = IPC_U32('f','p','r','t'),
     IPC_FILEEND      = IPC_U32('f','e','n','d'),
+    IPC_FILEHASH     = IPC_U32('f','h','s','h'),
     IPC_CLEARCOLOR   = IPC_U32('c','c','l','r'),
     IPC_SAMPLES      = IPC_U32('m','s','a','a'),
     IPC_INFO         = IPC_U32('i','n','f','o'),
     IPC_RECONFIGURE  = IPC_U32('r','c','f','g'),
+    IPC_LIVECTL      = IPC_U32('l','c','t','l'),
 };
 
 struct ipc_pkt {
@@ -52,11 +54,13 @@ void ipc_pkt_freep(struct ipc_pkt **pktp);
 /* Query tags */
 int ipc_pkt_add_qtag_scene(struct ipc_pkt *pkt, const char *scene);
 int ipc_pkt_add_qtag_file(struct ipc_pkt *pkt, const char *filename);
+int ipc_pkt_add_qtag_filehash(struct ipc_pkt *pkt, const uint8_t *digest, const char *filename);
 int ipc_pkt_add_qtag_filepart(struct ipc_pkt *pkt, const uint8_t *chunk, size_t chunk_size);
 int ipc_pkt_add_qtag_clearcolor(struct ipc_pkt *pkt, const float *clearcolor);
 int ipc_pkt_add_qtag_samples(struct ipc_pkt *pkt, int32_t samples);
 int ipc_pkt_add_qtag_info(struct ipc_pkt *pkt);
 int ipc_pkt_add_qtag_reconfigure(struct ipc_pkt *pkt);
+int ipc_pkt_add_qtag_livectl(struct ipc_pkt *pkt, const char *id, const char *value);
 
 /* Response tags */
 int ipc_pkt_add_rtag_info(struct ipc_pkt *pkt, const char *info);
@@ -0,0 +1,693 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include <nopegl/nopegl.h>
+
+#include "common.h"
+#include "opts.h"
+
+#define EXIT_REGRESSION 2
+
+enum {
+    METRIC_UPDATE,
+    METRIC_DRAW,
+    METRIC_GPU,
+    METRIC_CAPTURE,
+    METRIC_FRAME,
+    NB_METRICS
+};
+
+static const char * const metric_names[NB_METRICS] = {
+    [METRIC_UPDATE]  = "update",
+    [METRIC_DRAW]    = "draw",
+    [METRIC_GPU]     = "gpu",
+    [METRIC_CAPTURE] = "capture",
+    [METRIC_FRAME]   = "frame",
+};
+
+/* HUD CSV columns (latency measures are expressed in microseconds) */
+static const char * const csv_columns[] = {
+    [METRIC_UPDATE] = "update CPU",
+    [METRIC_DRAW]   = "draw   CPU",
+    [METRIC_GPU]    = "draw   GPU",
+};
+
+#define MEMORY_SUFFIX " memory"
+#define MAX_MEMORY_COUNTERS 16
+#define MAX_CSV_COLUMNS 256
+
+struct stats {
+    int64_t min, p50, p90, p99, max, mean;
+};
+
+struct result {
+    const char *scene;
+    const char *backend;
+    int64_t setup_time;
+    struct stats stats[NB_METRICS];
+    char *memory_labels[MAX_MEMORY_COUNTERS];
+    int64_t memory[MAX_MEMORY_COUNTERS];
+    size_t nb_memory;
+};
+
+struct ctx {
+    /* options */
+    int log_level;
+    struct ngl_config cfg;
+    const char **inputs;
+    size_t nb_inputs;
+    int warmup;
+    int iterations;
+    const char *output;
+    const char *reference;
+    int threshold;
+    int min_delta;
+
+    struct ngl_backend *backends;
+    size_t nb_backends;
+    uint8_t *capture_buffer;
+    int64_t *samples[NB_METRICS];
+    struct result *results;
+    size_t nb_results;
+};
+
+static int opt_input(const char *arg, void *dst)
+{
+    uint8_t *cur_inputs_p = dst;
+    uint8_t *nb_cur_inputs_p = cur_inputs_p + sizeof(const char **);
+    const char **cur_inputs = *(const char ***)cur_inputs_p;
+    const size_t nb_cur_inputs = *(size_t *)nb_cur_inputs_p;
+    const size_t nb_new_inputs = nb_cur_inputs + 1;
+    const char **new_inputs = realloc(cur_inputs, nb_new_inputs * sizeof(*new_inputs));
+    if (!new_inputs)
+        return NGL_ERROR_MEMORY;
+    new_inputs[nb_cur_inputs] = arg;
+    memcpy(dst, &new_inputs, sizeof(new_inputs));
+    *(size_t *)nb_cur_inputs_p = nb_new_inputs;
+    return 0;
+}
+
+#define OFFSET(x) offsetof(struct ctx, x)
+static const struct opt options[] = {
+    {"-i", "--input",      OPT_TYPE_CUSTOM,   .offset=OFFSET(inputs), .func=opt_input},
+    {"-b", "--backend",    OPT_TYPE_BACKEND,  .offset=OFFSET(cfg.backend)},
+    {"-s", "--size",       OPT_TYPE_RATIONAL, .offset=OFFSET(cfg.width)},
+    {"-m", "--samples",    OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
+    {"-w", "--warmup",     OPT_TYPE_INT,      .offset=OFFSET(warmup)},
+    {"-n", "--iterations", OPT_TYPE_INT,      .offset=OFFSET(iterations)},
+    {"-o", "--output",     OPT_TYPE_STR,      .offset=OFFSET(output)},
+    {"-r", "--reference",  OPT_TYPE_STR,      .offset=OFFSET(reference)},
+    {"-t", "--threshold",  OPT_TYPE_INT,      .offset=OFFSET(threshold)},
+    {"-d", "--min-delta",  OPT_TYPE_INT,      .offset=OFFSET(min_delta)},
+    {"-l", "--loglevel",   OPT_TYPE_LOGLEVEL, .offset=OFFSET(log_level)},
+};
+
+static struct ngl_scene *get_scene(const char *filename)
+{
+    char *buf = get_text_file_content(filename);
+    if (!buf)
+        return NULL;
+    struct ngl_scene *scene = ngl_scene_create();
+    if (!scene) {
+        free(buf);
+        return NULL;
+    }
+    int ret = ngl_scene_init_from_str(scene, buf);
+    free(buf);
+    if (ret < 0)
+        ngl_scene_unrefp(&scene);
+    return scene;
+}
+
+static int cmp_i64(const void *a, const void *b)
+{
+    const int64_t va = *(const int64_t *)a;
+    const int64_t vb = *(const int64_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+/* Nearest-rank percentile of a sorted array */
+static int64_t get_percentile(const int64_t *values, size_t nb_values, int percentile)
+{
+    const size_t rank = (size_t)ceil((double)percentile / 100. * (double)nb_values);
+    return values[rank ? rank - 1 : 0];
+}
+
+static void compute_stats(struct stats *stats, int64_t *values, size_t nb_values)
+{
+    qsort(values, nb_values, sizeof(*values), cmp_i64);
+
+    int64_t sum = 0;
+    for (size_t i = 0; i < nb_values; i++)
+        sum += values[i];
+
+    *stats = (struct stats){
+        .min  = values[0],
+        .p50  = get_percentile(values, nb_values, 50),
+        .p90  = get_percentile(values, nb_values, 90),
+        .p99  = get_percentile(values, nb_values, 99),
+        .max  = values[nb_values - 1],
+        .mean = sum / (int64_t)nb_values,
+    };
+}
+
+static size_t split_csv_line(char *line, char **fields, size_t max_fields)
+{
+    size_t nb_fields = 0;
+    while (nb_fields < max_fields) {
+        fields[nb_fields++] = line;
+        char *sep = strchr(line, ',');
+        if (!sep)
+            break;
+        *sep = 0;
+        line = sep + 1;
+    }
+    return nb_fields;
+}
+
+static char *get_line(char **bufp)
+{
+    char *line = *bufp;
+    if (!*line)
+        return NULL;
+    char *eol = strchr(line, '\n');
+    if (eol) {
+        *eol = 0;
+        *bufp = eol + 1;
+    } else {
+        *bufp = line + strlen(line);
+    }
+    return line;
+}
+
+/*
+ * Extract the per-frame measures from the HUD CSV export. The first rows
+ * correspond to the setup and warm-up draws and are ignored.
+ */
+static int parse_hud_export(struct ctx *s, struct result *result, const char *filename)
+{
+    int ret = 0;
+    char *buf = get_text_file_content(filename);
+    if (!buf)
+        return NGL_ERROR_IO;
+
+    char *fields[MAX_CSV_COLUMNS];
+    int metric_columns[NB_METRICS] = {-1, -1, -1, -1, -1};
+    int total_cpu_column = -1;
+    int memory_columns[MAX_MEMORY_COUNTERS];
+
+    char *cur = buf;
+    char *header = get_line(&cur);
+    if (!header) {
+        fprintf(stderr, "empty HUD export\n");
+        ret = NGL_ERROR_INVALID_DATA;
+        goto end;
+    }
+
+    const size_t nb_columns = split_csv_line(header, fields, MAX_CSV_COLUMNS);
+    for (size_t i = 0; i < nb_columns; i++) {
+        for (size_t j = 0; j < ARRAY_NB(csv_columns); j++)
+            if (!strcmp(fields[i], csv_columns[j]))
+                metric_columns[j] = (int)i;
+        if (!strcmp(fields[i], "total  CPU"))
+            total_cpu_column = (int)i;
+
+        const size_t len = strlen(fields[i]);
+        const size_t suffix_len = strlen(MEMORY_SUFFIX);
+        if (len > suffix_len && !strcmp(fields[i] + len - suffix_len, MEMORY_SUFFIX) &&
+            result->nb_memory < MAX_MEMORY_COUNTERS) {
+            char *label = malloc(len - suffix_len + 1);
+            if (!label) {
+                ret = NGL_ERROR_MEMORY;
+                goto end;
+            }
+            memcpy(label, fields[i], len - suffix_len);
+            label[len - suffix_len] = 0;
+            memory_columns[result->nb_memory] = (int)i;
+            result->memory_labels[result->nb_memory++] = label;
+        }
+    }
+
+    for (size_t i = 0; i < ARRAY_NB(csv_columns); i++) {
+        if (metric_columns[i] < 0) {
+            fprintf(stderr, "column \"%s\" not found in HUD export\n", csv_columns[i]);
+            ret = NGL_ERROR_INVALID_DATA;
+            goto end;
+        }
+    }
+    if (total_cpu_column < 0) {
+        fprintf(stderr, "column \"total  CPU\" not found in HUD export\n");
+        ret = NGL_ERROR_INVALID_DATA;
+        goto end;
+    }
+
+    const int nb_skipped_rows = 1 + s->warmup;
+    for (int i = 0; i < nb_skipped_rows; i++) {
+        if (!get_line(&cur)) {
+            fprintf(stderr, "truncated HUD export\n");
+            ret = NGL_ERROR_INVALID_DATA;
+            goto end;
+        }
+    }
+
+    for (int i = 0; i < s->iterations; i++) {
+        char *line = get_line(&cur);
+        if (!line || split_csv_line(line, fields, MAX_CSV_COLUMNS) != nb_columns) {
+            fprintf(stderr, "truncated HUD export\n");
+            ret = NGL_ERROR_INVALID_DATA;
+            goto end;
+        }
+
+        for (size_t j = 0; j < ARRAY_NB(csv_columns); j++)
+            s->samples[j][i] = strtoll(fields[metric_columns[j]], NULL, 10);
+
+        /*
+         * Whatever is spent in ngl_draw() outside of the update, the draw
+         * and the GPU execution is mostly the capture readback
+         */
+        const int64_t total_cpu = strtoll(fields[total_cpu_column], NULL, 10);
+        const int64_t capture = s->samples[METRIC_FRAME][i] - total_cpu - s->samples[METRIC_GPU][i];
+        s->samples[METRIC_CAPTURE][i] = clipi64(capture, 0, INT64_MAX);
+
+        for (size_t j = 0; j < result->nb_memory; j++) {
+            const int64_t size = strtoll(fields[memory_columns[j]], NULL, 10);
+            if (size > result->memory[j])
+                result->memory[j] = size;
+        }
+    }
+
+    for (size_t i = 0; i < NB_METRICS; i++)
+        compute_stats(&result->stats[i], s->samples[i], (size_t)s->iterations);
+
+end:
+    free(buf);
+    return ret;
+}
+
+static double get_scene_time(const struct ngl_scene_params *params, int frame)
+{
+    if (params->duration <= 0. || params->framerate[0] <= 0 || params->framerate[1] <= 0)
+        return 0.;
+    const double t = frame * (double)params->framerate[1] / (double)params->framerate[0];
+    return fmod(t, params->duration);
+}
+
+static int run_benchmark(struct ctx *s, const char *input, const struct ngl_backend *backend)
+{
+    char export_filename[512];
+    const char *tmp_dir = getenv("TMPDIR");
+    if (!tmp_dir)
+        tmp_dir = getenv("TEMP");
+    if (!tmp_dir)
+        tmp_dir = "/tmp";
+    snprintf(export_filename, sizeof(export_filename), "%s/ngl-bench-%d.csv", tmp_dir, (int)getpid());
+
+    struct result *results = realloc(s->results, (s->nb_results + 1) * sizeof(*results));
+    if (!results)
+        return NGL_ERROR_MEMORY;
+    s->results = results;
+    struct result *result = &s->results[s->nb_results++];
+    *result = (struct result){.scene = input, .backend = backend->string_id};
+
+    fprintf(stderr, "%s [%s]\n", input, backend->string_id);
+
+    struct ngl_scene *scene = get_scene(input);
+    if (!scene)
+        return NGL_ERROR_INVALID_DATA;
+
+    struct ngl_config cfg = s->cfg;
+    cfg.backend = backend->id;
+    cfg.offscreen = 1;
+    cfg.capture_buffer = s->capture_buffer;
+    cfg.hud = 1;
+    cfg.hud_measure_window = 1;
+    cfg.hud_export_filename = export_filename;
+
+    struct ngl_ctx *ctx = ngl_create();
+    if (!ctx) {
+        ngl_scene_unrefp(&scene);
+        return NGL_ERROR_MEMORY;
+    }
+
+    int ret = ngl_configure(ctx, &cfg);
+    if (ret < 0) {
+        ngl_scene_unrefp(&scene);
+        goto end;
+    }
+
+    const struct ngl_scene_params *params = ngl_scene_get_params(scene);
+
+    /* The first draw is where the pipelines (and their shaders) get created */
+    const int64_t setup_start = gettime_relative();
+    ret = ngl_set_scene(ctx, scene);
+    ngl_scene_unrefp(&scene);
+    if (ret < 0)
+        goto end;
+    ret = ngl_draw(ctx, get_scene_time(params, 0));
+    if (ret < 0)
+        goto end;
+    result->setup_time = gettime_relative() - setup_start;
+
+    for (int i = 0; i < s->warmup; i++) {
+        ret = ngl_draw(ctx, get_scene_time(params, 1 + i));
+        if (ret < 0)
+            goto end;
+    }
+
+    for (int i = 0; i < s->iterations; i++) {
+        const int64_t start = gettime_relative();
+        ret = ngl_draw(ctx, get_scene_time(params, 1 + s->warmup + i));
+        if (ret < 0)
+            goto end;
+        s->samples[METRIC_FRAME][i] = gettime_relative() - start;
+    }
+
+    /* Destroying the context flushes the HUD export */
+    ngl_freep(&ctx);
+
+    ret = parse_hud_export(s, result, export_filename);
+
+end:
+    ngl_freep(&ctx);
+    remove(export_filename);
+    if (ret < 0)
+        fprintf(stderr, "benchmark of %s [%s] failed\n", input, backend->string_id);
+    return ret;
+}
+
+/* Escape a string for a JSON string literal, truncating it to fit in dst */
+static void escape_json_str(char *dst, size_t size, const char *src)
+{
+    size_t pos = 0;
+    for (const char *p = src; *p && pos + 7 < size; p++) {
+        const unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\')
+            pos += (size_t)snprintf(dst + pos, size - pos, "\\%c", c);
+        else if (c < 0x20)
+            pos += (size_t)snprintf(dst + pos, size - pos, "\\u%04x", c);
+        else
+            dst[pos++] = (char)c;
+    }
+    dst[pos] = 0;
+}
+
+/* Identify a result by its scene and backend, as a JSON object prefix */
+static void get_result_key(char *dst, size_t size, const struct result *result)
+{
+    char scene[768];
+    escape_json_str(scene, sizeof(scene), result->scene);
+    snprintf(dst, size, "{\"scene\":\"%s\",\"backend\":\"%s\",", scene, result->backend);
+}
+
+/* Each result is printed on a single line so it can be looked up by compare_results() */
+static void print_result(FILE *fp, const struct result *result)
+{
+    char key[1024];
+    get_result_key(key, sizeof(key), result);
+    fputs(key, fp);
+    fprintf(fp, "\"setup\":%" PRId64, result->setup_time);
+    for (size_t i = 0; i < NB_METRICS; i++) {
+        const struct stats *st = &result->stats[i];
+        fprintf(fp, ",\"%s\":{\"min\":%" PRId64 ",\"p50\":%" PRId64 ",\"p90\":%" PRId64
+                    ",\"p99\":%" PRId64 ",\"max\":%" PRId64 ",\"mean\":%" PRId64 "}",
+                metric_names[i], st->min, st->p50, st->p90, st->p99, st->max, st->mean);
+    }
+    fprintf(fp, ",\"memory\":{");
+    for (size_t i = 0; i < result->nb_memory; i++) {
+        char label[256];
+        escape_json_str(label, sizeof(label), result->memory_labels[i]);
+        fprintf(fp, "%s", i ? "," : "");
+        fprintf(fp, "\"%s\":%" PRId64, label, result->memory[i]);
+    }
+    fprintf(fp, "}}");
+}
+
+static int write_report(const struct ctx *s)
+{
+    FILE *fp = s->output ? fopen(s->output, "wb") : stdout;
+    if (!fp) {
+        fprintf(stderr, "unable to open %s\n", s->output);
+        return NGL_ERROR_IO;
+    }
+
+    fprintf(fp, "{\"version\":\"%d.%d.%d\",\"width\":%d,\"height\":%d,\"samples\":%d,"
+                "\"warmup\":%d,\"iterations\":%d,\"unit\":\"us\",\"results\":[\n",
+            NGL_VERSION_MAJOR, NGL_VERSION_MINOR, NGL_VERSION_MICRO,
+            s->cfg.width, s->cfg.height, s->cfg.samples, s->warmup, s->iterations);
+    for (size_t i = 0; i < s->nb_results; i++) {
+        print_result(fp, &s->results[i]);
+        fprintf(fp, "%s\n", i + 1 < s->nb_results ? "," : "");
+    }
+    fprintf(fp, "]}\n");
+
+    const int err = ferror(fp);
+    if (fp != stdout)
+        fclose(fp);
+    return err ? NGL_ERROR_IO : 0;
+}
+
+/* Find the end of the current JSON object, ignoring the braces within strings */
+static const char *find_object_end(const char *p)
+{
+    int in_str = 0;
+    for (; *p; p++) {
+        if (in_str && *p == '\\' && p[1])
+            p++;
+        else if (*p == '"')
+            in_str = !in_str;
+        else if (!in_str && *p == '}')
+            return p;
+    }
+    return NULL;
+}
+
+/*
+ * Look up a value in a result line of a previous report, optionally within
+ * a given object (section)
+ */
+static int find_value(const char *line, const char *section, const char *key, int64_t *value)
+{
+    char pattern[256];
+    const char *start = line;
+    const char *end = line + strlen(line);
+
+    if (section) {
+        snprintf(pattern, sizeof(pattern), "\"%s\":{", section);
+        start = strstr(line, pattern);
+        if (!start)
+            return NGL_ERROR_NOT_FOUND;
+        start += strlen(pattern);
+        end = find_object_end(start);
+        if (!end)
+            return NGL_ERROR_INVALID_DATA;
+    }
+
+    char escaped_key[224];
+    escape_json_str(escaped_key, sizeof(escaped_key), key);
+    snprintf(pattern, sizeof(pattern), "\"%s\":", escaped_key);
+    const char *p = strstr(start, pattern);
+    if (!p || p >= end)
+        return NGL_ERROR_NOT_FOUND;
+
+    *value = strtoll(p + strlen(pattern), NULL, 10);
+    return 0;
+}
+
+static int compare_value(const struct ctx *s, const char *name, int64_t ref, int64_t cur, int64_t min_delta)
+{
+    const int64_t delta = cur - ref;
+    const double change = ref ? (double)delta / (double)ref * 100. : 0.;
+    const int regression = delta > min_delta && change > s->threshold;
+    fprintf(stderr, "    %-20s %12" PRId64 " -> %12" PRId64 " (%+.1f%%)%s\n",
+            name, ref, cur, change, regression ? " REGRESSION" : "");
+    return regression;
+}
+
+static int compare_results(const struct ctx *s, int *regressionp)
+{
+    char *buf = get_text_file_content(s->reference);
+    if (!buf)
+        return NGL_ERROR_IO;
+
+    for (size_t i = 0; i < s->nb_results; i++) {
+        const struct result *result = &s->results[i];
+
+        char key[1024];
+        get_result_key(key, sizeof(key), result);
+
+        const char *line = NULL;
+        for (const char *l = buf; *l; ) {
+            const char *eol = strchr(l, '\n');
+            if (!strncmp(l, key, strlen(key))) {
+                line = l;
+                break;
+            }
+            if (!eol)
+                break;
+            l = eol + 1;
+        }
+
+        fprintf(stderr, "%s [%s]\n", result->scene, result->backend);
+        if (!line) {
+            fprintf(stderr, "    no reference\n");
+            continue;
+        }
+
+        /* Restrict the lookups to the matching line */
+        const char *eol = strchr(line, '\n');
+        const size_t len = eol ? (size_t)(eol - line) : strlen(line);
+        char *ref_line = malloc(len + 1);
+        if (!ref_line) {
+            free(buf);
+            return NGL_ERROR_MEMORY;
+        }
+        memcpy(ref_line, line, len);
+        ref_line[len] = 0;
+
+        int64_t ref;
+        if (find_value(ref_line, NULL, "setup", &ref) == 0)
+            *regressionp |= compare_value(s, "setup", ref, result->setup_time, s->min_delta);
+
+        for (size_t j = 0; j < NB_METRICS; j++) {
+            if (find_value(ref_line, metric_names[j], "p50", &ref) == 0)
+                *regressionp |= compare_value(s, metric_names[j], ref, result->stats[j].p50, s->min_delta);
+        }
+
+        for (size_t j = 0; j < result->nb_memory; j++) {
+            if (find_value(ref_line, "memory", result->memory_labels[j], &ref) == 0)
+                *regressionp |= compare_value(s, result->memory_labels[j], ref, result->memory[j], 0);
+        }
+
+        free(ref_line);
+    }
+
+    free(buf);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    struct ctx s = {
+        .log_level     = NGL_LOG_WARNING,
+        .cfg.backend   = NGL_BACKEND_AUTO,
+        .cfg.width     = DEFAULT_WIDTH,
+        .cfg.height    = DEFAULT_HEIGHT,
+        .cfg.offscreen = 1,
+        .warmup        = 10,
+        .iterations    = 100,
+        .threshold     = 10,
+        .min_delta     = 50,
+    };
+
+    int ret = opts_parse(argc, argc, argv, options, ARRAY_NB(options), &s);
+    if (ret < 0 || ret == OPT_HELP) {
+        opts_print_usage(argv[0], options, ARRAY_NB(options), NULL);
+        return ret == OPT_HELP ? 0 : EXIT_FAILURE;
+    }
+
+    ngl_log_set_min_level(s.log_level);
+
+    if (!s.nb_inputs) {
+        fprintf(stderr, "At least one scene needs to be specified (-i scene.ngl)\n");
+        free(s.inputs);
+        return EXIT_FAILURE;
+    }
+
+    if (s.warmup < 0 || s.iterations <= 0) {
+        fprintf(stderr, "Invalid number of warm-up or measured iterations\n");
+        free(s.inputs);
+        return EXIT_FAILURE;
+    }
+
+    /* Benchmark every available backend unless one is explicitly requested */
+    ret = ngl_backends_probe(&s.cfg, &s.nb_backends, &s.backends);
+    if (ret < 0 || !s.nb_backends) {
+        fprintf(stderr, "No backend available\n");
+        free(s.inputs);
+        return EXIT_FAILURE;
+    }
+
+    s.capture_buffer = calloc(s.cfg.width * s.cfg.height, 4);
+    if (!s.capture_buffer) {
+        ret = EXIT_FAILURE;
+        goto end;
+    }
+
+    for (size_t i = 0; i < NB_METRICS; i++) {
+        s.samples[i] = calloc(s.iterations, sizeof(*s.samples[i]));
+        if (!s.samples[i]) {
+            ret = EXIT_FAILURE;
+            goto end;
+        }
+    }
+
+    for (size_t i = 0; i < s.nb_inputs; i++) {
+        for (size_t j = 0; j < s.nb_backends; j++) {
+            ret = run_benchmark(&s, s.inputs[i], &s.backends[j]);
+            if (ret < 0) {
+                ret = EXIT_FAILURE;
+                goto end;
+            }
+        }
+    }
+
+    ret = write_report(&s);
+    if (ret < 0) {
+        ret = EXIT_FAILURE;
+        goto end;
+    }
+
+    if (s.reference) {
+        int regression = 0;
+        ret = compare_results(&s, &regression);
+        if (ret < 0) {
+            fprintf(stderr, "Unable to compare with %s\n", s.reference);
+            ret = EXIT_FAILURE;
+            goto end;
+        }
+        ret = regression ? EXIT_REGRESSION : 0;
+    }
+
+end:
+    for (size_t i = 0; i < s.nb_results; i++)
+        for (size_t j = 0; j < s.results[i].nb_memory; j++)
+            free(s.results[i].memory_labels[j]);
+    free(s.results);
+    for (size_t i = 0; i < NB_METRICS; i++)
+        free(s.samples[i]);
+    free(s.capture_buffer);
+    ngl_backends_freep(&s.backends);
+    free(s.inputs);
+    return ret;
+}
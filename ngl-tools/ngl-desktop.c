@@ -59,6 +59,7 @@
 #include "opts.h"
 #include "player.h"
 #include "pthread_compat.h"
+#include "sha256.h"
 
 struct ctx {
     /* options */
@@ -85,20 +86,26 @@ struct ctx {
     struct ipc_pkt *recv_pkt;
     FILE *upload_fp;
     char upload_path[1024];
+    char upload_tmp_path[1024];
+    int upload_check_hash;
+    struct sha256 upload_sha;
+    uint8_t upload_digest[SHA256_DIGEST_SIZE];
 };
 
 #define OFFSET(x) offsetof(struct ctx, x)
 static const struct opt options[] = {
-    {"-x", "--host",          OPT_TYPE_STR,      .offset=OFFSET(host)},
-    {"-p", "--port",          OPT_TYPE_STR,      .offset=OFFSET(port)},
-    {"-l", "--loglevel",      OPT_TYPE_LOGLEVEL, .offset=OFFSET(log_level)},
-    {"-b", "--backend",       OPT_TYPE_BACKEND,  .offset=OFFSET(cfg.backend)},
-    {"-s", "--size",          OPT_TYPE_RATIONAL, .offset=OFFSET(cfg.width)},
-    {"-z", "--swap_interval", OPT_TYPE_INT,      .offset=OFFSET(cfg.swap_interval)},
-    {"-c", "--clear_color",   OPT_TYPE_COLOR,    .offset=OFFSET(cfg.clear_color)},
-    {"-m", "--samples",       OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
-    {"-u", "--disable-ui",    OPT_TYPE_TOGGLE,   .offset=OFFSET(player_ui)},
-    {NULL, "--debug",         OPT_TYPE_TOGGLE,   .offset=OFFSET(cfg.debug)},
+    {"-x", "--host",             OPT_TYPE_STR,      .offset=OFFSET(host)},
+    {"-p", "--port",             OPT_TYPE_STR,      .offset=OFFSET(port)},
+    {"-l", "--loglevel",         OPT_TYPE_LOGLEVEL, .offset=OFFSET(log_level)},
+    {"-b", "--backend",          OPT_TYPE_BACKEND,  .offset=OFFSET(cfg.backend)},
+    {"-s", "--size",             OPT_TYPE_RATIONAL, .offset=OFFSET(cfg.width)},
+    {"-z", "--swap_interval",    OPT_TYPE_INT,      .offset=OFFSET(cfg.swap_interval)},
+    {"-c", "--clear_color",      OPT_TYPE_COLOR,    .offset=OFFSET(cfg.clear_color)},
+    {"-m", "--samples",          OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
+    {"-u", "--disable-ui",       OPT_TYPE_TOGGLE,   .offset=OFFSET(player_ui)},
+    {NULL, "--dynres_budget",    OPT_TYPE_FLOAT,    .offset=OFFSET(cfg.dynamic_resolution_budget)},
+    {NULL, "--dynres_min_scale", OPT_TYPE_FLOAT,    .offset=OFFSET(cfg.dynamic_resolution_min_scale)},
+    {NULL, "--debug",            OPT_TYPE_TOGGLE,   .offset=OFFSET(cfg.debug)},
 };
 
 static int create_session_file(struct ctx *s)
@@ -166,6 +173,46 @@ static int file_exists(const char *filename)
     return 1;
 }
 
+/*
+ * Basic (and probably too strict) check to make sure the file is not going
+ * to be uploaded outside the files directory.
+ *
+ * TODO: we should use chdir()+chroot(), but it requires a switch to a
+ * process model instead of threads (because the session file should not be
+ * mixed with the uploaded files).
+ */
+static int check_filename(const char *filename)
+{
+    if (strstr(filename, "..") || strchr(filename, '/')) {
+        fprintf(stderr, "Only a filename is allowed\n");
+        return NGL_ERROR_INVALID_ARG;
+    }
+    return 0;
+}
+
+/*
+ * The file is written to a temporary path and only moved to its final
+ * destination once complete, so that an interrupted upload is never
+ * mistaken for a cached file.
+ */
+static int open_upload_file(struct ctx *s)
+{
+    if (file_exists(s->upload_path))
+        return ipc_pkt_add_rtag_fileend(s->send_pkt, s->upload_path);
+
+    int ret = snprintf(s->upload_tmp_path, sizeof(s->upload_tmp_path), "%s.part", s->upload_path);
+    if (ret < 0 || ret >= sizeof(s->upload_tmp_path))
+        return NGL_ERROR_MEMORY;
+
+    s->upload_fp = fopen(s->upload_tmp_path, "wb");
+    if (!s->upload_fp) {
+        perror(s->upload_tmp_path);
+        return NGL_ERROR_IO;
+    }
+
+    return 0;
+}
+
 static int handle_tag_file(struct ctx *s, const uint8_t *data, int size)
 {
     if (size < 1 || data[size - 1] != 0) // check if string is nul-terminated
@@ -176,42 +223,95 @@ static int handle_tag_file(struct ctx *s, const uint8_t *data, int size)
         return NGL_ERROR_INVALID_USAGE;
     }
 
-    /*
-     * Basic (and probably too strict) check to make sure the file is not going
-     * to be uploaded outside the files directory.
-     *
-     * TODO: we should use chdir()+chroot(), but it requires a switch to a
-     * process model instead of threads (because the session file should not be
-     * mixed with the uploaded files).
-     */
     const char *filename = (const char *)data;
-    if (strstr(filename, "..") || strchr(filename, '/')) {
-        fprintf(stderr, "Only a filename is allowed\n");
-        return NGL_ERROR_INVALID_ARG;
-    }
+    int ret = check_filename(filename);
+    if (ret < 0)
+        return ret;
 
-    int ret = snprintf(s->upload_path, sizeof(s->upload_path), "%s%s", s->files_dir, filename);
+    ret = snprintf(s->upload_path, sizeof(s->upload_path), "%s%s", s->files_dir, filename);
     if (ret < 0 || ret >= sizeof(s->upload_path))
         return NGL_ERROR_MEMORY;
 
-    const int exists = file_exists(s->upload_path);
-    if (exists)
-        return ipc_pkt_add_rtag_fileend(s->send_pkt, s->upload_path);
+    s->upload_check_hash = 0;
+    return open_upload_file(s);
+}
 
-    s->upload_fp = fopen(s->upload_path, "wb");
-    if (!s->upload_fp) {
-        perror(s->upload_path);
-        return NGL_ERROR_IO;
+/*
+ * Content addressed upload: the file is stored according to the hash of its
+ * content (the remote filename is only used for its extension), so any file
+ * already present in the files directory is never transferred again, whatever
+ * its original name. The content is verified against the hash before being
+ * made available.
+ */
+static int handle_tag_filehash(struct ctx *s, const uint8_t *data, int size)
+{
+    if (size < SHA256_DIGEST_SIZE + 1 || data[size - 1] != 0) // check if string is nul-terminated
+        return NGL_ERROR_INVALID_DATA;
+
+    if (s->upload_fp) {
+        fprintf(stderr, "a file is already uploading");
+        return NGL_ERROR_INVALID_USAGE;
     }
 
-    return 0;
+    const char *filename = (const char *)data + SHA256_DIGEST_SIZE;
+    int ret = check_filename(filename);
+    if (ret < 0)
+        return ret;
+
+    const char *ext = strrchr(filename, '.');
+    if (!ext)
+        ext = "";
+
+    char hex[SHA256_DIGEST_SIZE * 2 + 1];
+    sha256_hex(data, hex);
+    ret = snprintf(s->upload_path, sizeof(s->upload_path), "%s%s%s", s->files_dir, hex, ext);
+    if (ret < 0 || ret >= sizeof(s->upload_path))
+        return NGL_ERROR_MEMORY;
+
+    s->upload_check_hash = 1;
+    memcpy(s->upload_digest, data, sizeof(s->upload_digest));
+    sha256_init(&s->upload_sha);
+    return open_upload_file(s);
 }
 
 static void close_upload_file(struct ctx *s)
 {
-    if (s->upload_fp)
-        fclose(s->upload_fp);
+    if (!s->upload_fp)
+        return;
+    fclose(s->upload_fp);
     s->upload_fp = NULL;
+    /* Discard incomplete uploads */
+    if (remove(s->upload_tmp_path) < 0)
+        perror(s->upload_tmp_path);
+}
+
+static int finalize_upload_file(struct ctx *s)
+{
+    int ret = fclose(s->upload_fp);
+    s->upload_fp = NULL;
+    if (ret) {
+        perror(s->upload_tmp_path);
+        remove(s->upload_tmp_path);
+        return NGL_ERROR_IO;
+    }
+
+    if (s->upload_check_hash) {
+        uint8_t digest[SHA256_DIGEST_SIZE];
+        sha256_final(&s->upload_sha, digest);
+        if (memcmp(digest, s->upload_digest, sizeof(digest))) {
+            fprintf(stderr, "%s: content does not match the announced hash\n", s->upload_path);
+            remove(s->upload_tmp_path);
+            return NGL_ERROR_INVALID_DATA;
+        }
+    }
+
+    if (rename(s->upload_tmp_path, s->upload_path) < 0) {
+        perror(s->upload_path);
+        remove(s->upload_tmp_path);
+        return NGL_ERROR_IO;
+    }
+
+    return ipc_pkt_add_rtag_fileend(s->send_pkt, s->upload_path);
 }
 
 static int handle_tag_filepart(struct ctx *s, const uint8_t *data, int size)
@@ -221,10 +321,8 @@ static int handle_tag_filepart(struct ctx *s, const uint8_t *data, int size)
         return NGL_ERROR_INVALID_USAGE;
     }
 
-    if (!size) {
-        close_upload_file(s);
-        return ipc_pkt_add_rtag_fileend(s->send_pkt, s->upload_path);
-    }
+    if (!size)
+        return finalize_upload_file(s);
 
     const size_t n = fwrite(data, 1, size, s->upload_fp);
     if (ferror(s->upload_fp)) {
@@ -239,6 +337,9 @@ static int handle_tag_filepart(struct ctx *s, const uint8_t *data, int size)
         return NGL_ERROR_IO;
     }
 
+    if (s->upload_check_hash)
+        sha256_update(&s->upload_sha, data, size);
+
     return ipc_pkt_add_rtag_filepart(s->send_pkt, size);
 }
 
@@ -264,6 +365,16 @@ static int handle_tag_reconfigure(const uint8_t *data, int size)
     return 0;
 }
 
+static int handle_tag_livectl(const uint8_t *data, int size)
+{
+    if (size < 1 || data[size - 1] != 0) // check if the value string is nul-terminated
+        return NGL_ERROR_INVALID_DATA;
+    const size_t id_size = strlen((const char *)data) + 1;
+    if (id_size >= size) // check if the value string is present after the id
+        return NGL_ERROR_INVALID_DATA;
+    return send_player_signal(PLAYER_SIGNAL_LIVECTL, data, size);
+}
+
 static int handle_tag_info(const uint8_t *data, int size, int fd, struct ctx *s)
 {
     if (size != 0)
@@ -326,11 +437,13 @@ static int handle_commands(struct ctx *s, int fd)
             switch (tag) {
             case IPC_SCENE:        ret = handle_tag_scene(data, size);        break;
             case IPC_FILE:         ret = handle_tag_file(s, data, size);      break;
+            case IPC_FILEHASH:     ret = handle_tag_filehash(s, data, size);  break;
             case IPC_FILEPART:     ret = handle_tag_filepart(s, data, size);  break;
             case IPC_CLEARCOLOR:   ret = handle_tag_clearcolor(data, size);   break;
             case IPC_SAMPLES:      ret = handle_tag_samples(data, size);      break;
             case IPC_RECONFIGURE:  ret = handle_tag_reconfigure(data, size);  break;
             case IPC_INFO:         ret = handle_tag_info(data, size, fd, s);  break;
+            case IPC_LIVECTL:      ret = handle_tag_livectl(data, size);      break;
             default:
                 fprintf(stderr, "unrecognized query tag %c%c%c%c\n", IPC_U32_FMT(tag));
                 return NGL_ERROR_INVALID_DATA;
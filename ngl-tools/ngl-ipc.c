@@ -42,6 +42,7 @@
 #include "common.h"
 #include "ipc.h"
 #include "opts.h"
+#include "sha256.h"
 
 #define UPLOAD_CHUNK_SIZE (1024 * 1024)
 
@@ -55,6 +56,7 @@ struct ctx {
     float clear_color[4];
     int32_t samples;
     int reconfigure;
+    const char *livectl;
 
     struct ipc_pkt *send_pkt;
     struct ipc_pkt *recv_pkt;
@@ -74,6 +76,7 @@ static const struct opt options[] = {
     {"-c", "--clearcolor",    OPT_TYPE_COLOR,    .offset=OFFSET(clear_color)},
     {"-m", "--samples",       OPT_TYPE_INT,      .offset=OFFSET(samples)},
     {"-g", "--reconfigure",   OPT_TYPE_TOGGLE,   .offset=OFFSET(reconfigure)},
+    {"-l", "--livectl",       OPT_TYPE_STR,      .offset=OFFSET(livectl)},
 };
 
 static int get_filesize(const char *filename, int64_t *size)
@@ -102,6 +105,25 @@ static int get_filesize(const char *filename, int64_t *size)
     return 0;
 }
 
+static int get_file_digest(struct ctx *s, uint8_t *digest)
+{
+    struct sha256 sha;
+    sha256_init(&sha);
+    for (;;) {
+        const size_t n = fread(s->upload_buffer, 1, UPLOAD_CHUNK_SIZE, s->upload_fp);
+        if (ferror(s->upload_fp)) {
+            perror("fread");
+            return NGL_ERROR_IO;
+        }
+        sha256_update(&sha, s->upload_buffer, n);
+        if (n < UPLOAD_CHUNK_SIZE)
+            break;
+    }
+    sha256_final(&sha, digest);
+    rewind(s->upload_fp);
+    return 0;
+}
+
 static int craft_packet(struct ctx *s, struct ipc_pkt *pkt)
 {
     if (s->scene) {
@@ -145,7 +167,16 @@ static int craft_packet(struct ctx *s, struct ipc_pkt *pkt)
         if (!s->upload_buffer)
             return NGL_ERROR_MEMORY;
 
-        ret = ipc_pkt_add_qtag_file(pkt, name);
+        /*
+         * The file is announced with its content hash: the server will only
+         * request the transfer if it does not have the file already
+         */
+        uint8_t digest[SHA256_DIGEST_SIZE];
+        ret = get_file_digest(s, digest);
+        if (ret < 0)
+            return ret;
+
+        ret = ipc_pkt_add_qtag_filehash(pkt, digest, name);
         if (ret < 0)
             return ret;
     }
@@ -174,6 +205,25 @@ static int craft_packet(struct ctx *s, struct ipc_pkt *pkt)
             return ret;
     }
 
+    if (s->livectl) {
+        char id[256];
+        const size_t id_len = strcspn(s->livectl, "=");
+        if (s->livectl[id_len] != '=') {
+            fprintf(stderr, "live control does not match \"id=value\" format\n");
+            return NGL_ERROR_INVALID_ARG;
+        }
+        if (id_len >= sizeof(id)) {
+            fprintf(stderr, "live control id too long %zu >= %zu\n", id_len, sizeof(id));
+            return NGL_ERROR_MEMORY;
+        }
+        int n = snprintf(id, sizeof(id), "%.*s", (int)id_len, s->livectl);
+        if (n < 0 || n >= sizeof(id))
+            return NGL_ERROR_MEMORY;
+        int ret = ipc_pkt_add_qtag_livectl(pkt, id, s->livectl + id_len + 1);
+        if (ret < 0)
+            return ret;
+    }
+
     return 0;
 }
 
@@ -56,6 +56,8 @@ static const struct opt options[] = {
     {"-u", "--disable-ui",       OPT_TYPE_TOGGLE,   .offset=OFFSET(player_ui)},
     {NULL, "--hwaccel",          OPT_TYPE_INT,      .offset=OFFSET(hwaccel)},
     {NULL, "--mipmap",           OPT_TYPE_INT,      .offset=OFFSET(mipmap)},
+    {NULL, "--dynres_budget",    OPT_TYPE_FLOAT,    .offset=OFFSET(cfg.dynamic_resolution_budget)},
+    {NULL, "--dynres_min_scale", OPT_TYPE_FLOAT,    .offset=OFFSET(cfg.dynamic_resolution_min_scale)},
     {NULL, "--debug",            OPT_TYPE_TOGGLE,   .offset=OFFSET(cfg.debug)},
 };
 
@@ -55,6 +55,13 @@ static int opt_int(const char *arg, void *dst)
     return 0;
 }
 
+static int opt_float(const char *arg, void *dst)
+{
+    const float v = strtof(arg, NULL);
+    memcpy(dst, &v, sizeof(v));
+    return 0;
+}
+
 static int opt_str(const char *arg, void *dst)
 {
     memcpy(dst, &arg, sizeof(arg)); // copy pointer
@@ -162,6 +169,7 @@ int opts_parse(int ac, int ac_max, char **av, const struct opt *opts, size_t nb_
     static func_type func_maps[OPT_TYPE_NB] = {
         [OPT_TYPE_TOGGLE]   = opt_toggle,
         [OPT_TYPE_INT]      = opt_int,
+        [OPT_TYPE_FLOAT]    = opt_float,
         [OPT_TYPE_STR]      = opt_str,
         [OPT_TYPE_TIME]     = opt_time,
         [OPT_TYPE_LOGLEVEL] = opt_loglevel,
@@ -198,6 +206,7 @@ void opts_print_usage(const char *program, const struct opt *opts, size_t nb_opt
 {
     static const char *types_map[OPT_TYPE_NB] = {
         [OPT_TYPE_INT]      = "integer",
+        [OPT_TYPE_FLOAT]    = "float",
         [OPT_TYPE_STR]      = "string",
         [OPT_TYPE_TIME]     = "time",
         [OPT_TYPE_LOGLEVEL] = "log_level",
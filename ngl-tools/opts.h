@@ -29,6 +29,7 @@ enum opt_type {
     OPT_TYPE_UNKNOWN = -1,
     OPT_TYPE_TOGGLE,
     OPT_TYPE_INT,
+    OPT_TYPE_FLOAT,
     OPT_TYPE_STR,
     OPT_TYPE_TIME,
     OPT_TYPE_LOGLEVEL,
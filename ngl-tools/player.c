@@ -117,6 +117,8 @@ end:
 static void kill_scene(struct player *p)
 {
     ngl_set_scene(p->ngl, NULL);
+    ngl_livectls_freep(&p->livectls);
+    p->nb_livectls = 0;
     p->pgbar_opacity_node  = NULL;
     p->pgbar_duration_node = NULL;
     p->pgbar_text_node     = NULL;
@@ -423,11 +425,19 @@ static int set_scene(struct player *p, struct ngl_scene *scene)
         if (ret < 0)
             return ret;
     }
+    ngl_livectls_freep(&p->livectls);
+    p->nb_livectls = 0;
+
     ret = ngl_set_scene(p->ngl, scene);
     if (ret < 0) {
         p->pgbar_opacity_node  = NULL;
         p->pgbar_duration_node = NULL;
         p->pgbar_text_node     = NULL;
+    } else {
+        /* Index the live controls so that they can be changed without resending the scene */
+        ret = ngl_livectls_get(scene, &p->nb_livectls, &p->livectls);
+        if (ret < 0)
+            return ret;
     }
 
     const struct ngl_scene_params *params = ngl_scene_get_params(scene);
@@ -511,6 +521,7 @@ void player_uninit(struct player *p)
         if (event.type == SDL_USEREVENT)
             free(event.user.data1);
 
+    ngl_livectls_freep(&p->livectls);
     ngl_freep(&p->ngl);
     SDL_DestroyWindow(p->window);
     SDL_Quit();
@@ -558,6 +569,130 @@ static int handle_reconfigure(struct player *p, const void *data)
     return ngl_configure(p->ngl, &p->ngl_config);
 }
 
+enum livectl_value_type {
+    LIVECTL_VALUE_F32,
+    LIVECTL_VALUE_I32,
+    LIVECTL_VALUE_U32,
+};
+
+static int parse_livectl_values(const char *str, void *dst, enum livectl_value_type type, size_t nb_values)
+{
+    for (size_t i = 0; i < nb_values; i++) {
+        char *end;
+        if (type == LIVECTL_VALUE_F32)
+            ((float *)dst)[i] = strtof(str, &end);
+        else if (type == LIVECTL_VALUE_U32)
+            ((uint32_t *)dst)[i] = (uint32_t)strtoul(str, &end, 0);
+        else
+            ((int32_t *)dst)[i] = (int32_t)strtoll(str, &end, 0);
+        if (end == str || *end != (i == nb_values - 1 ? '\0' : ','))
+            return NGL_ERROR_INVALID_ARG;
+        str = end + 1;
+    }
+    return 0;
+}
+
+static int set_livectl_value(struct ngl_livectl *ctl, const char *value)
+{
+    struct ngl_node *node = ctl->node;
+    union ngl_livectl_data v;
+    int ret;
+
+    switch (ctl->node_type) {
+    case NGL_NODE_TEXT:
+        return ngl_node_param_set_str(node, "text", value);
+    case NGL_NODE_USERSWITCH:
+        if ((ret = parse_livectl_values(value, v.i, LIVECTL_VALUE_I32, 1)) < 0)
+            return ret;
+        return ngl_node_param_set_bool(node, "enabled", v.i[0]);
+    case NGL_NODE_USERSELECT:
+        if ((ret = parse_livectl_values(value, v.i, LIVECTL_VALUE_I32, 1)) < 0)
+            return ret;
+        return ngl_node_param_set_i32(node, "branch", v.i[0]);
+    case NGL_NODE_UNIFORMBOOL:
+        if ((ret = parse_livectl_values(value, v.i, LIVECTL_VALUE_I32, 1)) < 0)
+            return ret;
+        return ngl_node_param_set_bool(node, "value", v.i[0]);
+    case NGL_NODE_UNIFORMINT:
+        if ((ret = parse_livectl_values(value, v.i, LIVECTL_VALUE_I32, 1)) < 0)
+            return ret;
+        return ngl_node_param_set_i32(node, "value", v.i[0]);
+    case NGL_NODE_UNIFORMIVEC2:
+        if ((ret = parse_livectl_values(value, v.i, LIVECTL_VALUE_I32, 2)) < 0)
+            return ret;
+        return ngl_node_param_set_ivec2(node, "value", v.i);
+    case NGL_NODE_UNIFORMIVEC3:
+        if ((ret = parse_livectl_values(value, v.i, LIVECTL_VALUE_I32, 3)) < 0)
+            return ret;
+        return ngl_node_param_set_ivec3(node, "value", v.i);
+    case NGL_NODE_UNIFORMIVEC4:
+        if ((ret = parse_livectl_values(value, v.i, LIVECTL_VALUE_I32, 4)) < 0)
+            return ret;
+        return ngl_node_param_set_ivec4(node, "value", v.i);
+    case NGL_NODE_UNIFORMUINT:
+        if ((ret = parse_livectl_values(value, v.u, LIVECTL_VALUE_U32, 1)) < 0)
+            return ret;
+        return ngl_node_param_set_u32(node, "value", v.u[0]);
+    case NGL_NODE_UNIFORMUIVEC2:
+        if ((ret = parse_livectl_values(value, v.u, LIVECTL_VALUE_U32, 2)) < 0)
+            return ret;
+        return ngl_node_param_set_uvec2(node, "value", v.u);
+    case NGL_NODE_UNIFORMUIVEC3:
+        if ((ret = parse_livectl_values(value, v.u, LIVECTL_VALUE_U32, 3)) < 0)
+            return ret;
+        return ngl_node_param_set_uvec3(node, "value", v.u);
+    case NGL_NODE_UNIFORMUIVEC4:
+        if ((ret = parse_livectl_values(value, v.u, LIVECTL_VALUE_U32, 4)) < 0)
+            return ret;
+        return ngl_node_param_set_uvec4(node, "value", v.u);
+    case NGL_NODE_UNIFORMFLOAT:
+        if ((ret = parse_livectl_values(value, v.f, LIVECTL_VALUE_F32, 1)) < 0)
+            return ret;
+        return ngl_node_param_set_f32(node, "value", v.f[0]);
+    case NGL_NODE_UNIFORMVEC2:
+        if ((ret = parse_livectl_values(value, v.f, LIVECTL_VALUE_F32, 2)) < 0)
+            return ret;
+        return ngl_node_param_set_vec2(node, "value", v.f);
+    case NGL_NODE_UNIFORMVEC3:
+    case NGL_NODE_UNIFORMCOLOR:
+        if ((ret = parse_livectl_values(value, v.f, LIVECTL_VALUE_F32, 3)) < 0)
+            return ret;
+        return ngl_node_param_set_vec3(node, "value", v.f);
+    case NGL_NODE_UNIFORMVEC4:
+    case NGL_NODE_UNIFORMQUAT:
+        if ((ret = parse_livectl_values(value, v.f, LIVECTL_VALUE_F32, 4)) < 0)
+            return ret;
+        return ngl_node_param_set_vec4(node, "value", v.f);
+    case NGL_NODE_UNIFORMMAT4:
+        if ((ret = parse_livectl_values(value, v.m, LIVECTL_VALUE_F32, 16)) < 0)
+            return ret;
+        return ngl_node_param_set_mat4(node, "value", v.m);
+    default:
+        fprintf(stderr, "live control %s: unsupported node type\n", ctl->id);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+}
+
+static int handle_livectl(struct player *p, const void *data)
+{
+    const char *id = data;
+    const char *value = id + strlen(id) + 1;
+
+    for (size_t i = 0; i < p->nb_livectls; i++) {
+        struct ngl_livectl *ctl = &p->livectls[i];
+        if (strcmp(ctl->id, id))
+            continue;
+        int ret = set_livectl_value(ctl, value);
+        if (ret < 0)
+            fprintf(stderr, "unable to set live control %s to \"%s\"\n", id, value);
+        /* An invalid live change is not fatal to the player */
+        return 0;
+    }
+
+    fprintf(stderr, "live control %s not found in the current scene\n", id);
+    return 0;
+}
+
 typedef int (*handle_func)(struct player *p, const void *data);
 
 static const handle_func handle_map[] = {
@@ -565,6 +700,7 @@ static const handle_func handle_map[] = {
     [PLAYER_SIGNAL_CLEARCOLOR]   = handle_clearcolor,
     [PLAYER_SIGNAL_SAMPLES]      = handle_samples,
     [PLAYER_SIGNAL_RECONFIGURE]  = handle_reconfigure,
+    [PLAYER_SIGNAL_LIVECTL]      = handle_livectl,
 };
 
 void player_main_loop(struct player *p)
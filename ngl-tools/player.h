@@ -37,6 +37,7 @@ enum player_signal {
     PLAYER_SIGNAL_CLEARCOLOR,
     PLAYER_SIGNAL_SAMPLES,
     PLAYER_SIGNAL_RECONFIGURE,
+    PLAYER_SIGNAL_LIVECTL,
 };
 
 struct player {
@@ -66,6 +67,8 @@ struct player {
     struct ngl_node *pgbar_opacity_node;
     struct ngl_node *pgbar_text_node;
     struct ngl_node *pgbar_duration_node;
+    struct ngl_livectl *livectls;
+    size_t nb_livectls;
 };
 
 int player_init(struct player *p, const char *win_title, struct ngl_scene *scene,
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHA256_DIGEST_SIZE 32
+
+struct sha256 {
+    uint32_t state[8];
+    uint64_t nb_bytes;
+    uint8_t block[64];
+    size_t block_len;
+};
+
+void sha256_init(struct sha256 *s);
+void sha256_update(struct sha256 *s, const uint8_t *data, size_t size);
+void sha256_final(struct sha256 *s, uint8_t *digest);
+
+/* Write the lowercase hexadecimal representation of digest in dst (nul-terminated) */
+void sha256_hex(const uint8_t *digest, char *dst);
+
+#endif
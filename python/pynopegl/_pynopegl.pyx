@@ -20,7 +20,7 @@
 # under the License.
 #
 
-from cpython cimport array
+from cpython.buffer cimport PyBUF_C_CONTIGUOUS, PyBuffer_Release, PyObject_GetBuffer
 from libc.stdint cimport int32_t, uint8_t, uint32_t, uintptr_t
 from libc.stdlib cimport calloc, free
 from libc.string cimport memset
@@ -47,6 +47,9 @@ cdef extern from "nopegl/nopegl.h":
     int ngl_node_param_add_f64s(ngl_node *node, const char *key, size_t nb_f64s, double *f64s)
     int ngl_node_param_set_bool(ngl_node *node, const char *key, int value)
     int ngl_node_param_set_data(ngl_node *node, const char *key, size_t size, const void *data)
+    ctypedef void (*ngl_data_release_callback_type)(void *arg, void *data)
+    int ngl_node_param_set_data_ref(ngl_node *node, const char *key, size_t size, const void *data,
+                                    ngl_data_release_callback_type release_cb, void *release_arg)
     int ngl_node_param_set_dict(ngl_node *node, const char *key, const char *name, ngl_node *value)
     int ngl_node_param_set_f32(ngl_node *node, const char *key, float value)
     int ngl_node_param_set_f64(ngl_node *node, const char *key, double value)
@@ -168,6 +171,9 @@ cdef extern from "nopegl/nopegl.h":
         int hud_refresh_rate[2]
         const char *hud_export_filename
         int hud_scale
+        const char *trace_filename
+        float dynamic_resolution_budget
+        float dynamic_resolution_min_scale
         int debug
 
     cdef union ngl_livectl_data:
@@ -195,12 +201,14 @@ cdef extern from "nopegl/nopegl.h":
     int ngl_resize(ngl_ctx *s, uint32_t width, uint32_t height)
     int ngl_get_viewport(ngl_ctx *s, int32_t *viewport)
     int ngl_set_capture_buffer(ngl_ctx *s, void *capture_buffer)
-    int ngl_set_scene(ngl_ctx *s, ngl_scene *scene)
+    int ngl_set_scene(ngl_ctx *s, ngl_scene *scene) nogil
     int ngl_draw(ngl_ctx *s, double t) nogil
+    int ngl_draw_async(ngl_ctx *s, double t) nogil
+    int ngl_draw_wait(ngl_ctx *s) nogil
     char *ngl_dot(ngl_ctx *s, double t) nogil
     int ngl_livectls_get(ngl_scene *scene, size_t *nb_livectlsp, ngl_livectl **livectlsp)
     void ngl_livectls_freep(ngl_livectl **livectlsp)
-    void ngl_freep(ngl_ctx **ss)
+    void ngl_freep(ngl_ctx **ss) nogil
 
     int ngl_easing_evaluate(const char *name, const double *args, size_t nb_args,
                             const double *offsets, double t, double *v)
@@ -262,6 +270,12 @@ include "nodes_def.pyx"
 log_set_min_level = ngl_log_set_min_level
 
 
+cdef void _release_buffer(void *arg, void *data) noexcept with gil:
+    cdef Py_buffer *view = <Py_buffer *>arg
+    PyBuffer_Release(view)
+    free(view)
+
+
 cdef class _Node:
     cdef ngl_node *ctx
 
@@ -284,10 +298,23 @@ cdef class _Node:
     def _param_set_bool(self, const char *key, bint value):
         return ngl_node_param_set_bool(self.ctx, key, value)
 
-    def _param_set_data(self, const char *key, array.array arg):
-        return ngl_node_param_set_data(self.ctx, key,
-                                       arg.buffer_info()[1] * arg.itemsize,
-                                       arg.data.as_voidptr)
+    def _param_set_data(self, const char *key, arg):
+        # The node references the memory of any object implementing the
+        # buffer protocol (array.array, memoryview, numpy arrays, ...) instead
+        # of copying it; the buffer is released along with the parameter.
+        cdef Py_buffer *view = <Py_buffer *>calloc(1, sizeof(Py_buffer))
+        if view is NULL:
+            raise MemoryError()
+        try:
+            PyObject_GetBuffer(arg, view, PyBUF_C_CONTIGUOUS)
+        except:
+            free(view)
+            raise
+        ret = ngl_node_param_set_data_ref(self.ctx, key, view.len, view.buf, _release_buffer, view)
+        if ret < 0:
+            PyBuffer_Release(view)
+            free(view)
+        return ret
 
     def _param_set_dict(self, const char *key, const char *name, _Node value):
         cdef ngl_node *node = value.ctx if value is not None else NULL
@@ -664,6 +691,9 @@ cdef class Config:
         hud_refresh_rate,
         hud_export_filename,
         hud_scale,
+        trace_filename,
+        dynamic_resolution_budget,
+        dynamic_resolution_min_scale,
         debug,
     ):
         self.config.platform = platform.value
@@ -692,6 +722,10 @@ cdef class Config:
         if hud_export_filename is not None:
             self.config.hud_export_filename = hud_export_filename
         self.config.hud_scale = hud_scale
+        if trace_filename is not None:
+            self.config.trace_filename = trace_filename
+        self.config.dynamic_resolution_budget = dynamic_resolution_budget
+        self.config.dynamic_resolution_min_scale = dynamic_resolution_min_scale
         self.config.debug = debug
 
     @property
@@ -756,13 +790,27 @@ cdef class Context:
         if scene is not None:
             ptr = scene.cptr
             c_scene = <ngl_scene *>ptr
-        return ngl_set_scene(self.ctx, c_scene)
+        # The previous scene may be released by the rendering thread, which
+        # needs the GIL to release the buffers referenced by its data params
+        with nogil:
+            ret = ngl_set_scene(self.ctx, c_scene)
+        return ret
 
     def draw(self, double t):
         with nogil:
             ret = ngl_draw(self.ctx, t)
         return ret
 
+    def draw_async(self, double t):
+        with nogil:
+            ret = ngl_draw_async(self.ctx, t)
+        return ret
+
+    def draw_wait(self):
+        with nogil:
+            ret = ngl_draw_wait(self.ctx)
+        return ret
+
     def dot(self, double t):
         cdef char *s
         with nogil:
@@ -770,7 +818,8 @@ cdef class Context:
         return _ret_pystr(s) if s else None
 
     def __dealloc__(self):
-        ngl_freep(&self.ctx)
+        with nogil:
+            ngl_freep(&self.ctx)
 
     def gl_wrap_framebuffer(self, uint32_t framebuffer):
         return ngl_gl_wrap_framebuffer(self.ctx, framebuffer)
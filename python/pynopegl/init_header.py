@@ -19,7 +19,6 @@
 # under the License.
 #
 
-import array
 import inspect
 import os
 import platform
@@ -47,6 +46,9 @@ from _pynopegl import _Node
 
 __version__ = _ngl.__version__
 
+# Any object implementing the buffer protocol (array.array, memoryview, numpy arrays, ...)
+Buffer = Any
+
 # fmt: off
 class Platform(IntEnum):
     AUTO    = _ngl.PLATFORM_AUTO
@@ -127,6 +129,9 @@ class Config(_ngl.Config):
         hud_refresh_rate: Tuple[int, int] = (0, 0),
         hud_export_filename: Optional[str] = None,
         hud_scale: int = 0,
+        trace_filename: Optional[str] = None,
+        dynamic_resolution_budget: float = 0.0,
+        dynamic_resolution_min_scale: float = 0.0,
         debug: bool = False,
     ):
         self.capture_buffer = capture_buffer
@@ -150,6 +155,9 @@ class Config(_ngl.Config):
             hud_refresh_rate,
             hud_export_filename,
             hud_scale,
+            trace_filename,
+            dynamic_resolution_budget,
+            dynamic_resolution_min_scale,
             debug,
         )
 
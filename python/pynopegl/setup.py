@@ -60,7 +60,7 @@ class _WrapperGenerator:
 
     _TYPING_MAP = dict(
         bool="bool",
-        data="array.array",
+        data="Buffer",
         f32="float",
         f64="float",
         f64_list="Sequence[float]",
@@ -445,7 +445,7 @@ setup(
     packages=find_packages(include=["pynopegl"]),
     setup_requires=[
         "setuptools>=18.0",
-        "cython>=0.29.6",
+        "cython>=0.29.31",
     ],
     cmdclass={
         "build_ext": BuildExtCommand,
@@ -19,14 +19,19 @@
 # under the License.
 #
 
+import array
 import atexit
 import csv
+import json
 import locale
 import math
 import os
 import pprint
 import random
+import shutil
+import subprocess
 import tempfile
+import zlib
 from collections import namedtuple
 from pathlib import Path
 
@@ -72,8 +77,6 @@ def api_reconfigure():
 
 
 def api_reconfigure_clearcolor(width=16, height=16):
-    import zlib
-
     capture_buffer = bytearray(width * height * 4)
     ctx = ngl.Context()
     ret = ctx.configure(
@@ -124,8 +127,6 @@ def api_resize_fail():
 
 
 def api_capture_buffer(width=16, height=16):
-    import zlib
-
     ctx = ngl.Context()
     ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
     assert ret == 0
@@ -141,6 +142,28 @@ def api_capture_buffer(width=16, height=16):
     del ctx
 
 
+def api_draw_async(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+    scene = _get_scene()
+    assert ctx.set_scene(scene) == 0
+    for i in range(5):
+        assert ctx.draw_async(i) == 0
+    assert ctx.draw_wait() == 0
+    assert zlib.crc32(capture_buffer) == 0xB4BD32FA
+    # Synchronous calls must wait for the pending asynchronous draws
+    assert ctx.draw_async(0) == 0
+    assert ctx.set_scene(None) == 0
+    assert ctx.draw(0) == 0
+    assert ctx.draw_wait() == 0
+    del capture_buffer
+    del ctx
+
+
 def api_ctx_ownership():
     ctx = ngl.Context()
     ctx2 = ngl.Context()
@@ -342,9 +365,277 @@ def api_hud_csv(width=16, height=16):
     assert time_column == ["0.000000", "0.150000", "0.300000", "0.450000", "1.000000"], time_column
 
 
-def _api_text_live_change(width=320, height=240, font_faces=None):
-    import zlib
+def api_hud_csv_culled(width=16, height=16):
+    ctx = ngl.Context()
+
+    fd, csvpath = tempfile.mkstemp(suffix=".csv", prefix="ngl-test-hud-")
+    os.close(fd)
+    atexit.register(lambda: os.remove(csvpath))
+
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, hud=True, hud_export_filename=csvpath)
+    )
+    assert ret == 0
+
+    # One visible draw and two draws moved out of the viewport
+    geometry = ngl.Quad(corner=(-0.5, -0.5, 0), width=(1, 0, 0), height=(0, 1, 0))
+    draws = [ngl.Translate(ngl.DrawColor(geometry=geometry), vector=(x, 0, 0)) for x in (0, -2, 2)]
+    scene = ngl.Scene.from_params(ngl.Group(children=draws))
+    assert ctx.set_scene(scene) == 0
+    for t in [0.0, 0.5, 1.0]:
+        assert ctx.draw(t) == 0
+    del ctx
 
+    with open(csvpath) as csvfile:
+        rows = list(csv.DictReader(csvfile))
+
+    assert [row["Draws"] for row in rows] == ["1", "1", "1"], rows
+    assert [row["Culled"] for row in rows] == ["2", "2", "2"], rows
+
+
+def api_trace(width=16, height=16):
+    ctx = ngl.Context()
+
+    fd, tracepath = tempfile.mkstemp(suffix=".json", prefix="ngl-test-trace-")
+    os.close(fd)
+    atexit.register(lambda: os.remove(tracepath))
+
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, trace_filename=tracepath)
+    )
+    assert ret == 0
+
+    # The label is not a valid JSON string as is
+    label = 'draw "a\\b"'
+    # The intermediate transforms of a chain are collapsed when drawing but
+    # must still be traced
+    draw = ngl.DrawColor(label=label)
+    chain = ngl.Translate(ngl.Rotate(draw, angle=45, label="rotate"), vector=(0.1, 0, 0), label="translate")
+    scene = ngl.Scene.from_params(ngl.Group(children=[chain], label="root"))
+    assert ctx.set_scene(scene) == 0
+    nb_frames = 3
+    for i in range(nb_frames):
+        assert ctx.draw(i / 60.0) == 0
+
+    # The trace is only complete once the context is released
+    del ctx
+
+    with open(tracepath) as tracefile:
+        trace = json.load(tracefile)
+
+    events = trace["traceEvents"]
+    threads = {event["tid"]: event["args"]["name"] for event in events if event["name"] == "thread_name"}
+    assert sorted(threads.values()) == ["CPU", "GPU"], threads
+
+    durations = [event for event in events if event["ph"] == "X"]
+    for event in durations:
+        assert event["tid"] in threads, event
+        assert event["ts"] >= 0 and event["dur"] >= 0, event
+
+    # Every frame has a CPU draw event for each drawing node
+    cpu_draws = [e["name"] for e in durations if threads[e["tid"]] == "CPU" and e["cat"] == "draw"]
+    assert cpu_draws.count(label) == nb_frames, cpu_draws
+    assert cpu_draws.count("root") == nb_frames, cpu_draws
+    assert cpu_draws.count("translate") == nb_frames, cpu_draws
+    assert cpu_draws.count("rotate") == nb_frames, cpu_draws
+
+
+# The benchmark report is written by hand by ngl-bench: make sure it remains
+# valid JSON whatever the scene filename is, and that it can be used as a
+# reference for a later run
+def api_bench_report():
+    ngl_bench = shutil.which("ngl-bench")
+    assert ngl_bench is not None
+
+    tmpdir = tempfile.mkdtemp(prefix="ngl-test-bench-")
+    atexit.register(lambda: shutil.rmtree(tmpdir))
+
+    # Double quotes are not allowed in Windows filenames but the path
+    # separators already need to be escaped there
+    scene_name = "scene.ngl" if os.name == "nt" else 'scene "a\\b".ngl'
+    scene_path = os.path.join(tmpdir, scene_name)
+    scene = ngl.Scene.from_params(ngl.DrawColor(), duration=1)
+    with open(scene_path, "wb") as scene_file:
+        scene_file.write(scene.serialize())
+
+    cmd = [ngl_bench, "-i", scene_path, "-s", "16x16", "-w", "1", "-n", "5"]
+    if _backend_str:
+        cmd += ["-b", _backend_str]
+
+    report_path = os.path.join(tmpdir, "report.json")
+    subprocess.run(cmd + ["-o", report_path], check=True)
+    with open(report_path) as report_file:
+        report = json.load(report_file)
+
+    assert report["iterations"] == 5, report
+    for result in report["results"]:
+        assert result["scene"] == scene_path, result
+        memory = result["memory"]
+        assert "Textures" in memory and all(isinstance(size, int) for size in memory.values()), memory
+
+    # Timings may regress between the 2 runs but every result must be found
+    ret = subprocess.run(cmd + ["-o", os.path.join(tmpdir, "cur.json"), "-r", report_path], stderr=subprocess.PIPE)
+    assert ret.returncode in (0, 2), ret
+    assert b"no reference" not in ret.stderr, ret.stderr
+
+
+def _get_animated_block_scene(colors):
+    # The animated field covers the whole block so every update replaces the
+    # buffer content
+    animkf = [ngl.AnimKeyFrameVec4(i, color + (1,)) for i, color in enumerate(colors)]
+    block = ngl.Block(fields=[ngl.AnimatedVec4(animkf, label="color")])
+    vert = "void main() { ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0); }"
+    frag = "void main() { ngl_out_color = data.color; }"
+    geometry = ngl.Quad(corner=(-1, -1, 0), width=(2, 0, 0), height=(0, 2, 0))
+    draw = ngl.Draw(geometry, ngl.Program(vertex=vert, fragment=frag))
+    draw.update_frag_resources(data=block)
+    return ngl.Scene.from_params(draw)
+
+
+# Update a block on every frame to go through the buffer replace path, which
+# may orphan or wait for the GPU depending on the buffer storage
+def api_buffer_replace(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+
+    colors = [(1, 0, 0), (0, 1, 0), (0, 0, 1)]
+    assert ctx.set_scene(_get_animated_block_scene(colors)) == 0
+    for t in [0.0, 1.0, 2.0] * 10:
+        assert ctx.draw(t) == 0
+        expected = [round(c * 255) for c in colors[int(t)]] + [255]
+        assert list(capture_buffer[:4]) == expected, (t, list(capture_buffer[:4]))
+    del ctx
+    del capture_buffer
+
+
+def api_hud_csv_buffer_waits(width=16, height=16):
+    ctx = ngl.Context()
+
+    fd, csvpath = tempfile.mkstemp(suffix=".csv", prefix="ngl-test-hud-")
+    os.close(fd)
+    atexit.register(lambda: os.remove(csvpath))
+
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, hud=True, hud_export_filename=csvpath)
+    )
+    assert ret == 0
+
+    colors = [(1, 0, 0), (0, 1, 0), (0, 0, 1)]
+    assert ctx.set_scene(_get_animated_block_scene(colors)) == 0
+    times = [0.0, 1.0, 2.0] * 10
+    for t in times:
+        assert ctx.draw(t) == 0
+    del ctx
+
+    with open(csvpath) as csvfile:
+        rows = list(csv.DictReader(csvfile))
+
+    assert len(rows) == len(times), rows
+    assert all(int(row["buffer waits"]) >= 0 for row in rows), rows
+
+    # The block is uploaded at every frame
+    assert all(int(row["upload bytes"]) >= 16 for row in rows), rows
+
+
+# More frames than the export queue can hold: if the export does not keep up,
+# the rendering must wait for it instead of losing samples
+def api_hud_csv_backpressure(width=16, height=16):
+    ctx = ngl.Context()
+
+    fd, csvpath = tempfile.mkstemp(suffix=".csv", prefix="ngl-test-hud-")
+    os.close(fd)
+    atexit.register(lambda: os.remove(csvpath))
+
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, hud=True, hud_export_filename=csvpath)
+    )
+    assert ret == 0
+    assert ctx.set_scene(ngl.Scene.from_params(ngl.DrawColor())) == 0
+    nb_frames = 2000
+    for i in range(nb_frames):
+        assert ctx.draw(i / 60.0) == 0
+    del ctx
+
+    with open(csvpath) as csvfile:
+        time_column = [row["time"] for row in csv.DictReader(csvfile)]
+
+    assert time_column == [f"{i / 60.0:.6f}" for i in range(nb_frames)]
+
+
+def _get_checkerboard_scene(width, height):
+    # A one texel checkerboard can not survive a render at a lower resolution
+    data = array.array("B")
+    for y in range(height):
+        for x in range(width):
+            data.extend([255] * 4 if (x + y) % 2 else [0, 0, 0, 255])
+    texture = ngl.Texture2D(
+        width=width,
+        height=height,
+        min_filter="nearest",
+        mag_filter="nearest",
+        data_src=ngl.BufferUBVec4(data=data),
+    )
+    return ngl.Scene.from_params(ngl.DrawTexture(texture))
+
+
+def api_dynres(width=64, height=64):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+    assert ctx.set_scene(_get_checkerboard_scene(width, height)) == 0
+    assert ctx.draw(0) == 0
+    ref_crc = zlib.crc32(capture_buffer)
+    del ctx
+
+    # A budget no frame can fit in forces the controller to the minimum scale
+    # once the first frames are elapsed
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(
+            offscreen=True,
+            width=width,
+            height=height,
+            backend=_backend,
+            capture_buffer=capture_buffer,
+            dynamic_resolution_budget=0.001,
+            dynamic_resolution_min_scale=0.5,
+        )
+    )
+    assert ret == 0
+    assert ctx.set_scene(_get_checkerboard_scene(width, height)) == 0
+    assert ctx.draw(0) == 0
+    assert zlib.crc32(capture_buffer) == ref_crc
+    for i in range(1, 32):
+        assert ctx.draw(i / 60) == 0
+    assert zlib.crc32(capture_buffer) != ref_crc
+    del ctx
+
+
+def api_dynres_invalid_config():
+    for budget, min_scale in ((-1, 0), (1, -0.5), (1, 1.5)):
+        ctx = ngl.Context()
+        ret = ctx.configure(
+            ngl.Config(
+                offscreen=True,
+                width=16,
+                height=16,
+                backend=_backend,
+                dynamic_resolution_budget=budget,
+                dynamic_resolution_min_scale=min_scale,
+            )
+        )
+        assert _ret_to_fourcc(ret) == "Earg", (budget, min_scale)
+        del ctx
+
+
+def _api_text_live_change(width=320, height=240, font_faces=None):
     ctx = ngl.Context()
     capture_buffer = bytearray(width * height * 4)
     ret = ctx.configure(
@@ -399,6 +690,55 @@ def api_media_sharing_failure():
     assert _ret_to_fourcc(ctx.set_scene(scene)) == "Eusg"  # Usage error
 
 
+def api_media_prefetch_time_anim(width=16, height=16):
+    """
+    The media seeks ahead of time to the position at which it will be first
+    displayed when it is prefetched. This must not alter the state of its time
+    animation, which is here shared with a streamed color displayed on the
+    right half of the viewport during the whole scene.
+    """
+    m0 = load_media("mire")
+
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+
+    time_anim = ngl.AnimatedTime([ngl.AnimKeyFrameFloat(0, 0.5), ngl.AnimKeyFrameFloat(8, 4.5)])
+
+    # One color per second of media time
+    colors = [(1, 0, 0), (0, 1, 0), (0, 0, 1), (1, 1, 0), (0, 1, 1)]
+    timestamps = array.array("q", [i * 1000000 for i in range(len(colors))])
+    values = array.array("f", [c for color in colors for c in color])
+    streamed = ngl.StreamedVec3(
+        timestamps=ngl.BufferInt64(data=timestamps),
+        buffer=ngl.BufferVec3(data=values),
+        time_anim=time_anim,
+    )
+    right = ngl.Quad(corner=(0, -1, 0), width=(1, 0, 0), height=(0, 2, 0))
+    draw_color = ngl.DrawColor(color=streamed, geometry=right)
+
+    media = ngl.Media(m0.filename, time_anim=time_anim)
+    left = ngl.Quad(corner=(-1, -1, 0), width=(1, 0, 0), height=(0, 2, 0))
+    draw_media = ngl.DrawTexture(ngl.Texture2D(data_src=media), geometry=left)
+    trf = ngl.TimeRangeFilter(draw_media, start=4, end=6, prefetch_time=2)
+
+    scene = ngl.Scene.from_params(ngl.Group(children=[draw_color, trf]))
+    assert ctx.set_scene(scene) == 0
+
+    # Before, within and after the prefetch window, with the media displayed
+    # from t=4
+    for t in (1.0, 2.5, 3.0, 3.5, 4.5, 5.5, 7.0):
+        assert ctx.draw(t) == 0
+        media_time = 0.5 + t / 2
+        expected = [round(c * 255) for c in colors[int(media_time)]] + [255]
+        pos = (height // 2 * width + width - 1) * 4
+        assert list(capture_buffer[pos : pos + 4]) == expected, (t, list(capture_buffer[pos : pos + 4]))
+    del ctx
+
+
 def api_denied_node_live_change(width=320, height=240):
     ctx = ngl.Context()
     ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
@@ -683,3 +1023,68 @@ def api_transform_chain_check():
         pass
     else:
         assert False
+
+
+def api_data_buffer_protocol():
+    """Test that data parameters accept any object implementing the buffer protocol without copying it"""
+    src = array.array("f", [0.0, 0.5, 1.0, 1.0])
+    size = len(src) * src.itemsize
+    for data in (src, memoryview(src), bytes(src), bytearray(src), memoryview(bytes(src)).cast("f")):
+        scene = ngl.Scene.from_params(ngl.BufferFloat(data=data))
+        assert f" data:{size},".encode() in scene.serialize()
+
+    # The memory is referenced by the node until the parameter is released
+    view = memoryview(bytearray(src))
+    buffer = ngl.BufferFloat(data=view)
+    try:
+        view.release()
+    except BufferError:
+        pass
+    else:
+        assert False
+    del buffer
+    view.release()
+
+    # Non-contiguous memory can not be referenced
+    try:
+        ngl.BufferFloat(data=memoryview(src)[::2])
+    except BufferError:
+        pass
+    else:
+        assert False
+
+
+def api_data_buffer_release_from_ctx():
+    """Test that the referenced memory is released when the context holds the last reference to the scene"""
+    vertices = array.array("f", [-1.0, -1.0, 0.0, 1.0, -1.0, 0.0, 0.0, 1.0, 0.0])
+    uvcoords = array.array("f", [0.0, 0.0, 1.0, 0.0, 0.5, 1.0])
+
+    for release_scene in ("set_scene", "ctx_free"):
+        view = memoryview(bytearray(vertices))
+        geometry = ngl.Geometry(vertices=ngl.BufferVec3(data=view), uvcoords=ngl.BufferVec2(data=uvcoords))
+        scene = ngl.Scene.from_params(ngl.DrawColor(geometry=geometry))
+        ctx = ngl.Context()
+        ret = ctx.configure(ngl.Config(offscreen=True, width=16, height=16, backend=_backend))
+        assert ret == 0
+        assert ctx.set_scene(scene) == 0
+        assert ctx.draw(0) == 0
+        del geometry
+        del scene
+
+        # The memory is still referenced through the scene owned by the context
+        try:
+            view.release()
+        except BufferError:
+            pass
+        else:
+            assert False
+
+        # The scene (and thus the memory reference) is released by the
+        # rendering thread of the context
+        if release_scene == "set_scene":
+            assert ctx.set_scene(None) == 0
+            view.release()
+            del ctx
+        else:
+            del ctx
+            view.release()
@@ -402,3 +402,60 @@ def benchmark_resources_with_compute(cfg: ngl.SceneCfg):
 def benchmark_resources_without_compute(cfg: ngl.SceneCfg):
     cfg.aspect_ratio = (4, 3)
     return _get_scene(cfg, seed=3, enable_computes=False)
+
+
+def _get_transforms_scene(cfg: ngl.SceneCfg, seed=0, nb_layers=2000):
+    cfg.duration = 10
+    rng = cfg.rng
+    rng.seed(seed)
+
+    t0, t1 = 0, cfg.duration
+
+    # Many small layers behind chains of animated transforms, a part of them
+    # being moved off-screen and culled
+    geometry = ngl.Quad(corner=(-0.02, -0.02, 0), width=(0.04, 0, 0), height=(0, 0.04, 0))
+    layers = []
+    for _ in range(nb_layers):
+        layer = ngl.DrawColor(
+            _get_random_color(rng),
+            opacity=_get_random_opacity(rng),
+            geometry=geometry,
+            blending="src_over",
+        )
+        for _ in range(rng.randint(2, 4)):
+            layer = _get_random_transform(rng, t0, t1, layer)
+        layers.append(layer)
+
+    # A per-character transform on every glyph
+    animkf = [
+        ngl.AnimKeyFrameFloat(0, 0),
+        ngl.AnimKeyFrameFloat(1, 360, "exp_in_out"),
+    ]
+    text = ngl.Text(
+        text="\n".join(["Broccoli Cabbage Mushroom Cucumber Kombu"] * 8),
+        box=(-1, -1, 2, 2),
+        bg_opacity=0,
+        effects=[
+            ngl.TextEffect(
+                target="char",
+                overlap=0.9,
+                transform=ngl.Rotate(ngl.Identity(), angle=ngl.AnimatedFloat(animkf)),
+            )
+        ],
+    )
+
+    return ngl.Group(children=layers + [text])
+
+
+@ngl.scene(controls=dict(seed=ngl.scene.Range(range=[0, 1000]), nb_layers=ngl.scene.Range(range=[1, 10000])))
+def benchmark_transforms(cfg: ngl.SceneCfg, seed=0, nb_layers=2000):
+    """Transform chains, culling and per-character transforms, to be used with ngl-bench"""
+    cfg.aspect_ratio = (16, 9)
+    return _get_transforms_scene(cfg, seed, nb_layers)
+
+
+@test_fingerprint(width=640, height=360, keyframes=10, tolerance=1)
+@ngl.scene()
+def benchmark_fingerprint_transforms(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (16, 9)
+    return _get_transforms_scene(cfg, seed=4, nb_layers=200)
@@ -26,6 +26,7 @@ from pynopegl_utils.misc import load_media
 from pynopegl_utils.tests.cmp_cuepoints import test_cuepoints
 from pynopegl_utils.tests.cmp_fingerprint import test_fingerprint
 from pynopegl_utils.tests.cuepoints_utils import get_grid_points, get_points_nodes
+from pynopegl_utils.toolbox.colors import COLORS
 
 
 @test_fingerprint(width=256, height=256, keyframes=10, tolerance=1)
@@ -50,6 +51,95 @@ def blur_gaussian(cfg: ngl.SceneCfg):
     return ngl.Group(children=[blur, ngl.DrawTexture(blurred_texture)])
 
 
+_BLUR_GAUSSIAN_DIFF_VERTEX = textwrap.dedent(
+    """
+    void main()
+    {
+        ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+        uv_a = (tex_a_coord_matrix * vec4(ngl_uvcoord, 0.0, 1.0)).xy;
+        uv_b = (tex_b_coord_matrix * vec4(ngl_uvcoord, 0.0, 1.0)).xy;
+    }
+    """
+)
+
+_BLUR_GAUSSIAN_DIFF_FRAGMENT = textwrap.dedent(
+    """
+    void main()
+    {
+        float diff = abs(texture(tex_a, uv_a).r - texture(tex_b, uv_b).r);
+        ngl_out_color = vec4(vec3(step(1.5 / 255.0, diff)), 1.0);
+    }
+    """
+)
+
+
+@test_fingerprint(width=256, height=256, keyframes=10, tolerance=1)
+@ngl.scene()
+def blur_gaussian_compute_fragment(cfg: ngl.SceneCfg):
+    """
+    The compute passes are only used with storage compatible destination
+    formats (such as rgba8), so a r8 destination forces the fragment passes.
+    The noise being grayscale, both destinations must hold the same values
+    (give or take a rounding error): any difference is displayed in white. A
+    smooth noise is used because the fragment passes rely on the hardware
+    filtering, which interpolates the texels before their sRGB linearization.
+    """
+    cfg.aspect_ratio = (1, 1)
+    cfg.duration = 10
+
+    noise = ngl.DrawNoise(type="perlin", octaves=3, scale=(9, 9))
+    noise_texture = ngl.Texture2D(data_src=noise)
+    blurriness = ngl.AnimatedFloat(
+        [
+            ngl.AnimKeyFrameFloat(0, 0),
+            ngl.AnimKeyFrameFloat(cfg.duration, 1),
+        ]
+    )
+    blurred_texture_a = ngl.Texture2D(format="r8g8b8a8_unorm")
+    blurred_texture_b = ngl.Texture2D(format="r8_unorm")
+    blur_a = ngl.GaussianBlur(source=noise_texture, destination=blurred_texture_a, blurriness=blurriness)
+    blur_b = ngl.GaussianBlur(source=noise_texture, destination=blurred_texture_b, blurriness=blurriness)
+
+    program = ngl.Program(vertex=_BLUR_GAUSSIAN_DIFF_VERTEX, fragment=_BLUR_GAUSSIAN_DIFF_FRAGMENT)
+    program.update_vert_out_vars(uv_a=ngl.IOVec2(), uv_b=ngl.IOVec2())
+    draw = ngl.Draw(ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0)), program)
+    draw.update_frag_resources(tex_a=blurred_texture_a, tex_b=blurred_texture_b)
+    return ngl.Group(children=[blur_a, blur_b, draw])
+
+
+def _get_gaussian_mip_scene(cfg: ngl.SceneCfg, max_blurriness):
+    cfg.aspect_ratio = (1, 1)
+    cfg.duration = 10
+
+    noise = ngl.DrawNoise(type="blocky", octaves=3, scale=(9, 9))
+    noise_texture = ngl.Texture2D(data_src=noise)
+    blurred_texture = ngl.Texture2D()
+    blur = ngl.GaussianBlur(
+        source=noise_texture,
+        destination=blurred_texture,
+        blurriness=ngl.AnimatedFloat(
+            [
+                ngl.AnimKeyFrameFloat(0, 0),
+                ngl.AnimKeyFrameFloat(cfg.duration, max_blurriness),
+            ]
+        ),
+        mode="mip",
+    )
+    return ngl.Group(children=[blur, ngl.DrawTexture(blurred_texture)])
+
+
+@test_fingerprint(width=256, height=256, keyframes=10, tolerance=1)
+@ngl.scene()
+def blur_gaussian_mip(cfg: ngl.SceneCfg):
+    return _get_gaussian_mip_scene(cfg, 1)
+
+
+@test_fingerprint(width=256, height=256, keyframes=10, tolerance=1)
+@ngl.scene()
+def blur_gaussian_mip_large(cfg: ngl.SceneCfg):
+    return _get_gaussian_mip_scene(cfg, 4)
+
+
 @test_fingerprint(width=800, height=800, keyframes=10, tolerance=5)
 @ngl.scene()
 def blur_fast_gaussian(cfg: ngl.SceneCfg):
@@ -167,3 +257,105 @@ def blur_hexagonal_with_map(cfg: ngl.SceneCfg, show_dbg_points=False):
         group.add_children(get_points_nodes(cfg, _BLUR_HEXAGONAL_CUEPOINTS))
 
     return group
+
+
+def _get_content_area_source(cfg: ngl.SceneCfg, full):
+    # Small off-center shape in a texture cleared to transparent black: the
+    # blurs only process the area touched by the shape (and its margin)
+    shape = ngl.DrawColor(COLORS.orange, geometry=ngl.Circle(radius=0.15, npoints=64))
+    children = [ngl.Translate(shape, vector=(-0.45, -0.3, 0))]
+    if full:
+        # A fully transparent draw covering the whole texture extends the
+        # content area without changing any pixel, which gives the reference
+        # unrestricted result
+        children.append(ngl.DrawColor(opacity=0, blending="src_over"))
+    texture = ngl.Texture2D(width=256, height=256)
+    rtt = ngl.RenderToTexture(ngl.Group(children=children), [texture], clear_color=(0, 0, 0, 0))
+    return rtt, texture
+
+
+def _get_content_area_blurriness(cfg: ngl.SceneCfg):
+    return ngl.AnimatedFloat(
+        [
+            ngl.AnimKeyFrameFloat(0, 0),
+            ngl.AnimKeyFrameFloat(cfg.duration, 1),
+        ]
+    )
+
+
+def _get_content_area_gaussian(cfg: ngl.SceneCfg, source, **kwargs):
+    destination = ngl.Texture2D(**kwargs)
+    blur = ngl.GaussianBlur(source=source, destination=destination, blurriness=_get_content_area_blurriness(cfg))
+    return [blur], destination
+
+
+def _get_content_area_gaussian_fragment(cfg: ngl.SceneCfg, source):
+    # A non storage compatible destination forces the fragment passes, which
+    # read the source through its (possibly Y-flipped) coordinates matrix
+    return _get_content_area_gaussian(cfg, source, format="r8g8b8a8_srgb")
+
+
+def _get_content_area_gaussian_mip(cfg: ngl.SceneCfg, source):
+    destination = ngl.Texture2D()
+    blur = ngl.GaussianBlur(
+        source=source,
+        destination=destination,
+        blurriness=_get_content_area_blurriness(cfg),
+        mode="mip",
+    )
+    return [blur], destination
+
+
+def _get_content_area_fast_gaussian(cfg: ngl.SceneCfg, source):
+    destination = ngl.Texture2D()
+    blur = ngl.FastGaussianBlur(source=source, destination=destination, blurriness=_get_content_area_blurriness(cfg))
+    return [blur], destination
+
+
+def _get_content_area_hexagonal(cfg: ngl.SceneCfg, source):
+    destination = ngl.Texture2D()
+    blur = ngl.HexagonalBlur(source=source, destination=destination, blurriness=_get_content_area_blurriness(cfg))
+    return [blur], destination
+
+
+def _get_content_area_chained(cfg: ngl.SceneCfg, source):
+    # The intermediate destination inherits the content area of the source
+    # and has an identity coordinates matrix, unlike the render target
+    nodes, intermediate = _get_content_area_fast_gaussian(cfg, source)
+    gaussian_nodes, destination = _get_content_area_gaussian_fragment(cfg, intermediate)
+    return nodes + gaussian_nodes, destination
+
+
+_BLUR_CONTENT_AREA_FUNCS = dict(
+    gaussian=_get_content_area_gaussian,
+    gaussian_fragment=_get_content_area_gaussian_fragment,
+    gaussian_mip=_get_content_area_gaussian_mip,
+    fast_gaussian=_get_content_area_fast_gaussian,
+    hexagonal=_get_content_area_hexagonal,
+    chained=_get_content_area_chained,
+)
+
+
+def _get_content_area_function(blur_func, full):
+    @test_fingerprint(width=256, height=256, keyframes=5, tolerance=1)
+    @ngl.scene()
+    def scene_func(cfg: ngl.SceneCfg):
+        """
+        The blurs restricted to the content area of their source must match
+        the unrestricted result. Render targets have a Y-flipping coordinates
+        matrix with OpenGL and an identity one with Vulkan, so running the
+        tests on both backends covers both orientations.
+        """
+        cfg.aspect_ratio = (1, 1)
+        cfg.duration = 5
+
+        rtt, source = _get_content_area_source(cfg, full)
+        nodes, destination = blur_func(cfg, source)
+        return ngl.Group(children=[rtt] + nodes + [ngl.DrawTexture(destination)])
+
+    return scene_func
+
+
+for name, blur_func in _BLUR_CONTENT_AREA_FUNCS.items():
+    globals()[f"blur_content_area_{name}"] = _get_content_area_function(blur_func, full=False)
+    globals()[f"blur_content_area_{name}_full"] = _get_content_area_function(blur_func, full=True)
@@ -0,0 +1,151 @@
+#
+# Copyright 2026 Nope Forge
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+import pynopegl as ngl
+from pynopegl_utils.tests.cmp_fingerprint import test_fingerprint
+from pynopegl_utils.toolbox.colors import COLORS
+
+
+def _get_square(color, size=0.5, x=0.0, y=0.0):
+    geometry = ngl.Quad(corner=(-size / 2, -size / 2, 0), width=(size, 0, 0), height=(0, size, 0))
+    return ngl.Translate(ngl.DrawColor(color, geometry=geometry), vector=(x, y, 0))
+
+
+@test_fingerprint(width=128, height=128)
+@ngl.scene()
+def culling_offscreen(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+    return ngl.Group(
+        children=[
+            _get_square(COLORS.red, x=-1.5),
+            _get_square(COLORS.green, x=1.5),
+            _get_square(COLORS.blue, y=-1.5),
+            _get_square(COLORS.yellow, y=1.5),
+            _get_square(COLORS.magenta, x=1.3, y=1.3),
+            ngl.Translate(ngl.DrawColor(COLORS.cyan, geometry=ngl.Circle(radius=0.2, npoints=32)), vector=(-1.3, 1.3, 0)),
+            _get_square(COLORS.white, size=0.3),
+        ]
+    )
+
+
+@test_fingerprint(width=128, height=128)
+@ngl.scene()
+def culling_partial(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+
+    path = ngl.Path(
+        [
+            ngl.PathKeyMove(to=(-0.5, -0.5, 0)),
+            ngl.PathKeyLine(to=(0.5, -0.5, 0)),
+            ngl.PathKeyLine(to=(0.0, 0.5, 0)),
+            ngl.PathKeyClose(),
+        ]
+    )
+    drawpath = ngl.DrawPath(path, box=(0.6, 0.6, 0.8, 0.8))
+
+    return ngl.Group(
+        children=[
+            _get_square(COLORS.red, x=-1.0),
+            _get_square(COLORS.green, x=1.0),
+            _get_square(COLORS.blue, y=-1.0),
+            _get_square(COLORS.yellow, y=1.0),
+            _get_square(COLORS.magenta, x=-1.2, y=-1.2),
+            drawpath,
+        ]
+    )
+
+
+@test_fingerprint(width=128, height=128, keyframes=8)
+@ngl.scene()
+def culling_rotated(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+    cfg.duration = 4
+
+    # A bar lying off-screen before the rotation, sweeping in and out of the
+    # visible area
+    geometry = ngl.Quad(corner=(1.1, -0.1, 0), width=(1, 0, 0), height=(0, 0.2, 0))
+    bar = ngl.DrawColor(COLORS.orange, geometry=geometry)
+    animkf = [
+        ngl.AnimKeyFrameFloat(0, 0),
+        ngl.AnimKeyFrameFloat(cfg.duration, 360),
+    ]
+    sweep = ngl.Rotate(bar, angle=ngl.AnimatedFloat(animkf))
+
+    # Static rotations: the first one brings a corner into the view, the
+    # second one keeps the shape out of it
+    visible = ngl.Rotate(_get_square(COLORS.azure, x=1.3), angle=30)
+    hidden = ngl.Rotate(_get_square(COLORS.red, size=0.2, x=1.6), angle=-60)
+
+    return ngl.Group(children=[sweep, visible, hidden])
+
+
+@test_fingerprint(width=128, height=128)
+@ngl.scene()
+def culling_perspective(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+
+    # A floor going from behind the camera to far in front of it: some of its
+    # corners are behind the eye plane while the rest of it is visible
+    floor = ngl.DrawColor(
+        COLORS.green,
+        geometry=ngl.Quad(corner=(-1, -0.5, 4), width=(2, 0, 0), height=(0, 0, -8)),
+    )
+
+    # A wall entirely behind the camera, which must not appear mirrored
+    behind = ngl.DrawColor(
+        COLORS.red,
+        geometry=ngl.Quad(corner=(-0.5, -0.5, 3), width=(1, 0, 0), height=(0, 1, 0)),
+    )
+
+    # A wall straddling the near plane
+    wall = ngl.DrawColor(
+        COLORS.azure,
+        geometry=ngl.Quad(corner=(0.2, -0.2, 1.5), width=(0, 0, -2), height=(0, 0.6, 0)),
+    )
+
+    camera = ngl.Camera(ngl.Group(children=[floor, behind, wall]))
+    camera.set_eye(0.0, 0.0, 2.0)
+    camera.set_center(0.0, 0.0, 0.0)
+    camera.set_up(0.0, 1.0, 0.0)
+    camera.set_perspective(60.0, cfg.aspect_ratio_float)
+    camera.set_clipping(0.1, 10.0)
+    return camera
+
+
+@test_fingerprint(width=64, height=64)
+@ngl.scene()
+def culling_scissor(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+
+    # The scissor covers the top right quarter of the 64x64 target
+    group = ngl.Group(
+        children=[
+            _get_square(COLORS.red, x=-0.5, y=-0.5),
+            _get_square(COLORS.blue, x=-0.5, y=0.5),
+            _get_square(COLORS.green, size=0.8, x=0.3, y=0.3),
+            _get_square(COLORS.yellow, size=0.3, x=0.75, y=0.75),
+        ]
+    )
+    graphic_config = ngl.GraphicConfig(group, scissor=(32, 32, 32, 32))
+
+    texture = ngl.Texture2D(width=64, height=64, min_filter="nearest", mag_filter="nearest")
+    rtt = ngl.RenderToTexture(graphic_config, [texture], clear_color=(0, 0, 0, 1))
+    return ngl.Group(children=[rtt, ngl.DrawTexture(texture)])
@@ -469,3 +469,52 @@ def data_vertex_and_fragment_blocks(cfg: ngl.SceneCfg):
 @ngl.scene()
 def data_vertex_and_fragment_blocks_std430(cfg: ngl.SceneCfg):
     return _data_vertex_and_fragment_blocks(cfg, "std430")
+
+
+@test_cuepoints(width=128, height=128, points={"c": (0, 0)}, keyframes=10, tolerance=1)
+@ngl.scene()
+def data_multi_buffered_block(cfg: ngl.SceneCfg):
+    """
+    The color is held for several frames between its changes, so the block is
+    expected to switch to the copies that missed the previous changes without
+    any new change to upload.
+    """
+    cfg.aspect_ratio = (1, 1)
+    cfg.duration = 10
+
+    animkf = [
+        ngl.AnimKeyFrameVec3(0, COLORS.red),
+        ngl.AnimKeyFrameVec3(3, COLORS.red),
+        ngl.AnimKeyFrameVec3(4, COLORS.green),
+        ngl.AnimKeyFrameVec3(7, COLORS.green),
+        ngl.AnimKeyFrameVec3(8, COLORS.blue),
+    ]
+    block = ngl.Block(
+        fields=[
+            ngl.UniformFloat(value=0.5, label="opacity"),
+            ngl.AnimatedVec3(animkf, label="color"),
+        ],
+        multi_buffering=True,
+    )
+    vert = textwrap.dedent(
+        """\
+        void main()
+        {
+            ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+        }
+        """
+    )
+    frag = textwrap.dedent(
+        """\
+        void main()
+        {
+            ngl_out_color = vec4(data.color * data.opacity, 1.0);
+        }
+        """
+    )
+    program = ngl.Program(vertex=vert, fragment=frag)
+    geometry = ngl.Quad(corner=(-1, -1, 0), width=(2, 0, 0), height=(0, 2, 0))
+    draw = ngl.Draw(geometry, program)
+    draw.update_frag_resources(data=block)
+
+    return draw
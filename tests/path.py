@@ -119,6 +119,22 @@ def path_shape_8(cfg: ngl.SceneCfg):
     return _shape_variant_0(cfg, *kfs)
 
 
+def _get_analytic_function(shape_func):
+    @test_fingerprint(width=640, height=640, tolerance=1)
+    @ngl.scene()
+    def scene_func(cfg: ngl.SceneCfg):
+        drawpath = shape_func.__wrapped__(cfg)
+        drawpath.set_mode("analytic")
+        return drawpath
+
+    return scene_func
+
+
+# The analytic mode must render the same shapes as the distance map
+for i in range(9):
+    globals()[f"path_shape_{i}_analytic"] = _get_analytic_function(globals()[f"path_shape_{i}"])
+
+
 @test_fingerprint(width=640, height=640)
 @ngl.scene()
 def path_parabola(cfg: ngl.SceneCfg):
@@ -225,3 +241,54 @@ def path_open_and_effects(cfg: ngl.SceneCfg):
         glow=0.2,
         glow_color=(1, 0.5, 0),
     )
+
+
+def _get_animated_path(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+    cfg.duration = 3
+
+    to_kf = [
+        ngl.AnimKeyFrameVec3(0, (0.6, -0.5, 0)),
+        ngl.AnimKeyFrameVec3(cfg.duration / 2, (0.3, 0.6, 0), "exp_in_out"),
+        ngl.AnimKeyFrameVec3(cfg.duration, (0.6, -0.5, 0), "exp_in_out"),
+    ]
+    control_kf = [
+        ngl.AnimKeyFrameVec3(0, (0.0, -0.9, 0)),
+        ngl.AnimKeyFrameVec3(cfg.duration / 2, (0.1, 0.2, 0), "quadratic_in_out"),
+        ngl.AnimKeyFrameVec3(cfg.duration, (0.0, -0.9, 0), "quadratic_in_out"),
+    ]
+    control1_kf = [
+        ngl.AnimKeyFrameVec3(0, (0.9, 0.2, 0)),
+        ngl.AnimKeyFrameVec3(cfg.duration, (0.2, 0.9, 0), "sinus_in_out"),
+    ]
+
+    keyframes = [
+        ngl.PathKeyMove(to=(-0.6, -0.5, 0)),
+        ngl.PathKeyBezier2(control=ngl.AnimatedVec3(control_kf), to=ngl.AnimatedVec3(to_kf)),
+        ngl.PathKeyBezier3(control1=ngl.AnimatedVec3(control1_kf), control2=(-0.9, 0.8, 0), to=(-0.6, 0.5, 0)),
+        ngl.PathKeyClose(),
+    ]
+    return ngl.Path(keyframes)
+
+
+@test_fingerprint(width=640, height=640, keyframes=7, tolerance=1)
+@ngl.scene()
+def path_animated_keys(cfg: ngl.SceneCfg):
+    path = _get_animated_path(cfg)
+    return ngl.DrawPath(path, mode="analytic")
+
+
+@test_fingerprint(width=640, height=640, keyframes=7, tolerance=1)
+@ngl.scene()
+def path_animated_follow(cfg: ngl.SceneCfg):
+    path = _get_animated_path(cfg)
+
+    anim_kf = [
+        ngl.AnimKeyFrameFloat(0, 0),
+        ngl.AnimKeyFrameFloat(cfg.duration, 1),
+    ]
+    geometry = ngl.Circle(radius=0.05, npoints=32)
+    marker = ngl.DrawColor((1.0, 0.0, 0.5), geometry=geometry)
+    marker = ngl.Translate(marker, vector=ngl.AnimatedPath(anim_kf, path))
+
+    return ngl.Group(children=[ngl.DrawPath(path, mode="analytic", outline=0.01), marker])
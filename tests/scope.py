@@ -139,3 +139,60 @@ def scope_rtt(cfg):
 
     scope = ngl.DrawWaveform(stats=ngl.ColorStats(dst_texture))
     return ngl.Group(children=[rtt, scope])
+
+
+def _get_gradient_texture(width=0, height=0):
+    # A texture without size is rendered at the size of the current render target
+    gradient = ngl.DrawGradient4(
+        color_tl=(1.0, 0.5, 0.0),
+        color_tr=(0.0, 0.5, 1.0),
+        color_br=(0.5, 0.0, 0.5),
+        color_bl=(0.0, 1.0, 0.0),
+    )
+    return ngl.Texture2D(data_src=gradient, width=width, height=height, min_filter="nearest", mag_filter="nearest")
+
+
+@test_fingerprint(width=320, height=240, keyframes=2, tolerance=3)
+@ngl.scene()
+def scope_size_change(cfg):
+    """The stats buffers follow the source size when it changes between frames"""
+
+    cfg.duration = 2
+    cfg.aspect_ratio = (4, 3)
+
+    # The source is rendered at the size of the render target of the scope
+    scope = ngl.DrawWaveform(stats=ngl.ColorStats(_get_gradient_texture()), mode="parade")
+
+    children = []
+    for i, (width, height) in enumerate([(160, 120), (320, 240)]):
+        texture = ngl.Texture2D(width=width, height=height, min_filter="nearest", mag_filter="nearest")
+        rtt = ngl.RenderToTexture(scope, color_textures=[texture])
+        group = ngl.Group(children=[rtt, ngl.DrawTexture(texture)])
+        children.append(ngl.TimeRangeFilter(group, start=i, end=i + 1))
+    return ngl.Group(children=children)
+
+
+@test_fingerprint(width=320, height=240, tolerance=3)
+@ngl.scene()
+def scope_subsampling(cfg):
+    cfg.aspect_ratio = (4, 3)
+    stats = ngl.ColorStats(_get_gradient_texture(256, 192), subsampling=4)
+    return ngl.DrawWaveform(stats=stats, mode="mixed")
+
+
+def _get_amortization_func(amortization):
+    # The partial stats are published until a first full cycle is complete,
+    # then only once per cycle
+    @test_fingerprint(width=320, height=240, keyframes=[0, 1, 2, 3, 4, 5, 6], tolerance=3)
+    @ngl.scene()
+    def scene_func(cfg):
+        cfg.duration = 6
+        cfg.aspect_ratio = (4, 3)
+        stats = ngl.ColorStats(_get_gradient_texture(256, 192), amortization=amortization)
+        return ngl.DrawWaveform(stats=stats, mode="mixed")
+
+    return scene_func
+
+
+scope_amortization_1 = _get_amortization_func(1)
+scope_amortization_3 = _get_amortization_func(3)
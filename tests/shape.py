@@ -112,6 +112,36 @@ def shape_circle(cfg: ngl.SceneCfg, radius=0.5, color=COLORS.azure):
     return _draw_shape(geometry, color)
 
 
+# The largest index of a circle is its number of points: up to 65535 points,
+# the 32-bit indices are narrowed to 16-bit
+@test_fingerprint(width=320, height=320)
+@ngl.scene()
+def shape_circle_u16_indices(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+    return _draw_shape(ngl.Circle(0.5, npoints=65535), COLORS.azure)
+
+
+@test_fingerprint(width=320, height=320)
+@ngl.scene()
+def shape_circle_u32_indices(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+    return _draw_shape(ngl.Circle(0.5, npoints=70000), COLORS.azure)
+
+
+@test_fingerprint(width=320, height=320)
+@ngl.scene()
+def shape_circle_shared(cfg: ngl.SceneCfg):
+    """Identical geometries share the same buffers, while the other ones get their own"""
+    cfg.aspect_ratio = (1, 1)
+    draws = [
+        ngl.Translate(_draw_shape(ngl.Circle(0.3, npoints=64), COLORS.azure), vector=(-0.5, 0.5, 0)),
+        ngl.Translate(_draw_shape(ngl.Circle(0.3, npoints=64), COLORS.orange), vector=(0.5, 0.5, 0)),
+        ngl.Translate(_draw_shape(ngl.Circle(0.3, npoints=5), COLORS.sgreen), vector=(-0.5, -0.5, 0)),
+        ngl.Translate(_draw_shape(ngl.Circle(0.3, npoints=70000), COLORS.white), vector=(0.5, -0.5, 0)),
+    ]
+    return ngl.Group(children=draws)
+
+
 def _shape_geometry(cfg: ngl.SceneCfg, set_normals=False, set_indices=False):
     # Fake cube (3 faces only) obtained from:
     # echo 'cube();'>x.scad; openscad x.scad -o x.stl
@@ -377,3 +377,21 @@ def transform_shared_anim(cfg: ngl.SceneCfg):
     anim1 = ngl.Translate(shape1, vector=ngl.AnimatedVec3(anim_kf, time_offset=cfg.duration * 1 / 3))
 
     return ngl.Group(children=[anim0, anim1])
+
+
+@test_fingerprint(width=320, height=320, keyframes=8, tolerance=1)
+@ngl.scene()
+def transform_chain_inner_animated(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+    cfg.duration = 4
+
+    # Only the middle transform of the chain changes, and not on every frame
+    animkf = [
+        ngl.AnimKeyFrameFloat(0, 0),
+        ngl.AnimKeyFrameFloat(cfg.duration / 4, 0),
+        ngl.AnimKeyFrameFloat(cfg.duration, 270, "exp_in_out"),
+    ]
+    shape = _transform_shape()
+    shape = ngl.Scale(shape, factors=(0.8, 1.2, 1))
+    shape = ngl.Rotate(shape, angle=ngl.AnimatedFloat(animkf))
+    return ngl.Translate(shape, vector=(0.2, -0.1, 0))